@@ -0,0 +1,330 @@
+/*****************************************************************************
+ * khazad-min-adaptive.c
+ *
+ * Khazad adaptive key contexts.
+ *
+ * On-the-fly key schedule calculation has no set-up cost beyond the start key
+ * state, but repeats the key schedule rounds for every block. Calculating the
+ * full key schedule costs about as much as one such block, after which each
+ * block is cheaper, especially with the multi-block kernels. An adaptive key
+ * context starts on the fly, and switches once the blocks processed with the
+ * key reach a threshold. That is the classic rent-or-buy rule: the switch is
+ * made once the extra cost paid for on-the-fly blocks would have paid for the
+ * full key schedule, so a key never costs more than about twice what the
+ * better choice in hindsight would have.
+ *
+ * The threshold is the cost of the full key schedule divided by the extra
+ * cost per block of on-the-fly calculation, measured once per process.
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Includes
+ ****************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "khazad-min-adaptive.h"
+#include "khazad-min-internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*****************************************************************************
+ * Defines
+ ****************************************************************************/
+
+#define KHAZAD_ADAPTIVE_THRESHOLD_ENV       "KHAZAD_ADAPTIVE_THRESHOLD"
+
+/* Used if the threshold can't be calibrated. */
+#define KHAZAD_ADAPTIVE_DEFAULT_THRESHOLD   4u
+#define KHAZAD_ADAPTIVE_MAX_THRESHOLD       4096u
+
+/* Calibration runs, calls timed per run, and blocks per multi-block call. The
+ * best run of each is used, to discount interruptions. */
+#define KHAZAD_ADAPTIVE_CALIBRATE_RUNS          5u
+#define KHAZAD_ADAPTIVE_CALIBRATE_ITERATIONS    64u
+#define KHAZAD_ADAPTIVE_CALIBRATE_BLOCKS        16u
+
+/* Flags in khazad_adaptive_t. */
+#define KHAZAD_ADAPTIVE_EXPANDED            0x01u
+#define KHAZAD_ADAPTIVE_DECRYPT_START_KEY   0x02u
+
+/* The threshold is shared by all threads. Every thread calibrates much the
+ * same value, so a racing store is harmless; atomic access just keeps it
+ * well-defined. */
+#if defined(__GNUC__)
+#define KHAZAD_ADAPTIVE_LOAD(p)             __atomic_load_n(p, __ATOMIC_RELAXED)
+#define KHAZAD_ADAPTIVE_STORE(p, v)         __atomic_store_n(p, v, __ATOMIC_RELAXED)
+#else
+#define KHAZAD_ADAPTIVE_LOAD(p)             (*(p))
+#define KHAZAD_ADAPTIVE_STORE(p, v)         (*(p) = (v))
+#endif
+
+/*****************************************************************************
+ * Types
+ ****************************************************************************/
+
+struct khazad_adaptive
+{
+    /* Key schedule for khazad_crypt(), once calculated. */
+    uint64_t    round_keys[KHAZAD_NUM_ROUNDS + 1u];
+    /* Start key states for khazad_otfks_encrypt() and khazad_otfks_decrypt().
+     * The decryption one is calculated on first use. */
+    uint8_t     encrypt_start_key[KHAZAD_KEY_SIZE];
+    uint8_t     decrypt_start_key[KHAZAD_KEY_SIZE];
+    /* Blocks processed so far, and the number at which to switch. */
+    uint32_t    num_blocks;
+    uint32_t    threshold;
+    unsigned    flags;
+};
+
+typedef enum
+{
+    KHAZAD_ADAPTIVE_TIME_EXPAND,
+    KHAZAD_ADAPTIVE_TIME_OTFKS,
+    KHAZAD_ADAPTIVE_TIME_BLOCKS,
+} khazad_adaptive_op_t;
+
+typedef struct
+{
+    uint8_t     key_schedule[KHAZAD_KEY_SCHEDULE_SIZE];
+    uint8_t     start_key[KHAZAD_KEY_SIZE];
+    uint8_t     blocks[KHAZAD_ADAPTIVE_CALIBRATE_BLOCKS * KHAZAD_BLOCK_SIZE];
+} khazad_adaptive_calibration_t;
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+
+/* The threshold, or 0 if not yet set or calibrated. */
+static uint32_t khazad_adaptive_global_threshold;
+
+/*****************************************************************************
+ * Local functions
+ ****************************************************************************/
+
+#if defined(CLOCK_MONOTONIC)
+
+static uint64_t khazad_adaptive_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/* Return the best time of the calibration runs of one operation. */
+static uint64_t khazad_adaptive_time(khazad_adaptive_calibration_t * p_calibration, khazad_adaptive_op_t op)
+{
+    uint64_t    start;
+    uint64_t    elapsed;
+    uint64_t    best = UINT64_MAX;
+    unsigned    run;
+    unsigned    i;
+
+    for (run = 0; run < KHAZAD_ADAPTIVE_CALIBRATE_RUNS; ++run)
+    {
+        start = khazad_adaptive_now();
+        for (i = 0; i < KHAZAD_ADAPTIVE_CALIBRATE_ITERATIONS; ++i)
+        {
+            switch (op)
+            {
+            case KHAZAD_ADAPTIVE_TIME_EXPAND:
+                khazad_key_schedule_from_otfks_start_key(p_calibration->key_schedule, p_calibration->start_key);
+                /* Feed the result back, so the calls can't be removed. */
+                p_calibration->start_key[0] ^= p_calibration->key_schedule[KHAZAD_KEY_SCHEDULE_SIZE - 1u];
+                break;
+            case KHAZAD_ADAPTIVE_TIME_OTFKS:
+                khazad_otfks_encrypt_blocks(p_calibration->blocks, p_calibration->blocks, KHAZAD_ADAPTIVE_CALIBRATE_BLOCKS,
+                                            p_calibration->start_key);
+                break;
+            case KHAZAD_ADAPTIVE_TIME_BLOCKS:
+                khazad_crypt_blocks(p_calibration->blocks, p_calibration->blocks, KHAZAD_ADAPTIVE_CALIBRATE_BLOCKS,
+                                    p_calibration->key_schedule);
+                break;
+            }
+        }
+        elapsed = khazad_adaptive_now() - start;
+        if (elapsed < best)
+            best = elapsed;
+    }
+    return best;
+}
+
+/* The threshold is the full key schedule time divided by the extra time per
+ * block of on-the-fly calculation, rounded up. Times are totals over the
+ * same number of calls, and both block functions process the same number of
+ * blocks per call, so the divisions mostly cancel out. */
+static uint32_t khazad_adaptive_calibrate(void)
+{
+    khazad_adaptive_calibration_t   calibration;
+    uint64_t                        expand_time;
+    uint64_t                        otfks_time;
+    uint64_t                        blocks_time;
+    uint64_t                        extra_time;
+    uint64_t                        threshold;
+
+    memset(&calibration, 0x5Au, sizeof(calibration));
+    khazad_otfks_encrypt_start_key(calibration.start_key);
+    /* Warm up the code and tables. */
+    (void)khazad_adaptive_time(&calibration, KHAZAD_ADAPTIVE_TIME_EXPAND);
+
+    expand_time = khazad_adaptive_time(&calibration, KHAZAD_ADAPTIVE_TIME_EXPAND);
+    otfks_time = khazad_adaptive_time(&calibration, KHAZAD_ADAPTIVE_TIME_OTFKS);
+    blocks_time = khazad_adaptive_time(&calibration, KHAZAD_ADAPTIVE_TIME_BLOCKS);
+
+    if (otfks_time <= blocks_time)
+        return 1u;
+    extra_time = otfks_time - blocks_time;
+    threshold = (expand_time * KHAZAD_ADAPTIVE_CALIBRATE_BLOCKS + extra_time - 1u) / extra_time;
+    if (threshold < 1u)
+        threshold = 1u;
+    if (threshold > KHAZAD_ADAPTIVE_MAX_THRESHOLD)
+        threshold = KHAZAD_ADAPTIVE_MAX_THRESHOLD;
+    return (uint32_t)threshold;
+}
+
+#else /* defined(CLOCK_MONOTONIC) */
+
+static uint32_t khazad_adaptive_calibrate(void)
+{
+    return KHAZAD_ADAPTIVE_DEFAULT_THRESHOLD;
+}
+
+#endif /* defined(CLOCK_MONOTONIC) */
+
+/* Count the blocks for a call, and calculate the full key schedule if they
+ * reach the threshold. Returns non-zero if the full key schedule is to be
+ * used. */
+static int khazad_adaptive_use_key_schedule(khazad_adaptive_t * p_adaptive, size_t num_blocks)
+{
+    if (p_adaptive->flags & KHAZAD_ADAPTIVE_EXPANDED)
+        return 1;
+    if (num_blocks >= p_adaptive->threshold - p_adaptive->num_blocks)
+    {
+        khazad_key_schedule_from_otfks_start_key((uint8_t *)p_adaptive->round_keys, p_adaptive->encrypt_start_key);
+        p_adaptive->flags |= KHAZAD_ADAPTIVE_EXPANDED;
+        return 1;
+    }
+    p_adaptive->num_blocks += (uint32_t)num_blocks;
+    return 0;
+}
+
+/*****************************************************************************
+ * Functions
+ ****************************************************************************/
+
+/* Create an adaptive key context for the Khazad key p_key.
+ * It switches to the full key schedule once the number of blocks processed
+ * reaches khazad_adaptive_threshold(), as it is at the time of this call.
+ * Returns NULL if memory can't be allocated.
+ */
+khazad_adaptive_t * khazad_adaptive_create(const uint8_t p_key[KHAZAD_KEY_SIZE])
+{
+    khazad_adaptive_t * p_adaptive;
+
+    p_adaptive = (khazad_adaptive_t *)khazad_aligned_alloc(sizeof(khazad_adaptive_t));
+    if (p_adaptive == NULL)
+        return NULL;
+    khazad_adaptive_rekey(p_adaptive, p_key);
+    return p_adaptive;
+}
+
+/* Change the key of an adaptive key context. It starts again on the fly, with
+ * khazad_adaptive_threshold() as it is at the time of this call.
+ */
+void khazad_adaptive_rekey(khazad_adaptive_t * p_adaptive, const uint8_t p_key[KHAZAD_KEY_SIZE])
+{
+    memset(p_adaptive, 0, sizeof(*p_adaptive));
+    memcpy(p_adaptive->encrypt_start_key, p_key, KHAZAD_KEY_SIZE);
+    khazad_otfks_encrypt_start_key(p_adaptive->encrypt_start_key);
+    p_adaptive->threshold = khazad_adaptive_threshold();
+}
+
+/* Clear an adaptive key context, so no key material is left in memory, and
+ * free it. p_adaptive may be NULL.
+ */
+void khazad_adaptive_destroy(khazad_adaptive_t * p_adaptive)
+{
+    if (p_adaptive == NULL)
+        return;
+    khazad_wipe(p_adaptive, sizeof(*p_adaptive));
+    khazad_aligned_free(p_adaptive);
+}
+
+/* Khazad encryption of multiple blocks with an adaptive key context, as for
+ * khazad_crypt_blocks(). p_dst may equal p_src, but the buffers must not
+ * otherwise overlap.
+ * If this call takes the number of blocks processed to the threshold, the
+ * full key schedule is calculated first, and used for all of its blocks.
+ */
+void khazad_adaptive_crypt_blocks(khazad_adaptive_t * p_adaptive, uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks)
+{
+    if (khazad_adaptive_use_key_schedule(p_adaptive, num_blocks))
+    {
+        khazad_crypt_blocks(p_dst, p_src, num_blocks, (const uint8_t *)p_adaptive->round_keys);
+        return;
+    }
+    khazad_otfks_encrypt_blocks(p_dst, p_src, num_blocks, p_adaptive->encrypt_start_key);
+}
+
+/* Khazad decryption of multiple blocks with an adaptive key context, as for
+ * khazad_decrypt_blocks(). Otherwise as for khazad_adaptive_crypt_blocks().
+ */
+void khazad_adaptive_decrypt_blocks(khazad_adaptive_t * p_adaptive, uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks)
+{
+    if (khazad_adaptive_use_key_schedule(p_adaptive, num_blocks))
+    {
+        khazad_decrypt_blocks(p_dst, p_src, num_blocks, (const uint8_t *)p_adaptive->round_keys);
+        return;
+    }
+    if ((p_adaptive->flags & KHAZAD_ADAPTIVE_DECRYPT_START_KEY) == 0)
+    {
+        memcpy(p_adaptive->decrypt_start_key, p_adaptive->encrypt_start_key, KHAZAD_KEY_SIZE);
+        khazad_otfks_decrypt_from_encrypt_start_key(p_adaptive->decrypt_start_key);
+        p_adaptive->flags |= KHAZAD_ADAPTIVE_DECRYPT_START_KEY;
+    }
+    khazad_otfks_decrypt_blocks(p_dst, p_src, num_blocks, p_adaptive->decrypt_start_key);
+}
+
+/* Returns non-zero if an adaptive key context has switched to the full key
+ * schedule.
+ */
+int khazad_adaptive_is_expanded(const khazad_adaptive_t * p_adaptive)
+{
+    return (p_adaptive->flags & KHAZAD_ADAPTIVE_EXPANDED) != 0;
+}
+
+/* Get the number of blocks per key at which adaptive key contexts switch to
+ * the full key schedule.
+ * It is calibrated on first use, by timing the full key schedule calculation
+ * against the extra cost per block of on-the-fly key schedule calculation, so
+ * it suits the CPU and the kernel in use. The KHAZAD_ADAPTIVE_THRESHOLD
+ * environment variable can be set to a number to use instead.
+ */
+uint32_t khazad_adaptive_threshold(void)
+{
+    uint32_t        threshold = KHAZAD_ADAPTIVE_LOAD(&khazad_adaptive_global_threshold);
+    const char    * p_env;
+    unsigned long   value;
+
+    if (threshold == 0)
+    {
+        p_env = getenv(KHAZAD_ADAPTIVE_THRESHOLD_ENV);
+        value = (p_env != NULL) ? strtoul(p_env, NULL, 10) : 0;
+        if (value > KHAZAD_ADAPTIVE_MAX_THRESHOLD)
+            value = KHAZAD_ADAPTIVE_MAX_THRESHOLD;
+        threshold = value ? (uint32_t)value : khazad_adaptive_calibrate();
+        KHAZAD_ADAPTIVE_STORE(&khazad_adaptive_global_threshold, threshold);
+    }
+    return threshold;
+}
+
+/* Set the number of blocks per key at which adaptive key contexts created or
+ * rekeyed from now on switch to the full key schedule, or 0 to calibrate it again.
+ */
+void khazad_adaptive_set_threshold(uint32_t threshold)
+{
+    KHAZAD_ADAPTIVE_STORE(&khazad_adaptive_global_threshold, threshold);
+}
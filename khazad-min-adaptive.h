@@ -0,0 +1,84 @@
+/*****************************************************************************
+ * khazad-min-adaptive.h
+ *
+ * Khazad adaptive key contexts.
+ *
+ * An adaptive key context processes blocks with on-the-fly key schedule
+ * calculation until enough have been processed with the key to pay for
+ * calculating the full key schedule, then switches to the full key schedule.
+ * The number of blocks at which it switches is calibrated on the machine it
+ * runs on.
+ ****************************************************************************/
+
+#ifndef KHAZAD_MIN_ADAPTIVE_H
+#define KHAZAD_MIN_ADAPTIVE_H
+
+/*****************************************************************************
+ * Includes
+ ****************************************************************************/
+
+#include "khazad-min.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*****************************************************************************
+ * Types
+ ****************************************************************************/
+
+typedef struct khazad_adaptive khazad_adaptive_t;
+
+/*****************************************************************************
+ * Function prototypes
+ ****************************************************************************/
+
+/* Create an adaptive key context for the Khazad key p_key.
+ * It switches to the full key schedule once the number of blocks processed
+ * reaches khazad_adaptive_threshold(), as it is at the time of this call.
+ * Returns NULL if memory can't be allocated.
+ */
+khazad_adaptive_t * khazad_adaptive_create(const uint8_t p_key[KHAZAD_KEY_SIZE]);
+
+/* Change the key of an adaptive key context. It starts again on the fly, with
+ * khazad_adaptive_threshold() as it is at the time of this call.
+ */
+void khazad_adaptive_rekey(khazad_adaptive_t * p_adaptive, const uint8_t p_key[KHAZAD_KEY_SIZE]);
+
+/* Clear an adaptive key context, so no key material is left in memory, and
+ * free it. p_adaptive may be NULL.
+ */
+void khazad_adaptive_destroy(khazad_adaptive_t * p_adaptive);
+
+/* Khazad encryption of multiple blocks with an adaptive key context, as for
+ * khazad_crypt_blocks(). p_dst may equal p_src, but the buffers must not
+ * otherwise overlap.
+ * If this call takes the number of blocks processed to the threshold, the
+ * full key schedule is calculated first, and used for all of its blocks.
+ */
+void khazad_adaptive_crypt_blocks(khazad_adaptive_t * p_adaptive, uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks);
+
+/* Khazad decryption of multiple blocks with an adaptive key context, as for
+ * khazad_decrypt_blocks(). Otherwise as for khazad_adaptive_crypt_blocks().
+ */
+void khazad_adaptive_decrypt_blocks(khazad_adaptive_t * p_adaptive, uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks);
+
+/* Returns non-zero if an adaptive key context has switched to the full key
+ * schedule.
+ */
+int khazad_adaptive_is_expanded(const khazad_adaptive_t * p_adaptive);
+
+/* Get the number of blocks per key at which adaptive key contexts switch to
+ * the full key schedule.
+ * It is calibrated on first use, by timing the full key schedule calculation
+ * against the extra cost per block of on-the-fly key schedule calculation, so
+ * it suits the CPU and the kernel in use. The KHAZAD_ADAPTIVE_THRESHOLD
+ * environment variable can be set to a number to use instead.
+ */
+uint32_t khazad_adaptive_threshold(void);
+
+/* Set the number of blocks per key at which adaptive key contexts created or
+ * rekeyed from now on switch to the full key schedule, or 0 to calibrate it again.
+ */
+void khazad_adaptive_set_threshold(uint32_t threshold);
+
+#endif /* !defined(KHAZAD_MIN_ADAPTIVE_H) */
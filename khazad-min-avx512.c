@@ -0,0 +1,454 @@
+/*****************************************************************************
+ * khazad-min-avx512.c
+ *
+ * Khazad encryption and decryption of multiple blocks with AVX-512 VBMI and
+ * GFNI instructions, 8 blocks per 512-bit register.
+ *
+ * The whole 256-byte S-box is held in four registers, and is evaluated with
+ * vpermi2b (two 128-byte look-ups, selected by the top bit of each byte).
+ * The constant multiplications of the diffusion layer are done with
+ * gf2p8affineqb, using fixed bit matrices for multiplication modulo 0x11D.
+ * There are no memory look-ups indexed by secret data.
+ *
+ * This file must be compiled with -mavx512f -mavx512bw -mavx512vbmi -mgfni.
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Includes
+ ****************************************************************************/
+
+#include "khazad-min.h"
+#include "khazad-min-internal.h"
+
+#include <stdbool.h>
+#include <string.h>
+#include <immintrin.h>
+
+/*****************************************************************************
+ * Defines
+ ****************************************************************************/
+
+#define KHAZAD_AVX512_BLOCKS        8u
+#define KHAZAD_AVX512_BYTES         (KHAZAD_AVX512_BLOCKS * KHAZAD_BLOCK_SIZE)
+
+/* Bit matrices for gf2p8affineqb, to multiply by a constant modulo 0x11D.
+ * Byte 7-i of the matrix selects the input bits that are summed to make
+ * output bit i. (gf2p8mulb can't be used, since it's modulo 0x11B.) */
+#define KHAZAD_GF2P8_MUL3           0x8103868C983060C0ULL
+#define KHAZAD_GF2P8_MUL4           0x408041C2C4881020ULL
+#define KHAZAD_GF2P8_MUL5           0x418245CAD4A850A0ULL
+#define KHAZAD_GF2P8_MUL6           0xC081C3464C983060ULL
+#define KHAZAD_GF2P8_MUL7           0xC183C74E5CB870E0ULL
+#define KHAZAD_GF2P8_MUL8           0x2040A061E2C48810ULL
+#define KHAZAD_GF2P8_MULB           0xA14326ED7AF4E8D0ULL
+
+/* vpternlog function for a ^ b ^ c */
+#define KHAZAD_TERNLOG_XOR3         0x96
+
+/*****************************************************************************
+ * Types
+ ****************************************************************************/
+
+/* Constants for the round functions, loaded into registers once per call. */
+typedef struct
+{
+    __m512i     sbox[4u];
+    __m512i     mul[KHAZAD_BLOCK_SIZE];
+    __m512i     permute[KHAZAD_BLOCK_SIZE];
+} khazad_avx512_consts_t;
+
+/*****************************************************************************
+ * Look-up tables
+ ****************************************************************************/
+
+/* Same as khazad_sbox_table in khazad-min.c. */
+static const uint8_t khazad_sbox_table[256u] __attribute__((aligned(64))) =
+{
+    0xBA, 0x54, 0x2F, 0x74, 0x53, 0xD3, 0xD2, 0x4D, 0x50, 0xAC, 0x8D, 0xBF, 0x70, 0x52, 0x9A, 0x4C,
+    0xEA, 0xD5, 0x97, 0xD1, 0x33, 0x51, 0x5B, 0xA6, 0xDE, 0x48, 0xA8, 0x99, 0xDB, 0x32, 0xB7, 0xFC,
+    0xE3, 0x9E, 0x91, 0x9B, 0xE2, 0xBB, 0x41, 0x6E, 0xA5, 0xCB, 0x6B, 0x95, 0xA1, 0xF3, 0xB1, 0x02,
+    0xCC, 0xC4, 0x1D, 0x14, 0xC3, 0x63, 0xDA, 0x5D, 0x5F, 0xDC, 0x7D, 0xCD, 0x7F, 0x5A, 0x6C, 0x5C,
+    0xF7, 0x26, 0xFF, 0xED, 0xE8, 0x9D, 0x6F, 0x8E, 0x19, 0xA0, 0xF0, 0x89, 0x0F, 0x07, 0xAF, 0xFB,
+    0x08, 0x15, 0x0D, 0x04, 0x01, 0x64, 0xDF, 0x76, 0x79, 0xDD, 0x3D, 0x16, 0x3F, 0x37, 0x6D, 0x38,
+    0xB9, 0x73, 0xE9, 0x35, 0x55, 0x71, 0x7B, 0x8C, 0x72, 0x88, 0xF6, 0x2A, 0x3E, 0x5E, 0x27, 0x46,
+    0x0C, 0x65, 0x68, 0x61, 0x03, 0xC1, 0x57, 0xD6, 0xD9, 0x58, 0xD8, 0x66, 0xD7, 0x3A, 0xC8, 0x3C,
+    0xFA, 0x96, 0xA7, 0x98, 0xEC, 0xB8, 0xC7, 0xAE, 0x69, 0x4B, 0xAB, 0xA9, 0x67, 0x0A, 0x47, 0xF2,
+    0xB5, 0x22, 0xE5, 0xEE, 0xBE, 0x2B, 0x81, 0x12, 0x83, 0x1B, 0x0E, 0x23, 0xF5, 0x45, 0x21, 0xCE,
+    0x49, 0x2C, 0xF9, 0xE6, 0xB6, 0x28, 0x17, 0x82, 0x1A, 0x8B, 0xFE, 0x8A, 0x09, 0xC9, 0x87, 0x4E,
+    0xE1, 0x2E, 0xE4, 0xE0, 0xEB, 0x90, 0xA4, 0x1E, 0x85, 0x60, 0x00, 0x25, 0xF4, 0xF1, 0x94, 0x0B,
+    0xE7, 0x75, 0xEF, 0x34, 0x31, 0xD4, 0xD0, 0x86, 0x7E, 0xAD, 0xFD, 0x29, 0x30, 0x3B, 0x9F, 0xF8,
+    0xC6, 0x13, 0x06, 0x05, 0xC5, 0x11, 0x77, 0x7C, 0x7A, 0x78, 0x36, 0x1C, 0x39, 0x59, 0x18, 0x56,
+    0xB3, 0xB0, 0x24, 0x20, 0xB2, 0x92, 0xA3, 0xC0, 0x44, 0x62, 0x10, 0xB4, 0x84, 0x43, 0x93, 0xC2,
+    0x4A, 0xBD, 0x8F, 0x2D, 0xBC, 0x9C, 0x6A, 0x40, 0xCF, 0xA2, 0x80, 0x4F, 0x1F, 0xCA, 0xAA, 0x42
+};
+
+/* Row of the diffusion matrix, as gf2p8affineqb matrices. Index 0 is unused,
+ * since h[0] = 1. */
+static const uint64_t khazad_mul_matrix[KHAZAD_BLOCK_SIZE] =
+{
+    0,
+    KHAZAD_GF2P8_MUL3,
+    KHAZAD_GF2P8_MUL4,
+    KHAZAD_GF2P8_MUL5,
+    KHAZAD_GF2P8_MUL6,
+    KHAZAD_GF2P8_MUL8,
+    KHAZAD_GF2P8_MULB,
+    KHAZAD_GF2P8_MUL7,
+};
+
+/*****************************************************************************
+ * Inline functions
+ ****************************************************************************/
+
+static inline __m512i khazad_avx512_sbox(__m512i a, const khazad_avx512_consts_t * p_consts)
+{
+    __m512i     lo = _mm512_permutex2var_epi8(p_consts->sbox[0], a, p_consts->sbox[1]);
+    __m512i     hi = _mm512_permutex2var_epi8(p_consts->sbox[2], a, p_consts->sbox[3]);
+
+    return _mm512_mask_blend_epi8(_mm512_movepi8_mask(a), lo, hi);
+}
+
+/* Term k of the diffusion layer: h[k] times input byte i ^ k. */
+static inline __m512i khazad_avx512_term(__m512i a, uint_fast8_t k, const khazad_avx512_consts_t * p_consts)
+{
+    return _mm512_shuffle_epi8(_mm512_gf2p8affine_epi64_epi8(a, p_consts->mul[k], 0), p_consts->permute[k]);
+}
+
+static inline __m512i khazad_avx512_diffusion(__m512i a, const khazad_avx512_consts_t * p_consts)
+{
+    __m512i     sum;
+
+    sum = _mm512_ternarylogic_epi64(a,
+                                    khazad_avx512_term(a, 1u, p_consts),
+                                    khazad_avx512_term(a, 2u, p_consts),
+                                    KHAZAD_TERNLOG_XOR3);
+    sum = _mm512_ternarylogic_epi64(sum,
+                                    khazad_avx512_term(a, 3u, p_consts),
+                                    khazad_avx512_term(a, 4u, p_consts),
+                                    KHAZAD_TERNLOG_XOR3);
+    sum = _mm512_ternarylogic_epi64(sum,
+                                    khazad_avx512_term(a, 5u, p_consts),
+                                    khazad_avx512_term(a, 6u, p_consts),
+                                    KHAZAD_TERNLOG_XOR3);
+    return _mm512_xor_si512(sum, khazad_avx512_term(a, 7u, p_consts));
+}
+
+static inline __m512i khazad_avx512_key(const uint8_t p_key_schedule_block[KHAZAD_BLOCK_SIZE])
+{
+    return _mm512_set1_epi64((long long)khazad_load_word(p_key_schedule_block));
+}
+
+/*****************************************************************************
+ * Local functions
+ ****************************************************************************/
+
+static void khazad_avx512_init_consts(khazad_avx512_consts_t * p_consts)
+{
+    uint8_t         permute[16u];
+    uint_fast8_t    i;
+    uint_fast8_t    k;
+
+    for (i = 0; i < 4u; ++i)
+    {
+        p_consts->sbox[i] = _mm512_load_si512(&khazad_sbox_table[i * 64u]);
+    }
+    for (k = 0; k < KHAZAD_BLOCK_SIZE; ++k)
+    {
+        p_consts->mul[k] = _mm512_set1_epi64((long long)khazad_mul_matrix[k]);
+        for (i = 0; i < 16u; ++i)
+        {
+            permute[i] = (uint8_t)(i ^ k);
+        }
+        p_consts->permute[k] = _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)permute));
+    }
+}
+
+static inline __m512i khazad_avx512_crypt_vec(__m512i a, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE], const khazad_avx512_consts_t * p_consts)
+{
+    uint_fast8_t    round;
+
+    a = _mm512_xor_si512(a, khazad_avx512_key(p_key_schedule));
+    for (round = 1u; round < KHAZAD_NUM_ROUNDS; ++round)
+    {
+        p_key_schedule += KHAZAD_BLOCK_SIZE;
+        a = _mm512_xor_si512(khazad_avx512_diffusion(khazad_avx512_sbox(a, p_consts), p_consts),
+                             khazad_avx512_key(p_key_schedule));
+    }
+    p_key_schedule += KHAZAD_BLOCK_SIZE;
+    return _mm512_xor_si512(khazad_avx512_sbox(a, p_consts), khazad_avx512_key(p_key_schedule));
+}
+
+static inline __m512i khazad_avx512_decrypt_vec(__m512i a, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE], const khazad_avx512_consts_t * p_consts)
+{
+    uint_fast8_t    round;
+
+    p_key_schedule += KHAZAD_KEY_SCHEDULE_SIZE - KHAZAD_BLOCK_SIZE;
+    a = khazad_avx512_sbox(_mm512_xor_si512(a, khazad_avx512_key(p_key_schedule)), p_consts);
+    for (round = 1u; round < KHAZAD_NUM_ROUNDS; ++round)
+    {
+        p_key_schedule -= KHAZAD_BLOCK_SIZE;
+        a = khazad_avx512_sbox(khazad_avx512_diffusion(_mm512_xor_si512(a, khazad_avx512_key(p_key_schedule)), p_consts), p_consts);
+    }
+    p_key_schedule -= KHAZAD_BLOCK_SIZE;
+    return _mm512_xor_si512(a, khazad_avx512_key(p_key_schedule));
+}
+
+/* Key schedules of up to 8 keys, one key per 64-bit lane. The key halves are
+ * separated into lanes with vpermt2q, and each round key is scattered to the
+ * key schedules, with masks for a partial group. */
+static void khazad_avx512_key_schedule_step(uint8_t * p_key_schedules, const uint8_t * p_keys, size_t num_keys, const khazad_avx512_consts_t * p_consts)
+{
+    const __m512i   index_m2 = _mm512_set_epi64(14, 12, 10, 8, 6, 4, 2, 0);
+    const __m512i   index_m1 = _mm512_set_epi64(15, 13, 11, 9, 7, 5, 3, 1);
+    const __m512i   offsets = _mm512_set_epi64(7 * KHAZAD_KEY_SCHEDULE_SIZE, 6 * KHAZAD_KEY_SCHEDULE_SIZE,
+                                               5 * KHAZAD_KEY_SCHEDULE_SIZE, 4 * KHAZAD_KEY_SCHEDULE_SIZE,
+                                               3 * KHAZAD_KEY_SCHEDULE_SIZE, 2 * KHAZAD_KEY_SCHEDULE_SIZE,
+                                               KHAZAD_KEY_SCHEDULE_SIZE, 0);
+    __mmask8        mask = (__mmask8)((1u << num_keys) - 1u);
+    __mmask8        mask_lo;
+    __mmask8        mask_hi;
+    uint_fast8_t    round;
+    __m512i         lo;
+    __m512i         hi;
+    __m512i         key_m2;
+    __m512i         key_m1;
+    __m512i         key;
+
+    /* Two key words per key, so keys 0-3 are in the first register. */
+    mask_lo = (num_keys >= 4u) ? 0xFFu : (__mmask8)((1u << (2u * num_keys)) - 1u);
+    mask_hi = (num_keys <= 4u) ? 0 : (__mmask8)((1u << (2u * (num_keys - 4u))) - 1u);
+    lo = _mm512_maskz_loadu_epi64(mask_lo, p_keys);
+    hi = _mm512_maskz_loadu_epi64(mask_hi, p_keys + 4u * KHAZAD_KEY_SIZE);
+    key_m2 = _mm512_permutex2var_epi64(lo, index_m2, hi);
+    key_m1 = _mm512_permutex2var_epi64(lo, index_m1, hi);
+    for (round = 0; round < (KHAZAD_NUM_ROUNDS + 1u); ++round)
+    {
+        key = _mm512_ternarylogic_epi64(khazad_avx512_diffusion(khazad_avx512_sbox(key_m1, p_consts), p_consts),
+                                        khazad_avx512_key(&khazad_sbox_table[round * KHAZAD_BLOCK_SIZE]),
+                                        key_m2,
+                                        KHAZAD_TERNLOG_XOR3);
+        _mm512_mask_i64scatter_epi64(p_key_schedules + round * KHAZAD_BLOCK_SIZE, mask, offsets, key, 1);
+        key_m2 = key_m1;
+        key_m1 = key;
+    }
+}
+
+/* The keyed block functions are only built for x86-64, so the gather indices
+ * are full-width address offsets. 32-bit builds use the AVX2 kernel's keyed
+ * block functions instead. */
+#if defined(__x86_64__)
+
+/* Gather the round key at offset from each entry's key schedule. The gather
+ * is based at the first entry's key schedule, with each entry's key schedule
+ * as a byte offset from it. */
+static inline __m512i khazad_avx512_keyed_key(const uint8_t * p_base, __m512i key_offsets, size_t offset, __mmask8 mask)
+{
+    return _mm512_mask_i64gather_epi64(_mm512_setzero_si512(), mask, key_offsets, p_base + offset, 1);
+}
+
+/* As for khazad_avx512_crypt_vec() and khazad_avx512_decrypt_vec(), on up to
+ * 8 blocks, each with its own key schedule. The blocks are copied in and out
+ * with scalar code, and the round keys gathered. */
+static void khazad_avx512_keyed_step(const khazad_keyed_block_t * p_blocks, size_t num_blocks, bool decrypt, const khazad_avx512_consts_t * p_consts)
+{
+    const uint8_t * p_base = p_blocks[0].p_key_schedule;
+    uint8_t         state[KHAZAD_AVX512_BYTES];
+    long long       key_offsets[KHAZAD_AVX512_BLOCKS];
+    __mmask8        mask = (__mmask8)((1u << num_blocks) - 1u);
+    uint_fast8_t    round;
+    __m512i         offsets;
+    __m512i         a;
+    size_t          i;
+
+    for (i = 0; i < KHAZAD_AVX512_BLOCKS; ++i)
+    {
+        if (i < num_blocks)
+        {
+            memcpy(&state[i * KHAZAD_BLOCK_SIZE], p_blocks[i].p_block, KHAZAD_BLOCK_SIZE);
+            key_offsets[i] = (long long)((uintptr_t)p_blocks[i].p_key_schedule - (uintptr_t)p_base);
+        }
+        else
+        {
+            memset(&state[i * KHAZAD_BLOCK_SIZE], 0, KHAZAD_BLOCK_SIZE);
+            key_offsets[i] = 0;
+        }
+    }
+    offsets = _mm512_loadu_si512(key_offsets);
+
+    a = _mm512_loadu_si512(state);
+    if (!decrypt)
+    {
+        a = _mm512_xor_si512(a, khazad_avx512_keyed_key(p_base, offsets, 0, mask));
+        for (round = 1u; round < KHAZAD_NUM_ROUNDS; ++round)
+        {
+            a = _mm512_xor_si512(khazad_avx512_diffusion(khazad_avx512_sbox(a, p_consts), p_consts),
+                                 khazad_avx512_keyed_key(p_base, offsets, round * KHAZAD_BLOCK_SIZE, mask));
+        }
+        a = _mm512_xor_si512(khazad_avx512_sbox(a, p_consts),
+                             khazad_avx512_keyed_key(p_base, offsets, KHAZAD_NUM_ROUNDS * KHAZAD_BLOCK_SIZE, mask));
+    }
+    else
+    {
+        a = khazad_avx512_sbox(_mm512_xor_si512(a, khazad_avx512_keyed_key(p_base, offsets, KHAZAD_NUM_ROUNDS * KHAZAD_BLOCK_SIZE, mask)), p_consts);
+        for (round = KHAZAD_NUM_ROUNDS - 1u; round >= 1u; --round)
+        {
+            a = khazad_avx512_sbox(khazad_avx512_diffusion(_mm512_xor_si512(a, khazad_avx512_keyed_key(p_base, offsets, round * KHAZAD_BLOCK_SIZE, mask)), p_consts), p_consts);
+        }
+        a = _mm512_xor_si512(a, khazad_avx512_keyed_key(p_base, offsets, 0, mask));
+    }
+    _mm512_storeu_si512(state, a);
+    for (i = 0; i < num_blocks; ++i)
+    {
+        memcpy(p_blocks[i].p_block, &state[i * KHAZAD_BLOCK_SIZE], KHAZAD_BLOCK_SIZE);
+    }
+}
+
+#endif /* defined(__x86_64__) */
+
+/*****************************************************************************
+ * Functions
+ ****************************************************************************/
+
+/* Encrypt (or decrypt, with a decryption key schedule) num_blocks
+ * contiguous blocks from p_src to p_dst. p_dst may equal p_src.
+ * Two registers (16 blocks) are processed together, then any remaining
+ * blocks 8 at a time, with masked loads and stores for the last partial
+ * register. */
+void khazad_avx512_crypt_blocks(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE])
+{
+    khazad_avx512_consts_t  consts;
+    __m512i                 a;
+    __m512i                 b;
+    __mmask8                mask;
+
+    khazad_avx512_init_consts(&consts);
+    for (; num_blocks >= 2u * KHAZAD_AVX512_BLOCKS; num_blocks -= 2u * KHAZAD_AVX512_BLOCKS)
+    {
+        a = _mm512_loadu_si512(p_src);
+        b = _mm512_loadu_si512(p_src + KHAZAD_AVX512_BYTES);
+        a = khazad_avx512_crypt_vec(a, p_key_schedule, &consts);
+        b = khazad_avx512_crypt_vec(b, p_key_schedule, &consts);
+        _mm512_storeu_si512(p_dst, a);
+        _mm512_storeu_si512(p_dst + KHAZAD_AVX512_BYTES, b);
+        p_dst += 2u * KHAZAD_AVX512_BYTES;
+        p_src += 2u * KHAZAD_AVX512_BYTES;
+    }
+    while (num_blocks)
+    {
+        if (num_blocks >= KHAZAD_AVX512_BLOCKS)
+        {
+            mask = 0xFFu;
+            num_blocks -= KHAZAD_AVX512_BLOCKS;
+        }
+        else
+        {
+            mask = (__mmask8)((1u << num_blocks) - 1u);
+            num_blocks = 0;
+        }
+        a = _mm512_maskz_loadu_epi64(mask, p_src);
+        a = khazad_avx512_crypt_vec(a, p_key_schedule, &consts);
+        _mm512_mask_storeu_epi64(p_dst, mask, a);
+        p_dst += KHAZAD_AVX512_BYTES;
+        p_src += KHAZAD_AVX512_BYTES;
+    }
+}
+
+/* Decrypt num_blocks contiguous blocks from p_src to p_dst, using the
+ * regular key schedule created by khazad_key_schedule(). p_dst may equal
+ * p_src. */
+void khazad_avx512_decrypt_blocks(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE])
+{
+    khazad_avx512_consts_t  consts;
+    __m512i                 a;
+    __m512i                 b;
+    __mmask8                mask;
+
+    khazad_avx512_init_consts(&consts);
+    for (; num_blocks >= 2u * KHAZAD_AVX512_BLOCKS; num_blocks -= 2u * KHAZAD_AVX512_BLOCKS)
+    {
+        a = _mm512_loadu_si512(p_src);
+        b = _mm512_loadu_si512(p_src + KHAZAD_AVX512_BYTES);
+        a = khazad_avx512_decrypt_vec(a, p_key_schedule, &consts);
+        b = khazad_avx512_decrypt_vec(b, p_key_schedule, &consts);
+        _mm512_storeu_si512(p_dst, a);
+        _mm512_storeu_si512(p_dst + KHAZAD_AVX512_BYTES, b);
+        p_dst += 2u * KHAZAD_AVX512_BYTES;
+        p_src += 2u * KHAZAD_AVX512_BYTES;
+    }
+    while (num_blocks)
+    {
+        if (num_blocks >= KHAZAD_AVX512_BLOCKS)
+        {
+            mask = 0xFFu;
+            num_blocks -= KHAZAD_AVX512_BLOCKS;
+        }
+        else
+        {
+            mask = (__mmask8)((1u << num_blocks) - 1u);
+            num_blocks = 0;
+        }
+        a = _mm512_maskz_loadu_epi64(mask, p_src);
+        a = khazad_avx512_decrypt_vec(a, p_key_schedule, &consts);
+        _mm512_mask_storeu_epi64(p_dst, mask, a);
+        p_dst += KHAZAD_AVX512_BYTES;
+        p_src += KHAZAD_AVX512_BYTES;
+    }
+}
+
+/* Calculate the key schedules of num_keys keys, stored contiguously at p_keys,
+ * into contiguous key schedules at p_key_schedules, as for
+ * khazad_key_schedule(). */
+void khazad_avx512_key_schedule_multi(uint8_t * p_key_schedules, const uint8_t * p_keys, size_t num_keys)
+{
+    khazad_avx512_consts_t  consts;
+    size_t                  group_keys;
+
+    khazad_avx512_init_consts(&consts);
+    while (num_keys)
+    {
+        group_keys = (num_keys < KHAZAD_AVX512_BLOCKS) ? num_keys : KHAZAD_AVX512_BLOCKS;
+        khazad_avx512_key_schedule_step(p_key_schedules, p_keys, group_keys, &consts);
+        p_key_schedules += group_keys * KHAZAD_KEY_SCHEDULE_SIZE;
+        p_keys += group_keys * KHAZAD_KEY_SIZE;
+        num_keys -= group_keys;
+    }
+}
+
+#if defined(__x86_64__)
+
+/* Encrypt (or decrypt, with decryption key schedules) num_blocks blocks
+ * in-place, each with its own key schedule, as for
+ * khazad_crypt_keyed_blocks(). */
+void khazad_avx512_crypt_keyed_blocks(const khazad_keyed_block_t * p_blocks, size_t num_blocks)
+{
+    khazad_avx512_consts_t  consts;
+    size_t                  group_blocks;
+
+    khazad_avx512_init_consts(&consts);
+    while (num_blocks)
+    {
+        group_blocks = (num_blocks < KHAZAD_AVX512_BLOCKS) ? num_blocks : KHAZAD_AVX512_BLOCKS;
+        khazad_avx512_keyed_step(p_blocks, group_blocks, false, &consts);
+        p_blocks += group_blocks;
+        num_blocks -= group_blocks;
+    }
+}
+
+/* Decrypt num_blocks blocks in-place, each with its own regular key
+ * schedule, as for khazad_decrypt_keyed_blocks(). */
+void khazad_avx512_decrypt_keyed_blocks(const khazad_keyed_block_t * p_blocks, size_t num_blocks)
+{
+    khazad_avx512_consts_t  consts;
+    size_t                  group_blocks;
+
+    khazad_avx512_init_consts(&consts);
+    while (num_blocks)
+    {
+        group_blocks = (num_blocks < KHAZAD_AVX512_BLOCKS) ? num_blocks : KHAZAD_AVX512_BLOCKS;
+        khazad_avx512_keyed_step(p_blocks, group_blocks, true, &consts);
+        p_blocks += group_blocks;
+        num_blocks -= group_blocks;
+    }
+}
+
+#endif /* defined(__x86_64__) */
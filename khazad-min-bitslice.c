@@ -0,0 +1,424 @@
+/*****************************************************************************
+ * khazad-min-bitslice.c
+ *
+ * Bitsliced Khazad encryption and decryption of many blocks at once.
+ *
+ * 64 blocks are transposed so that each uint64_t holds one bit position of
+ * the block, for all 64 blocks. The S-box is evaluated as a Boolean circuit
+ * built from the 4-bit P and Q mini-boxes, and the diffusion layer is done by
+ * XORs of bit planes. There are no look-ups indexed by secret data, so the
+ * timing does not depend on the key or data.
+ *
+ * KHAZAD_BITSLICE_LANES can be defined as 2, 4 or 8 to use compiler vector
+ * types of 128, 256 or 512 bits, to process 128, 256 or 512 blocks at a time.
+ * To get the benefit, the matching instruction set must also be enabled in
+ * the compiler options (CFLAGS), e.g. -mavx2 for 4 lanes or -mavx512f for 8.
+ * Without it, the compiler splits the vector operations into smaller ones;
+ * configure warns about that on x86. No vector is passed to or returned from
+ * a function by value, since that has a different ABI without the instruction
+ * set, and the vector helper functions are always inlined.
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Includes
+ ****************************************************************************/
+
+#include "khazad-min.h"
+#include "khazad-min-internal.h"
+
+#include <string.h>
+
+/*****************************************************************************
+ * Defines
+ ****************************************************************************/
+
+#ifndef KHAZAD_BITSLICE_LANES
+#define KHAZAD_BITSLICE_LANES       1
+#endif
+
+#if KHAZAD_BITSLICE_LANES != 1 && KHAZAD_BITSLICE_LANES != 2 && \
+    KHAZAD_BITSLICE_LANES != 4 && KHAZAD_BITSLICE_LANES != 8
+#error "KHAZAD_BITSLICE_LANES must be 1, 2, 4 or 8"
+#endif
+
+#if KHAZAD_BITSLICE_LANES == 1
+#define KHAZAD_BS_INLINE            static inline
+#else
+#define KHAZAD_BS_INLINE            static inline __attribute__((always_inline))
+#endif
+
+/* All-ones if bit is 1, otherwise all-zeros. A macro rather than a function,
+ * since a function returning a vector wider than the enabled instruction set
+ * has a non-standard ABI. */
+#define KHAZAD_BS_MASK(bit)         ((khazad_bs_word_t){ 0 } - (uint64_t)(bit))
+
+#define KHAZAD_BITSLICE_BITS        (KHAZAD_BLOCK_SIZE * 8u)
+#define KHAZAD_BITSLICE_GROUP       (KHAZAD_BITSLICE_BITS * KHAZAD_BITSLICE_LANES)
+
+/*****************************************************************************
+ * Types
+ ****************************************************************************/
+
+#if KHAZAD_BITSLICE_LANES == 1
+typedef uint64_t khazad_bs_word_t;
+#else
+typedef uint64_t khazad_bs_word_t __attribute__((vector_size(KHAZAD_BITSLICE_LANES * sizeof(uint64_t))));
+#endif
+
+/* Bit planes of a group of blocks, indexed by [byte][bit]. */
+typedef khazad_bs_word_t khazad_bs_state_t[KHAZAD_BLOCK_SIZE][8u];
+
+/*****************************************************************************
+ * Inline functions
+ ****************************************************************************/
+
+/* The P and Q mini-boxes, in algebraic normal form.
+ * x[0] is the least significant bit of the nibble. */
+KHAZAD_BS_INLINE void khazad_bs_p_box(khazad_bs_word_t x[4u])
+{
+    khazad_bs_word_t    x01 = x[0] & x[1];
+    khazad_bs_word_t    x02 = x[0] & x[2];
+    khazad_bs_word_t    x12 = x[1] & x[2];
+    khazad_bs_word_t    x03 = x[0] & x[3];
+    khazad_bs_word_t    x13 = x[1] & x[3];
+    khazad_bs_word_t    x23 = x[2] & x[3];
+    khazad_bs_word_t    x012 = x01 & x[2];
+    khazad_bs_word_t    x013 = x01 & x[3];
+    khazad_bs_word_t    x023 = x02 & x[3];
+    khazad_bs_word_t    x123 = x12 & x[3];
+    khazad_bs_word_t    y0;
+    khazad_bs_word_t    y1;
+    khazad_bs_word_t    y2;
+    khazad_bs_word_t    y3;
+
+    y0 = ~(x[1] ^ x02 ^ x12 ^ x03 ^ x13 ^ x023);
+    y1 = ~(x01 ^ x[2] ^ x12 ^ x[3] ^ x03 ^ x013 ^ x123);
+    y2 = x[0] ^ x[1] ^ x[2] ^ x02 ^ x012 ^ x[3] ^ x23 ^ x023;
+    y3 = x[0] ^ x[1] ^ x02 ^ x[3] ^ x03 ^ x13 ^ x013 ^ x23;
+    x[0] = y0;
+    x[1] = y1;
+    x[2] = y2;
+    x[3] = y3;
+}
+
+KHAZAD_BS_INLINE void khazad_bs_q_box(khazad_bs_word_t x[4u])
+{
+    khazad_bs_word_t    x01 = x[0] & x[1];
+    khazad_bs_word_t    x02 = x[0] & x[2];
+    khazad_bs_word_t    x12 = x[1] & x[2];
+    khazad_bs_word_t    x03 = x[0] & x[3];
+    khazad_bs_word_t    x13 = x[1] & x[3];
+    khazad_bs_word_t    x23 = x[2] & x[3];
+    khazad_bs_word_t    x012 = x01 & x[2];
+    khazad_bs_word_t    x013 = x01 & x[3];
+    khazad_bs_word_t    x023 = x02 & x[3];
+    khazad_bs_word_t    x123 = x12 & x[3];
+    khazad_bs_word_t    y0;
+    khazad_bs_word_t    y1;
+    khazad_bs_word_t    y2;
+    khazad_bs_word_t    y3;
+
+    y0 = ~(x[0] ^ x[2] ^ x02 ^ x12 ^ x012 ^ x13 ^ x23);
+    y1 = x[0] ^ x[2] ^ x02 ^ x012 ^ x[3] ^ x13 ^ x013 ^ x23;
+    y2 = x[0] ^ x[1] ^ x01 ^ x02 ^ x12 ^ x[3] ^ x13 ^ x023;
+    y3 = ~(x[1] ^ x02 ^ x03 ^ x23 ^ x023 ^ x123);
+    x[0] = y0;
+    x[1] = y1;
+    x[2] = y2;
+    x[3] = y3;
+}
+
+/* Bit-mixing step between the mini-box layers. Bits 3 and 2 of the high
+ * nibble stay, bits 3 and 2 of the low nibble move to bits 1 and 0 of the high
+ * nibble, and vice-versa. */
+KHAZAD_BS_INLINE void khazad_bs_sbox_mix(khazad_bs_word_t x[8u])
+{
+    khazad_bs_word_t    temp;
+
+    temp = x[4];
+    x[4] = x[2];
+    x[2] = temp;
+    temp = x[5];
+    x[5] = x[3];
+    x[3] = temp;
+}
+
+/* S-box on the 8 bit planes of one byte. Same structure as the
+ * ENABLE_SBOX_SMALL implementation in khazad-min.c. */
+KHAZAD_BS_INLINE void khazad_bs_sbox(khazad_bs_word_t x[8u])
+{
+    khazad_bs_p_box(&x[4]);
+    khazad_bs_q_box(&x[0]);
+    khazad_bs_sbox_mix(x);
+    khazad_bs_q_box(&x[4]);
+    khazad_bs_p_box(&x[0]);
+    khazad_bs_sbox_mix(x);
+    khazad_bs_p_box(&x[4]);
+    khazad_bs_q_box(&x[0]);
+}
+
+/* Multiply the 8 bit planes of one byte by 2, modulo 0x11D. */
+KHAZAD_BS_INLINE void khazad_bs_mul2(khazad_bs_word_t p_out[8u], const khazad_bs_word_t p_in[8u])
+{
+    p_out[0] = p_in[7];
+    p_out[1] = p_in[0];
+    p_out[2] = p_in[1] ^ p_in[7];
+    p_out[3] = p_in[2] ^ p_in[7];
+    p_out[4] = p_in[3] ^ p_in[7];
+    p_out[5] = p_in[4];
+    p_out[6] = p_in[5];
+    p_out[7] = p_in[6];
+}
+
+KHAZAD_BS_INLINE void khazad_bs_xor(khazad_bs_word_t p_out[8u], const khazad_bs_word_t p_a[8u], const khazad_bs_word_t p_b[8u])
+{
+    uint_fast8_t    bit;
+
+    for (bit = 0; bit < 8u; ++bit)
+    {
+        p_out[bit] = p_a[bit] ^ p_b[bit];
+    }
+}
+
+/*****************************************************************************
+ * Local functions
+ ****************************************************************************/
+
+/* Load up to KHAZAD_BITSLICE_GROUP blocks, and transpose so that state
+ * word [j][b] bit n is bit b of byte j of block n (of each lane).
+ * Missing blocks at the end are zero. */
+static void khazad_bs_load(khazad_bs_state_t state, const uint8_t * p_blocks, size_t num_blocks)
+{
+    khazad_bs_word_t  * p_words = &state[0][0];
+    khazad_bs_word_t    temp;
+    khazad_bs_word_t    mask;
+    uint_fast8_t        j;
+    uint_fast8_t        k;
+    size_t              n;
+    size_t              block;
+
+    for (n = 0; n < KHAZAD_BITSLICE_BITS; ++n)
+    {
+#if KHAZAD_BITSLICE_LANES == 1
+        block = n;
+        p_words[n] = (block < num_blocks) ? khazad_load_word(p_blocks + block * KHAZAD_BLOCK_SIZE) : 0;
+#else
+        uint_fast8_t    lane;
+
+        for (lane = 0; lane < KHAZAD_BITSLICE_LANES; ++lane)
+        {
+            block = lane * KHAZAD_BITSLICE_BITS + n;
+            p_words[n][lane] = (block < num_blocks) ? khazad_load_word(p_blocks + block * KHAZAD_BLOCK_SIZE) : 0;
+        }
+#endif
+    }
+
+    /* 64x64 bit matrix transpose, in 6 stages of swapping bit blocks. */
+    mask = KHAZAD_BS_MASK(1u) >> 32u;
+    for (j = 32u; j != 0; j >>= 1u, mask ^= (mask << j))
+    {
+        for (k = 0; k < KHAZAD_BITSLICE_BITS; k = ((k | j) + 1u) & ~j)
+        {
+            temp = ((p_words[k] >> j) ^ p_words[k | j]) & mask;
+            p_words[k] ^= temp << j;
+            p_words[k | j] ^= temp;
+        }
+    }
+}
+
+/* Transpose back, and store num_blocks blocks. */
+static void khazad_bs_store(uint8_t * p_blocks, size_t num_blocks, khazad_bs_state_t state)
+{
+    khazad_bs_word_t  * p_words = &state[0][0];
+    khazad_bs_word_t    temp;
+    khazad_bs_word_t    mask;
+    uint_fast8_t        j;
+    uint_fast8_t        k;
+    size_t              n;
+    size_t              block;
+
+    /* The transpose is its own inverse. */
+    mask = KHAZAD_BS_MASK(1u) >> 32u;
+    for (j = 32u; j != 0; j >>= 1u, mask ^= (mask << j))
+    {
+        for (k = 0; k < KHAZAD_BITSLICE_BITS; k = ((k | j) + 1u) & ~j)
+        {
+            temp = ((p_words[k] >> j) ^ p_words[k | j]) & mask;
+            p_words[k] ^= temp << j;
+            p_words[k | j] ^= temp;
+        }
+    }
+
+    for (n = 0; n < KHAZAD_BITSLICE_BITS; ++n)
+    {
+#if KHAZAD_BITSLICE_LANES == 1
+        block = n;
+        if (block < num_blocks)
+            khazad_store_word(p_blocks + block * KHAZAD_BLOCK_SIZE, p_words[n]);
+#else
+        uint_fast8_t    lane;
+
+        for (lane = 0; lane < KHAZAD_BITSLICE_LANES; ++lane)
+        {
+            block = lane * KHAZAD_BITSLICE_BITS + n;
+            if (block < num_blocks)
+                khazad_store_word(p_blocks + block * KHAZAD_BLOCK_SIZE, p_words[n][lane]);
+        }
+#endif
+    }
+}
+
+static void khazad_bs_add_key(khazad_bs_state_t state, const uint8_t p_key_schedule_block[KHAZAD_BLOCK_SIZE])
+{
+    uint_fast8_t    i;
+    uint_fast8_t    bit;
+
+    for (i = 0; i < KHAZAD_BLOCK_SIZE; ++i)
+    {
+        for (bit = 0; bit < 8u; ++bit)
+        {
+            state[i][bit] ^= KHAZAD_BS_MASK((p_key_schedule_block[i] >> bit) & 1u);
+        }
+    }
+}
+
+static void khazad_bs_sbox_apply(khazad_bs_state_t state)
+{
+    uint_fast8_t    i;
+
+    for (i = 0; i < KHAZAD_BLOCK_SIZE; ++i)
+    {
+        khazad_bs_sbox(state[i]);
+    }
+}
+
+/* Diffusion layer, factored as for khazad_matrix_imul() in khazad-min.c. */
+static void khazad_bs_diffusion(khazad_bs_state_t state)
+{
+    khazad_bs_word_t    q1[KHAZAD_BLOCK_SIZE][8u];
+    khazad_bs_word_t    q3[KHAZAD_BLOCK_SIZE][8u];
+    khazad_bs_word_t    q3_mul2[KHAZAD_BLOCK_SIZE][8u];
+    khazad_bs_word_t    r[8u];
+    khazad_bs_word_t    z[8u];
+    khazad_bs_word_t    w[8u];
+    khazad_bs_word_t    w_mul2[8u];
+    khazad_bs_state_t   output;
+    uint_fast8_t        i;
+
+    for (i = 0; i < KHAZAD_BLOCK_SIZE; ++i)
+    {
+        if ((i & 1u) == 0)
+        {
+            khazad_bs_xor(q1[i], state[i], state[i ^ 1u]);
+            memcpy(q1[i ^ 1u], q1[i], sizeof(q1[i]));
+        }
+        if ((i & 2u) == 0)
+        {
+            khazad_bs_xor(q3[i], state[i], state[i ^ 3u]);
+            memcpy(q3[i ^ 3u], q3[i], sizeof(q3[i]));
+            khazad_bs_mul2(q3_mul2[i], q3[i]);
+            memcpy(q3_mul2[i ^ 3u], q3_mul2[i], sizeof(q3_mul2[i]));
+        }
+    }
+
+    for (i = 0; i < KHAZAD_BLOCK_SIZE; ++i)
+    {
+        /* w = z2 + 2 * z3 */
+        khazad_bs_xor(z, q1[i ^ 2u], q3[i ^ 4u]);
+        khazad_bs_xor(w, z, q3_mul2[i ^ 5u]);
+
+        /* w = z1 + 2 * w */
+        khazad_bs_xor(r, state[i ^ 1u], q1[i ^ 6u]);
+        khazad_bs_xor(z, state[i ^ 4u], r);
+        khazad_bs_mul2(w_mul2, w);
+        khazad_bs_xor(w, z, w_mul2);
+
+        /* y = z0 + 2 * w */
+        khazad_bs_xor(z, q3[i], r);
+        khazad_bs_mul2(w_mul2, w);
+        khazad_bs_xor(output[i], z, w_mul2);
+    }
+
+    memcpy(state, output, sizeof(output));
+}
+
+static void khazad_bs_crypt_group(khazad_bs_state_t state, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE])
+{
+    uint_fast8_t    round;
+
+    khazad_bs_add_key(state, p_key_schedule);
+    for (round = 1u; round < KHAZAD_NUM_ROUNDS; ++round)
+    {
+        p_key_schedule += KHAZAD_BLOCK_SIZE;
+        khazad_bs_sbox_apply(state);
+        khazad_bs_diffusion(state);
+        khazad_bs_add_key(state, p_key_schedule);
+    }
+    p_key_schedule += KHAZAD_BLOCK_SIZE;
+    khazad_bs_sbox_apply(state);
+    khazad_bs_add_key(state, p_key_schedule);
+}
+
+static void khazad_bs_decrypt_group(khazad_bs_state_t state, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE])
+{
+    uint_fast8_t    round;
+
+    p_key_schedule += KHAZAD_KEY_SCHEDULE_SIZE - KHAZAD_BLOCK_SIZE;
+    khazad_bs_add_key(state, p_key_schedule);
+    khazad_bs_sbox_apply(state);
+    for (round = 1u; round < KHAZAD_NUM_ROUNDS; ++round)
+    {
+        p_key_schedule -= KHAZAD_BLOCK_SIZE;
+        khazad_bs_add_key(state, p_key_schedule);
+        khazad_bs_diffusion(state);
+        khazad_bs_sbox_apply(state);
+    }
+    p_key_schedule -= KHAZAD_BLOCK_SIZE;
+    khazad_bs_add_key(state, p_key_schedule);
+}
+
+/*****************************************************************************
+ * Functions
+ ****************************************************************************/
+
+/* Bitsliced Khazad encryption (or decryption) of multiple blocks.
+ * p_blocks points to num_blocks 8-byte blocks, stored contiguously. They are
+ * encrypted/decrypted in-place.
+ * p_key_schedule is as for khazad_crypt().
+ */
+void khazad_bitslice_crypt(uint8_t * p_blocks, size_t num_blocks, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE])
+{
+    khazad_bs_state_t   state;
+    size_t              group_blocks;
+
+    while (num_blocks)
+    {
+        group_blocks = (num_blocks < KHAZAD_BITSLICE_GROUP) ? num_blocks : KHAZAD_BITSLICE_GROUP;
+        khazad_bs_load(state, p_blocks, group_blocks);
+        khazad_bs_crypt_group(state, p_key_schedule);
+        khazad_bs_store(p_blocks, group_blocks, state);
+        p_blocks += group_blocks * KHAZAD_BLOCK_SIZE;
+        num_blocks -= group_blocks;
+    }
+}
+
+/* Bitsliced Khazad decryption of multiple blocks.
+ * p_blocks points to num_blocks 8-byte blocks, stored contiguously. They are
+ * decrypted in-place.
+ * p_key_schedule is as for khazad_decrypt().
+ */
+void khazad_bitslice_decrypt(uint8_t * p_blocks, size_t num_blocks, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE])
+{
+    khazad_bs_state_t   state;
+    size_t              group_blocks;
+
+    while (num_blocks)
+    {
+        group_blocks = (num_blocks < KHAZAD_BITSLICE_GROUP) ? num_blocks : KHAZAD_BITSLICE_GROUP;
+        khazad_bs_load(state, p_blocks, group_blocks);
+        khazad_bs_decrypt_group(state, p_key_schedule);
+        khazad_bs_store(p_blocks, group_blocks, state);
+        p_blocks += group_blocks * KHAZAD_BLOCK_SIZE;
+        num_blocks -= group_blocks;
+    }
+}
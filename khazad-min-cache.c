@@ -0,0 +1,596 @@
+/*****************************************************************************
+ * khazad-min-cache.c
+ *
+ * Thread-safe cache of Khazad key schedules.
+ *
+ * Ids are hashed, and the hash picks a shard, then a bucket in the shard's
+ * hash table. Each entry holds an id, its key and the key schedule, and is
+ * never modified once it is linked into a bucket chain. Updates take the
+ * shard's lock, and link new entries into chains with release stores, so
+ * look-ups can walk the chains without a lock.
+ *
+ * Unlinked entries are freed once every look-up that might have found them
+ * has finished. Each shard has two counters of look-ups in progress, and an
+ * index of the one that new look-ups use. Unlinked entries are first put on a
+ * retired list. When the reclaim step finds the retired list non-empty and no
+ * earlier batch waiting, it moves the list to waiting and flips the index.
+ * Look-ups that started before the flip are counted in the old counter, and
+ * look-ups that start after it can't find the waiting entries, so the waiting
+ * entries are freed once the old counter is zero. The reclaim step never
+ * waits: it is done as part of each update, and just frees what it can.
+ *
+ * When a shard is full, the entry to evict is chosen by the CLOCK algorithm:
+ * look-ups set a referenced flag on the entry they find, and the clock hand
+ * sweeps the shard's entries, clearing flags, until it finds an entry whose
+ * flag is clear.
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Includes
+ ****************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "khazad-min-cache.h"
+#include "khazad-min-internal.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*****************************************************************************
+ * Defines
+ ****************************************************************************/
+
+#define KHAZAD_CACHE_DEFAULT_SHARDS 16u
+#define KHAZAD_CACHE_MAX_SHARDS     (1u << 16u)
+
+/* The shard is chosen from the high half of the hash, and the bucket from the
+ * low half. */
+#define KHAZAD_CACHE_SHARD_SHIFT    32u
+
+/*****************************************************************************
+ * Types
+ ****************************************************************************/
+
+typedef struct khazad_cache_entry
+{
+    KHAZAD_ALIGNED(KHAZAD_CACHE_LINE_SIZE) uint8_t key_schedule[KHAZAD_KEY_SCHEDULE_SIZE];
+    uint8_t                         key[KHAZAD_KEY_SIZE];
+    uint64_t                        id;
+    /* Next entry in the bucket chain. Read by look-ups without the lock. */
+    struct khazad_cache_entry     * p_next;
+    /* Next entry in the retired or waiting list, once unlinked. */
+    struct khazad_cache_entry     * p_retired_next;
+    /* Index in the shard's slots array, for the CLOCK algorithm. */
+    size_t                          slot;
+    /* Set by look-ups, cleared by the clock hand. */
+    uint8_t                         referenced;
+} khazad_cache_entry_t;
+
+typedef struct
+{
+    /* Written by look-ups. */
+    KHAZAD_ALIGNED(KHAZAD_CACHE_LINE_SIZE) unsigned long readers[2];
+    unsigned                        index;
+    uint64_t                        hits;
+    uint64_t                        misses;
+
+    /* Written by updates, with the lock held. */
+    KHAZAD_ALIGNED(KHAZAD_CACHE_LINE_SIZE) pthread_mutex_t lock;
+    khazad_cache_entry_t         ** p_buckets;
+    size_t                          bucket_mask;
+    khazad_cache_entry_t         ** p_slots;
+    size_t                          capacity;
+    size_t                          num_entries;
+    size_t                          hand;
+    /* Unlinked entries, not yet waiting for look-ups to finish. */
+    khazad_cache_entry_t          * p_retired;
+    /* Unlinked entries, waiting for look-ups counted in the counter not
+     * currently in use to finish. */
+    khazad_cache_entry_t          * p_waiting;
+    size_t                          num_retired;
+    uint64_t                        insertions;
+    uint64_t                        replacements;
+    uint64_t                        evictions;
+} khazad_cache_shard_t;
+
+struct khazad_cache
+{
+    khazad_cache_shard_t          * p_shards;
+    unsigned                        num_shards;
+};
+
+/*****************************************************************************
+ * Inline functions
+ ****************************************************************************/
+
+static inline khazad_cache_shard_t * khazad_cache_shard(khazad_cache_t * p_cache, uint64_t hash)
+{
+    return &p_cache->p_shards[(hash >> KHAZAD_CACHE_SHARD_SHIFT) & (p_cache->num_shards - 1u)];
+}
+
+/* Compare keys without an early exit, so the time taken doesn't depend on
+ * where they differ. */
+static inline bool khazad_cache_key_equal(const uint8_t * p_a, const uint8_t * p_b)
+{
+    uint8_t         diff = 0;
+    uint_fast8_t    i;
+
+    for (i = 0; i < KHAZAD_KEY_SIZE; ++i)
+    {
+        diff |= p_a[i] ^ p_b[i];
+    }
+    return diff == 0;
+}
+
+/* Start a look-up in a shard. The index is checked again after counting the
+ * look-up, so it is never counted in a counter that an update has already
+ * found to be zero after a flip. */
+static inline void khazad_cache_read_lock(khazad_cache_shard_t * p_shard, khazad_cache_guard_t * p_guard)
+{
+    unsigned    index;
+
+    for (;;)
+    {
+        index = __atomic_load_n(&p_shard->index, __ATOMIC_SEQ_CST);
+        __atomic_fetch_add(&p_shard->readers[index], 1u, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&p_shard->index, __ATOMIC_SEQ_CST) == index)
+            break;
+        __atomic_fetch_sub(&p_shard->readers[index], 1u, __ATOMIC_RELEASE);
+    }
+    p_guard->p_shard = p_shard;
+    p_guard->index = index;
+}
+
+static inline void khazad_cache_read_unlock(const khazad_cache_guard_t * p_guard)
+{
+    khazad_cache_shard_t  * p_shard = (khazad_cache_shard_t *)p_guard->p_shard;
+
+    __atomic_fetch_sub(&p_shard->readers[p_guard->index], 1u, __ATOMIC_RELEASE);
+}
+
+/* Find id in a shard, during a look-up. */
+static inline khazad_cache_entry_t * khazad_cache_find(const khazad_cache_shard_t * p_shard, uint64_t hash, uint64_t id)
+{
+    khazad_cache_entry_t  * p_entry;
+
+    p_entry = __atomic_load_n(&p_shard->p_buckets[hash & p_shard->bucket_mask], __ATOMIC_ACQUIRE);
+    while (p_entry != NULL && p_entry->id != id)
+    {
+        p_entry = __atomic_load_n(&p_entry->p_next, __ATOMIC_ACQUIRE);
+    }
+    return p_entry;
+}
+
+/* Mark an entry as recently used. The flag is only written if it is clear, so
+ * look-ups of a popular entry don't keep taking its cache line. */
+static inline void khazad_cache_touch(khazad_cache_entry_t * p_entry)
+{
+    if (!__atomic_load_n(&p_entry->referenced, __ATOMIC_RELAXED))
+        __atomic_store_n(&p_entry->referenced, 1u, __ATOMIC_RELAXED);
+}
+
+/*****************************************************************************
+ * Local functions
+ ****************************************************************************/
+
+static khazad_cache_entry_t * khazad_cache_entry_new(uint64_t id, const uint8_t p_key[KHAZAD_KEY_SIZE])
+{
+    khazad_cache_entry_t  * p_entry;
+
+    p_entry = (khazad_cache_entry_t *)khazad_aligned_alloc(sizeof(khazad_cache_entry_t));
+    if (p_entry == NULL)
+        return NULL;
+    khazad_key_schedule(p_entry->key_schedule, p_key);
+    memcpy(p_entry->key, p_key, KHAZAD_KEY_SIZE);
+    p_entry->id = id;
+    return p_entry;
+}
+
+/* Free an entry, first clearing it, so no key material is left in memory. */
+static void khazad_cache_entry_free(khazad_cache_entry_t * p_entry)
+{
+    khazad_wipe(p_entry, sizeof(*p_entry));
+    khazad_aligned_free(p_entry);
+}
+
+/* Free a retired or waiting list. Returns the number of entries freed. */
+static size_t khazad_cache_list_free(khazad_cache_entry_t * p_entry)
+{
+    khazad_cache_entry_t  * p_next;
+    size_t                  count = 0;
+
+    while (p_entry != NULL)
+    {
+        p_next = p_entry->p_retired_next;
+        khazad_cache_entry_free(p_entry);
+        p_entry = p_next;
+        ++count;
+    }
+    return count;
+}
+
+/* Find the link that points to id's entry in a shard, or the null link at the
+ * end of its bucket chain. The lock must be held. */
+static khazad_cache_entry_t ** khazad_cache_find_link(khazad_cache_shard_t * p_shard, uint64_t hash, uint64_t id)
+{
+    khazad_cache_entry_t ** p_link = &p_shard->p_buckets[hash & p_shard->bucket_mask];
+
+    while (*p_link != NULL && (*p_link)->id != id)
+    {
+        p_link = &(*p_link)->p_next;
+    }
+    return p_link;
+}
+
+/* Put an unlinked entry on the retired list. The lock must be held. */
+static void khazad_cache_retire(khazad_cache_shard_t * p_shard, khazad_cache_entry_t * p_entry)
+{
+    p_entry->p_retired_next = p_shard->p_retired;
+    p_shard->p_retired = p_entry;
+    ++p_shard->num_retired;
+}
+
+/* Unlink an entry from its bucket chain, and retire it. Look-ups in progress
+ * may still be walking through it, so its own link is left intact. The lock
+ * must be held. */
+static void khazad_cache_unlink(khazad_cache_shard_t * p_shard, khazad_cache_entry_t ** p_link)
+{
+    khazad_cache_entry_t  * p_entry = *p_link;
+
+    __atomic_store_n(p_link, p_entry->p_next, __ATOMIC_RELEASE);
+    khazad_cache_retire(p_shard, p_entry);
+}
+
+/* Free the waiting entries if the look-ups that might use them have finished,
+ * then start the wait for the retired entries if there are none waiting. This
+ * never blocks. The lock must be held. */
+static void khazad_cache_shard_reclaim(khazad_cache_shard_t * p_shard)
+{
+    unsigned                index = __atomic_load_n(&p_shard->index, __ATOMIC_RELAXED);
+    uint_fast8_t            i;
+
+    for (i = 0; i < 2u; ++i)
+    {
+        if (p_shard->p_waiting != NULL)
+        {
+            if (__atomic_load_n(&p_shard->readers[index ^ 1u], __ATOMIC_SEQ_CST) != 0)
+                return;
+            p_shard->num_retired -= khazad_cache_list_free(p_shard->p_waiting);
+            p_shard->p_waiting = NULL;
+        }
+        if (p_shard->p_retired == NULL)
+            return;
+        p_shard->p_waiting = p_shard->p_retired;
+        p_shard->p_retired = NULL;
+        index ^= 1u;
+        __atomic_store_n(&p_shard->index, index, __ATOMIC_SEQ_CST);
+    }
+}
+
+/* Choose an entry to evict, by the CLOCK algorithm. The shard must be full,
+ * and the lock held. */
+static khazad_cache_entry_t * khazad_cache_clock_victim(khazad_cache_shard_t * p_shard)
+{
+    khazad_cache_entry_t  * p_entry;
+
+    for (;;)
+    {
+        p_entry = p_shard->p_slots[p_shard->hand];
+        if (++p_shard->hand == p_shard->num_entries)
+            p_shard->hand = 0;
+        if (!__atomic_load_n(&p_entry->referenced, __ATOMIC_RELAXED))
+            return p_entry;
+        __atomic_store_n(&p_entry->referenced, 0, __ATOMIC_RELAXED);
+    }
+}
+
+/* Add a new entry for id, after a look-up missed. The key schedule is
+ * calculated before taking the lock. Another thread may have added the same
+ * entry meanwhile, in which case that one is used. */
+static const uint8_t * khazad_cache_insert(khazad_cache_shard_t * p_shard, uint64_t hash, uint64_t id, const uint8_t p_key[KHAZAD_KEY_SIZE], khazad_cache_guard_t * p_guard)
+{
+    khazad_cache_entry_t  * p_new;
+    khazad_cache_entry_t  * p_victim;
+    khazad_cache_entry_t  * p_entry;
+    khazad_cache_entry_t ** p_link;
+
+    p_new = khazad_cache_entry_new(id, p_key);
+    if (p_new == NULL)
+        return NULL;
+
+    pthread_mutex_lock(&p_shard->lock);
+    p_link = khazad_cache_find_link(p_shard, hash, id);
+    p_entry = *p_link;
+    if (p_entry != NULL && khazad_cache_key_equal(p_entry->key, p_key))
+    {
+        khazad_cache_entry_free(p_new);
+    }
+    else if (p_entry != NULL)
+    {
+        /* The key for id has changed. Swap in the new entry in the same
+         * place in the chain. */
+        p_new->p_next = p_entry->p_next;
+        p_new->slot = p_entry->slot;
+        p_shard->p_slots[p_new->slot] = p_new;
+        __atomic_store_n(p_link, p_new, __ATOMIC_RELEASE);
+        khazad_cache_retire(p_shard, p_entry);
+        ++p_shard->replacements;
+        p_entry = p_new;
+    }
+    else
+    {
+        if (p_shard->num_entries == p_shard->capacity)
+        {
+            p_victim = khazad_cache_clock_victim(p_shard);
+            p_new->slot = p_victim->slot;
+            khazad_cache_unlink(p_shard, khazad_cache_find_link(p_shard, khazad_mix_word(p_victim->id), p_victim->id));
+            ++p_shard->evictions;
+        }
+        else
+        {
+            p_new->slot = p_shard->num_entries++;
+        }
+        p_shard->p_slots[p_new->slot] = p_new;
+        /* The victim may have been in the same bucket, so the head is read
+         * after unlinking it. */
+        p_link = &p_shard->p_buckets[hash & p_shard->bucket_mask];
+        p_new->p_next = *p_link;
+        __atomic_store_n(p_link, p_new, __ATOMIC_RELEASE);
+        ++p_shard->insertions;
+        p_entry = p_new;
+    }
+    /* Start the look-up before releasing the lock, so the entry can't be
+     * freed before the caller is done with it. */
+    khazad_cache_read_lock(p_shard, p_guard);
+    khazad_cache_shard_reclaim(p_shard);
+    pthread_mutex_unlock(&p_shard->lock);
+    return p_entry->key_schedule;
+}
+
+/*****************************************************************************
+ * Functions
+ ****************************************************************************/
+
+/* Create a key schedule cache.
+ * max_memory is the most memory, in bytes, to use for cache entries and
+ * their tables. Entries that have been replaced or evicted, but are still in
+ * use by look-ups, are not counted.
+ * num_shards is the number of shards, rounded up to a power of 2, or 0 for a
+ * default.
+ * Returns NULL if memory can't be allocated, or max_memory is too small for
+ * at least one entry per shard.
+ */
+khazad_cache_t * khazad_cache_create(size_t max_memory, unsigned num_shards)
+{
+    khazad_cache_t        * p_cache;
+    khazad_cache_shard_t  * p_shard;
+    size_t                  capacity;
+    size_t                  num_buckets;
+    unsigned                i;
+
+    if (num_shards == 0)
+        num_shards = KHAZAD_CACHE_DEFAULT_SHARDS;
+    if (num_shards > KHAZAD_CACHE_MAX_SHARDS)
+        num_shards = KHAZAD_CACHE_MAX_SHARDS;
+    i = 1u;
+    while (i < num_shards)
+    {
+        i <<= 1u;
+    }
+    num_shards = i;
+
+    /* Each entry also takes a slot pointer, and up to one bucket pointer. */
+    capacity = max_memory / num_shards / (sizeof(khazad_cache_entry_t) + 2u * sizeof(khazad_cache_entry_t *));
+    if (capacity == 0)
+        return NULL;
+    /* The largest power of 2 not more than the capacity, so chains average
+     * between 1 and 2 entries when the shard is full. */
+    num_buckets = 1u;
+    while (num_buckets <= capacity / 2u)
+    {
+        num_buckets <<= 1u;
+    }
+
+    p_cache = (khazad_cache_t *)calloc(1u, sizeof(*p_cache));
+    if (p_cache == NULL)
+        return NULL;
+    p_cache->p_shards = (khazad_cache_shard_t *)khazad_aligned_alloc(num_shards * sizeof(khazad_cache_shard_t));
+    if (p_cache->p_shards == NULL)
+    {
+        free(p_cache);
+        return NULL;
+    }
+    for (i = 0; i < num_shards; ++i)
+    {
+        p_shard = &p_cache->p_shards[i];
+        p_shard->p_buckets = (khazad_cache_entry_t **)calloc(num_buckets, sizeof(khazad_cache_entry_t *));
+        p_shard->p_slots = (khazad_cache_entry_t **)calloc(capacity, sizeof(khazad_cache_entry_t *));
+        if (p_shard->p_buckets == NULL || p_shard->p_slots == NULL
+            || pthread_mutex_init(&p_shard->lock, NULL) != 0)
+        {
+            free(p_shard->p_buckets);
+            free(p_shard->p_slots);
+            p_cache->num_shards = i;
+            khazad_cache_destroy(p_cache);
+            return NULL;
+        }
+        p_shard->bucket_mask = num_buckets - 1u;
+        p_shard->capacity = capacity;
+    }
+    p_cache->num_shards = num_shards;
+    return p_cache;
+}
+
+/* Free a key schedule cache. No other thread may be using it, and no guards
+ * may still be held.
+ */
+void khazad_cache_destroy(khazad_cache_t * p_cache)
+{
+    khazad_cache_shard_t  * p_shard;
+    unsigned                i;
+    size_t                  slot;
+
+    if (p_cache == NULL)
+        return;
+    for (i = 0; i < p_cache->num_shards; ++i)
+    {
+        p_shard = &p_cache->p_shards[i];
+        for (slot = 0; slot < p_shard->num_entries; ++slot)
+        {
+            khazad_cache_entry_free(p_shard->p_slots[slot]);
+        }
+        khazad_cache_list_free(p_shard->p_retired);
+        khazad_cache_list_free(p_shard->p_waiting);
+        free(p_shard->p_buckets);
+        free(p_shard->p_slots);
+        pthread_mutex_destroy(&p_shard->lock);
+    }
+    khazad_aligned_free(p_cache->p_shards);
+    free(p_cache);
+}
+
+/* Get the key schedule for id, which is for the 16-byte key p_key.
+ * If id isn't cached, the key schedule is calculated and added, evicting an
+ * entry if the shard is full. If id is cached, but for a different key (e.g.
+ * the key has been rotated), the entry is replaced. Look-ups already using
+ * the old entry can keep using it until they release their guards.
+ * The key schedule is as from khazad_key_schedule(). It remains valid until
+ * khazad_cache_release() is called with p_guard, which must be done once for
+ * every successful call.
+ * Returns NULL, with no guard to release, if memory can't be allocated.
+ */
+const uint8_t * khazad_cache_get(khazad_cache_t * p_cache, uint64_t id, const uint8_t p_key[KHAZAD_KEY_SIZE], khazad_cache_guard_t * p_guard)
+{
+    uint64_t                hash = khazad_mix_word(id);
+    khazad_cache_shard_t  * p_shard = khazad_cache_shard(p_cache, hash);
+    khazad_cache_entry_t  * p_entry;
+
+    khazad_cache_read_lock(p_shard, p_guard);
+    p_entry = khazad_cache_find(p_shard, hash, id);
+    if (p_entry != NULL && khazad_cache_key_equal(p_entry->key, p_key))
+    {
+        khazad_cache_touch(p_entry);
+        __atomic_fetch_add(&p_shard->hits, 1u, __ATOMIC_RELAXED);
+        return p_entry->key_schedule;
+    }
+    khazad_cache_read_unlock(p_guard);
+    __atomic_fetch_add(&p_shard->misses, 1u, __ATOMIC_RELAXED);
+    return khazad_cache_insert(p_shard, hash, id, p_key, p_guard);
+}
+
+/* Get the key schedule for the 16-byte key p_key, using a hash of the key as
+ * its id. Otherwise as for khazad_cache_get(). A cache should be used either
+ * with ids, or with keys, but not both.
+ */
+const uint8_t * khazad_cache_get_by_key(khazad_cache_t * p_cache, const uint8_t p_key[KHAZAD_KEY_SIZE], khazad_cache_guard_t * p_guard)
+{
+    uint64_t    id;
+
+    id = khazad_mix_word(khazad_load_word(p_key) ^ khazad_mix_word(khazad_load_word(p_key + KHAZAD_BLOCK_SIZE)));
+    return khazad_cache_get(p_cache, id, p_key, p_guard);
+}
+
+/* Look up the key schedule for id, without adding it if it isn't cached.
+ * Returns NULL, with no guard to release, if it isn't cached. Otherwise as for
+ * khazad_cache_get().
+ */
+const uint8_t * khazad_cache_lookup(khazad_cache_t * p_cache, uint64_t id, khazad_cache_guard_t * p_guard)
+{
+    uint64_t                hash = khazad_mix_word(id);
+    khazad_cache_shard_t  * p_shard = khazad_cache_shard(p_cache, hash);
+    khazad_cache_entry_t  * p_entry;
+
+    khazad_cache_read_lock(p_shard, p_guard);
+    p_entry = khazad_cache_find(p_shard, hash, id);
+    if (p_entry != NULL)
+    {
+        khazad_cache_touch(p_entry);
+        __atomic_fetch_add(&p_shard->hits, 1u, __ATOMIC_RELAXED);
+        return p_entry->key_schedule;
+    }
+    khazad_cache_read_unlock(p_guard);
+    __atomic_fetch_add(&p_shard->misses, 1u, __ATOMIC_RELAXED);
+    return NULL;
+}
+
+/* Release the guard of a key schedule returned by a look-up. The key schedule
+ * must not be used after this.
+ */
+void khazad_cache_release(khazad_cache_guard_t * p_guard)
+{
+    khazad_cache_read_unlock(p_guard);
+    p_guard->p_shard = NULL;
+}
+
+/* Remove id from the cache, if it is cached. Look-ups already using its key
+ * schedule can keep using it until they release their guards.
+ */
+void khazad_cache_remove(khazad_cache_t * p_cache, uint64_t id)
+{
+    uint64_t                hash = khazad_mix_word(id);
+    khazad_cache_shard_t  * p_shard = khazad_cache_shard(p_cache, hash);
+    khazad_cache_entry_t  * p_entry;
+    khazad_cache_entry_t  * p_last;
+    khazad_cache_entry_t ** p_link;
+
+    pthread_mutex_lock(&p_shard->lock);
+    p_link = khazad_cache_find_link(p_shard, hash, id);
+    p_entry = *p_link;
+    if (p_entry != NULL)
+    {
+        khazad_cache_unlink(p_shard, p_link);
+        /* Fill the slot with the last entry, to keep the slots contiguous. */
+        p_last = p_shard->p_slots[--p_shard->num_entries];
+        p_last->slot = p_entry->slot;
+        p_shard->p_slots[p_last->slot] = p_last;
+        if (p_shard->hand >= p_shard->num_entries)
+            p_shard->hand = 0;
+    }
+    khazad_cache_shard_reclaim(p_shard);
+    pthread_mutex_unlock(&p_shard->lock);
+}
+
+/* Reclaim the memory of replaced, evicted and removed entries that are no
+ * longer in use. This is also done as part of updates, so it is only needed
+ * to free memory sooner when there are no updates.
+ */
+void khazad_cache_reclaim(khazad_cache_t * p_cache)
+{
+    khazad_cache_shard_t  * p_shard;
+    unsigned                i;
+
+    for (i = 0; i < p_cache->num_shards; ++i)
+    {
+        p_shard = &p_cache->p_shards[i];
+        pthread_mutex_lock(&p_shard->lock);
+        khazad_cache_shard_reclaim(p_shard);
+        pthread_mutex_unlock(&p_shard->lock);
+    }
+}
+
+/* Get the cache statistics.
+ */
+void khazad_cache_get_stats(khazad_cache_t * p_cache, khazad_cache_stats_t * p_stats)
+{
+    khazad_cache_shard_t  * p_shard;
+    unsigned                i;
+
+    memset(p_stats, 0, sizeof(*p_stats));
+    for (i = 0; i < p_cache->num_shards; ++i)
+    {
+        p_shard = &p_cache->p_shards[i];
+        p_stats->hits += __atomic_load_n(&p_shard->hits, __ATOMIC_RELAXED);
+        p_stats->misses += __atomic_load_n(&p_shard->misses, __ATOMIC_RELAXED);
+        pthread_mutex_lock(&p_shard->lock);
+        p_stats->insertions += p_shard->insertions;
+        p_stats->replacements += p_shard->replacements;
+        p_stats->evictions += p_shard->evictions;
+        p_stats->num_entries += p_shard->num_entries;
+        p_stats->capacity += p_shard->capacity;
+        p_stats->num_retired += p_shard->num_retired;
+        pthread_mutex_unlock(&p_shard->lock);
+    }
+}
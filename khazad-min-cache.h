@@ -0,0 +1,124 @@
+/*****************************************************************************
+ * khazad-min-cache.h
+ *
+ * Thread-safe cache of Khazad key schedules.
+ *
+ * The cache maps a 64-bit id (such as a device id), or the key itself, to the
+ * key schedule of a key. Cached key schedules are never modified, so they can
+ * be used while other threads replace or evict them: each look-up returns a
+ * guard, and the key schedule remains valid until the guard is released.
+ *
+ * The cache is split into shards, each with its own lock for updates. Look-ups
+ * don't take any lock. Memory of replaced and evicted entries is reclaimed
+ * once no look-up that might still use it is in progress, in the style of
+ * sleepable RCU (SRCU): each shard counts the look-ups in progress in one of
+ * two counters, and updates switch between them.
+ *
+ * This needs POSIX threads, and is only built if they are available.
+ ****************************************************************************/
+
+#ifndef KHAZAD_MIN_CACHE_H
+#define KHAZAD_MIN_CACHE_H
+
+/*****************************************************************************
+ * Includes
+ ****************************************************************************/
+
+#include "khazad-min.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*****************************************************************************
+ * Types
+ ****************************************************************************/
+
+typedef struct khazad_cache khazad_cache_t;
+
+/* Guard for a key schedule returned by a look-up. The members are private. */
+typedef struct
+{
+    void      * p_shard;
+    unsigned    index;
+} khazad_cache_guard_t;
+
+/* Cache statistics, summed over all the shards. */
+typedef struct
+{
+    uint64_t    hits;
+    uint64_t    misses;
+    uint64_t    insertions;
+    uint64_t    replacements;
+    uint64_t    evictions;
+    /* Entries in the cache, and the most there can be. */
+    size_t      num_entries;
+    size_t      capacity;
+    /* Replaced, evicted or removed entries not yet reclaimed. */
+    size_t      num_retired;
+} khazad_cache_stats_t;
+
+/*****************************************************************************
+ * Function prototypes
+ ****************************************************************************/
+
+/* Create a key schedule cache.
+ * max_memory is the most memory, in bytes, to use for cache entries and
+ * their tables. Entries that have been replaced or evicted, but are still in
+ * use by look-ups, are not counted.
+ * num_shards is the number of shards, rounded up to a power of 2, or 0 for a
+ * default.
+ * Returns NULL if memory can't be allocated, or max_memory is too small for
+ * at least one entry per shard.
+ */
+khazad_cache_t * khazad_cache_create(size_t max_memory, unsigned num_shards);
+
+/* Free a key schedule cache. No other thread may be using it, and no guards
+ * may still be held.
+ */
+void khazad_cache_destroy(khazad_cache_t * p_cache);
+
+/* Get the key schedule for id, which is for the 16-byte key p_key.
+ * If id isn't cached, the key schedule is calculated and added, evicting an
+ * entry if the shard is full. If id is cached, but for a different key (e.g.
+ * the key has been rotated), the entry is replaced. Look-ups already using
+ * the old entry can keep using it until they release their guards.
+ * The key schedule is as from khazad_key_schedule(). It remains valid until
+ * khazad_cache_release() is called with p_guard, which must be done once for
+ * every successful call.
+ * Returns NULL, with no guard to release, if memory can't be allocated.
+ */
+const uint8_t * khazad_cache_get(khazad_cache_t * p_cache, uint64_t id, const uint8_t p_key[KHAZAD_KEY_SIZE], khazad_cache_guard_t * p_guard);
+
+/* Get the key schedule for the 16-byte key p_key, using a hash of the key as
+ * its id. Otherwise as for khazad_cache_get(). A cache should be used either
+ * with ids, or with keys, but not both.
+ */
+const uint8_t * khazad_cache_get_by_key(khazad_cache_t * p_cache, const uint8_t p_key[KHAZAD_KEY_SIZE], khazad_cache_guard_t * p_guard);
+
+/* Look up the key schedule for id, without adding it if it isn't cached.
+ * Returns NULL, with no guard to release, if it isn't cached. Otherwise as for
+ * khazad_cache_get().
+ */
+const uint8_t * khazad_cache_lookup(khazad_cache_t * p_cache, uint64_t id, khazad_cache_guard_t * p_guard);
+
+/* Release the guard of a key schedule returned by a look-up. The key schedule
+ * must not be used after this.
+ */
+void khazad_cache_release(khazad_cache_guard_t * p_guard);
+
+/* Remove id from the cache, if it is cached. Look-ups already using its key
+ * schedule can keep using it until they release their guards.
+ */
+void khazad_cache_remove(khazad_cache_t * p_cache, uint64_t id);
+
+/* Reclaim the memory of replaced, evicted and removed entries that are no
+ * longer in use. This is also done as part of updates, so it is only needed
+ * to free memory sooner when there are no updates.
+ */
+void khazad_cache_reclaim(khazad_cache_t * p_cache);
+
+/* Get the cache statistics.
+ */
+void khazad_cache_get_stats(khazad_cache_t * p_cache, khazad_cache_stats_t * p_stats);
+
+#endif /* !defined(KHAZAD_MIN_CACHE_H) */
@@ -0,0 +1,116 @@
+/*****************************************************************************
+ * khazad-min-ctx.c
+ *
+ * Khazad key contexts.
+ *
+ * A key context holds the key schedule for one key, and optionally the
+ * decryption key schedule too, in a cache-line-aligned structure. The key
+ * schedules are each 72 bytes, so the encryption key schedule alone takes
+ * two 64-byte cache lines, and both together (144 bytes) take three.
+ * The structure is allocated by khazad_ctx_create(), so it can stay private
+ * and the alignment doesn't depend on the caller's compiler.
+ *
+ * Decryption with the decryption key schedule uses the common crypt kernel,
+ * which avoids applying the diffusion layer to the round keys on every call,
+ * as khazad_decrypt_blocks() must.
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Includes
+ ****************************************************************************/
+
+#include "khazad-min-ctx.h"
+#include "khazad-min-internal.h"
+
+/*****************************************************************************
+ * Types
+ ****************************************************************************/
+
+struct khazad_ctx
+{
+    /* Key schedule for khazad_crypt(), stored in the key schedule byte order,
+     * so it can be passed to the functions that take a key schedule. */
+    KHAZAD_ALIGNED(KHAZAD_CACHE_LINE_SIZE) uint64_t encrypt_round_keys[KHAZAD_NUM_ROUNDS + 1u];
+    /* Decryption key schedule for khazad_crypt(), if KHAZAD_CTX_DECRYPT_KEYS
+     * is set. */
+    uint64_t    decrypt_round_keys[KHAZAD_NUM_ROUNDS + 1u];
+    unsigned    flags;
+};
+
+/*****************************************************************************
+ * Inline functions
+ ****************************************************************************/
+
+static inline uint8_t * khazad_ctx_encrypt_key_schedule(khazad_ctx_t * p_ctx)
+{
+    return (uint8_t *)p_ctx->encrypt_round_keys;
+}
+
+static inline uint8_t * khazad_ctx_decrypt_key_schedule(khazad_ctx_t * p_ctx)
+{
+    return (uint8_t *)p_ctx->decrypt_round_keys;
+}
+
+/*****************************************************************************
+ * Functions
+ ****************************************************************************/
+
+/* Create a key context for the Khazad key p_key.
+ * If flags includes KHAZAD_CTX_DECRYPT_KEYS, the decryption key schedule is
+ * calculated too, which makes khazad_ctx_decrypt_blocks() a little faster, at
+ * the cost of the extra key set-up time and memory.
+ * Returns NULL if memory can't be allocated.
+ */
+khazad_ctx_t * khazad_ctx_create(const uint8_t p_key[KHAZAD_KEY_SIZE], unsigned flags)
+{
+    khazad_ctx_t  * p_ctx;
+
+    p_ctx = (khazad_ctx_t *)khazad_aligned_alloc(sizeof(khazad_ctx_t));
+    if (p_ctx == NULL)
+        return NULL;
+    p_ctx->flags = flags;
+    khazad_ctx_rekey(p_ctx, p_key);
+    return p_ctx;
+}
+
+/* Change the key of a key context, keeping its flags.
+ */
+void khazad_ctx_rekey(khazad_ctx_t * p_ctx, const uint8_t p_key[KHAZAD_KEY_SIZE])
+{
+    khazad_key_schedule(khazad_ctx_encrypt_key_schedule(p_ctx), p_key);
+    if (p_ctx->flags & KHAZAD_CTX_DECRYPT_KEYS)
+    {
+        khazad_decrypt_key_schedule_from_encrypt(khazad_ctx_decrypt_key_schedule(p_ctx),
+                                                 khazad_ctx_encrypt_key_schedule(p_ctx));
+    }
+}
+
+/* Clear a key context, so no key material is left in memory, and free it.
+ * p_ctx may be NULL.
+ */
+void khazad_ctx_destroy(khazad_ctx_t * p_ctx)
+{
+    if (p_ctx == NULL)
+        return;
+    khazad_wipe(p_ctx, sizeof(*p_ctx));
+    khazad_aligned_free(p_ctx);
+}
+
+/* Khazad encryption of multiple blocks with a key context, as for
+ * khazad_crypt_blocks().
+ */
+void khazad_ctx_crypt_blocks(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const khazad_ctx_t * p_ctx)
+{
+    khazad_crypt_blocks(p_dst, p_src, num_blocks, (const uint8_t *)p_ctx->encrypt_round_keys);
+}
+
+/* Khazad decryption of multiple blocks with a key context, as for
+ * khazad_decrypt_blocks().
+ */
+void khazad_ctx_decrypt_blocks(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const khazad_ctx_t * p_ctx)
+{
+    if (p_ctx->flags & KHAZAD_CTX_DECRYPT_KEYS)
+        khazad_crypt_blocks(p_dst, p_src, num_blocks, (const uint8_t *)p_ctx->decrypt_round_keys);
+    else
+        khazad_decrypt_blocks(p_dst, p_src, num_blocks, (const uint8_t *)p_ctx->encrypt_round_keys);
+}
@@ -0,0 +1,69 @@
+/*****************************************************************************
+ * khazad-min-ctx.h
+ *
+ * Khazad key contexts.
+ *
+ * A key context holds the key schedule for one key as 64-bit round keys, and
+ * optionally the decryption key schedule too. It is allocated aligned to
+ * KHAZAD_CACHE_LINE_SIZE, so its round keys can be loaded as aligned words
+ * and start on their own cache line. The structure is private; use the
+ * khazad_ctx_*() functions.
+ ****************************************************************************/
+
+#ifndef KHAZAD_MIN_CTX_H
+#define KHAZAD_MIN_CTX_H
+
+/*****************************************************************************
+ * Includes
+ ****************************************************************************/
+
+#include "khazad-min.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*****************************************************************************
+ * Defines
+ ****************************************************************************/
+
+/* Flags for khazad_ctx_create(). */
+#define KHAZAD_CTX_DECRYPT_KEYS     0x01u
+
+/*****************************************************************************
+ * Types
+ ****************************************************************************/
+
+typedef struct khazad_ctx khazad_ctx_t;
+
+/*****************************************************************************
+ * Function prototypes
+ ****************************************************************************/
+
+/* Create a key context for the Khazad key p_key.
+ * If flags includes KHAZAD_CTX_DECRYPT_KEYS, the decryption key schedule is
+ * calculated too, which makes khazad_ctx_decrypt_blocks() a little faster, at
+ * the cost of the extra key set-up time and memory.
+ * Returns NULL if memory can't be allocated.
+ */
+khazad_ctx_t * khazad_ctx_create(const uint8_t p_key[KHAZAD_KEY_SIZE], unsigned flags);
+
+/* Change the key of a key context, keeping its flags.
+ */
+void khazad_ctx_rekey(khazad_ctx_t * p_ctx, const uint8_t p_key[KHAZAD_KEY_SIZE]);
+
+/* Clear a key context, so no key material is left in memory, and free it.
+ * p_ctx may be NULL.
+ */
+void khazad_ctx_destroy(khazad_ctx_t * p_ctx);
+
+/* Khazad encryption of multiple blocks with a key context, as for
+ * khazad_crypt_blocks().
+ */
+void khazad_ctx_crypt_blocks(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const khazad_ctx_t * p_ctx);
+
+/* Khazad decryption of multiple blocks with a key context, as for
+ * khazad_decrypt_blocks().
+ */
+void khazad_ctx_decrypt_blocks(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const khazad_ctx_t * p_ctx);
+
+#endif /* !defined(KHAZAD_MIN_CTX_H) */
@@ -0,0 +1,289 @@
+/*****************************************************************************
+ * khazad-min-dispatch.c
+ *
+ * Runtime selection of the Khazad crypt kernel.
+ *
+ * When the x86 SIMD kernels are built, the portable implementations in
+ * khazad-min.c are renamed to khazad_scalar_*(), and this file provides the
+ * public multi-block and keyed block functions, and
+ * khazad_key_schedule_multi(). They call the best kernel that the CPU
+ * supports, chosen once, at library load time (or on first use, if that comes
+ * first).
+ *
+ * khazad_crypt(), khazad_decrypt() and the iterated functions are not
+ * dispatched. For one block, a SIMD kernel spends more on filling a register
+ * group than it saves, so the scalar code in khazad-min.c is faster.
+ *
+ * The KHAZAD_KERNEL environment variable can name a kernel to use instead,
+ * e.g. for benchmarking. It is ignored if the kernel isn't built or the CPU
+ * doesn't support it.
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Includes
+ ****************************************************************************/
+
+#include "khazad-min.h"
+#include "khazad-min-internal.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef ENABLE_X86_KERNELS
+
+/*****************************************************************************
+ * Defines
+ ****************************************************************************/
+
+#define KHAZAD_KERNEL_ENV           "KHAZAD_KERNEL"
+
+/*****************************************************************************
+ * Types
+ ****************************************************************************/
+
+typedef void (*khazad_blocks_func_t)(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE]);
+
+typedef void (*khazad_key_schedule_multi_func_t)(uint8_t * p_key_schedules, const uint8_t * p_keys, size_t num_keys);
+typedef void (*khazad_keyed_blocks_func_t)(const khazad_keyed_block_t * p_blocks, size_t num_blocks);
+
+typedef struct
+{
+    const char                        * name;
+    bool                             (* is_supported)(void);
+    bool                                auto_select;
+    khazad_blocks_func_t                crypt_blocks;
+    khazad_blocks_func_t                decrypt_blocks;
+    khazad_key_schedule_multi_func_t    key_schedule_multi;
+    khazad_keyed_blocks_func_t          crypt_keyed_blocks;
+    khazad_keyed_blocks_func_t          decrypt_keyed_blocks;
+} khazad_kernel_t;
+
+/*****************************************************************************
+ * Local function prototypes
+ ****************************************************************************/
+
+static bool khazad_cpu_has_any(void);
+static bool khazad_cpu_has_ssse3(void);
+static bool khazad_cpu_has_avx2(void);
+#ifdef ENABLE_X86_AVX512_KERNEL
+static bool khazad_cpu_has_avx512(void);
+#endif
+
+/*****************************************************************************
+ * Tables
+ ****************************************************************************/
+
+/* In order of preference, for automatic selection. The last entry is always
+ * supported. avx2-gather is only used if it is named in KHAZAD_KERNEL, since
+ * it is not constant-time; it uses the AVX2 shuffle kernel's functions for key
+ * schedules and keyed blocks. avx512 uses the AVX2 kernel's keyed block
+ * functions on 32-bit x86. */
+static const khazad_kernel_t khazad_kernels[] =
+{
+#ifdef ENABLE_X86_AVX512_KERNEL
+    { "avx512", khazad_cpu_has_avx512, true,
+      khazad_avx512_crypt_blocks, khazad_avx512_decrypt_blocks,
+      khazad_avx512_key_schedule_multi,
+#if defined(__x86_64__)
+      khazad_avx512_crypt_keyed_blocks, khazad_avx512_decrypt_keyed_blocks },
+#else
+      khazad_avx2_crypt_keyed_blocks, khazad_avx2_decrypt_keyed_blocks },
+#endif
+#endif
+    { "avx2", khazad_cpu_has_avx2, true,
+      khazad_avx2_crypt_blocks, khazad_avx2_decrypt_blocks,
+      khazad_avx2_key_schedule_multi,
+      khazad_avx2_crypt_keyed_blocks, khazad_avx2_decrypt_keyed_blocks },
+    { "avx2-gather", khazad_cpu_has_avx2, false,
+      khazad_avx2_gather_crypt_blocks, khazad_avx2_gather_decrypt_blocks,
+      khazad_avx2_key_schedule_multi,
+      khazad_avx2_crypt_keyed_blocks, khazad_avx2_decrypt_keyed_blocks },
+    { "ssse3", khazad_cpu_has_ssse3, true,
+      khazad_ssse3_crypt_blocks, khazad_ssse3_decrypt_blocks,
+      khazad_ssse3_key_schedule_multi,
+      khazad_ssse3_crypt_keyed_blocks, khazad_ssse3_decrypt_keyed_blocks },
+    { "scalar", khazad_cpu_has_any, true,
+      khazad_scalar_crypt_blocks, khazad_scalar_decrypt_blocks,
+      khazad_scalar_key_schedule_multi,
+      khazad_scalar_crypt_keyed_blocks, khazad_scalar_decrypt_keyed_blocks },
+};
+
+#define KHAZAD_NUM_KERNELS          (sizeof(khazad_kernels) / sizeof(khazad_kernels[0]))
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+
+/* The selected kernel. It is set at load time by a constructor, but callers
+ * from other constructors may get here first, so it is also set on first use.
+ * Every thread selects the same kernel, so a racing store is harmless; atomic
+ * access just keeps it well-defined. */
+static const khazad_kernel_t * p_khazad_kernel;
+
+/*****************************************************************************
+ * Local functions
+ ****************************************************************************/
+
+static bool khazad_cpu_has_any(void)
+{
+    return true;
+}
+
+static bool khazad_cpu_has_ssse3(void)
+{
+    return __builtin_cpu_supports("ssse3");
+}
+
+static bool khazad_cpu_has_avx2(void)
+{
+    return __builtin_cpu_supports("avx2");
+}
+
+#ifdef ENABLE_X86_AVX512_KERNEL
+
+static bool khazad_cpu_has_avx512(void)
+{
+    return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")
+        && __builtin_cpu_supports("avx512vbmi") && __builtin_cpu_supports("gfni");
+}
+
+#endif /* ENABLE_X86_AVX512_KERNEL */
+
+static const khazad_kernel_t * khazad_kernel_select(void)
+{
+    const char    * p_env;
+    size_t          i;
+
+    __builtin_cpu_init();
+
+    p_env = getenv(KHAZAD_KERNEL_ENV);
+    if (p_env != NULL)
+    {
+        for (i = 0; i < KHAZAD_NUM_KERNELS; ++i)
+        {
+            if (strcmp(p_env, khazad_kernels[i].name) == 0 && khazad_kernels[i].is_supported())
+                return &khazad_kernels[i];
+        }
+    }
+    for (i = 0; i < KHAZAD_NUM_KERNELS; ++i)
+    {
+        if (khazad_kernels[i].auto_select && khazad_kernels[i].is_supported())
+            break;
+    }
+    return &khazad_kernels[i];
+}
+
+static const khazad_kernel_t * khazad_kernel(void)
+{
+    const khazad_kernel_t * p_kernel = __atomic_load_n(&p_khazad_kernel, __ATOMIC_ACQUIRE);
+
+    if (p_kernel == NULL)
+    {
+        p_kernel = khazad_kernel_select();
+        __atomic_store_n(&p_khazad_kernel, p_kernel, __ATOMIC_RELEASE);
+    }
+    return p_kernel;
+}
+
+__attribute__((constructor))
+static void khazad_kernel_init(void)
+{
+    (void)khazad_kernel();
+}
+
+/*****************************************************************************
+ * Functions
+ ****************************************************************************/
+
+/* Khazad encryption and decryption of multiple blocks.
+ * p_src points to num_blocks 8-byte blocks, stored contiguously, and the
+ * result is written to p_dst. p_dst may equal p_src, but the buffers must not
+ * otherwise overlap.
+ * p_key_schedule is as for khazad_crypt().
+ * The word cores (T-table and SWAR) process up to 4 independent blocks
+ * together, so their rounds overlap; the byte core processes one block at a
+ * time. With the x86 SIMD kernels, the kernel selected at run time (see
+ * khazad_kernel_name()) is used instead, with several blocks per register.
+ */
+void khazad_crypt_blocks(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE])
+{
+    khazad_kernel()->crypt_blocks(p_dst, p_src, num_blocks, p_key_schedule);
+}
+
+/* Khazad decryption of multiple blocks.
+ * p_src points to num_blocks 8-byte blocks of encrypted data, stored
+ * contiguously, and the result is written to p_dst. p_dst may equal p_src, but
+ * the buffers must not otherwise overlap.
+ * p_key_schedule is as for khazad_decrypt(), calculated with
+ * khazad_key_schedule().
+ */
+void khazad_decrypt_blocks(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE])
+{
+    khazad_kernel()->decrypt_blocks(p_dst, p_src, num_blocks, p_key_schedule);
+}
+
+/* Calculate the full key schedules for Khazad encryption (or decryption) of
+ * several keys.
+ * p_keys points to num_keys 16-byte keys, stored contiguously, and
+ * p_key_schedules to a buffer for num_keys 72-byte key schedules, in the same
+ * format as from khazad_key_schedule().
+ * The word cores process up to 4 keys together, so their rounds overlap,
+ * which is faster than separate calls of khazad_key_schedule() when there are
+ * many keys to set up; the byte core calculates one key schedule at a time.
+ * With the x86 SIMD kernels, the kernel selected at run time is used instead,
+ * with several keys per register.
+ */
+void khazad_key_schedule_multi(uint8_t * p_key_schedules, const uint8_t * p_keys, size_t num_keys)
+{
+    khazad_kernel()->key_schedule_multi(p_key_schedules, p_keys, num_keys);
+}
+
+/* Khazad encryption and decryption of multiple blocks, each with its own key
+ * schedule.
+ * p_blocks points to an array of num_blocks entries, each giving a block to
+ * encrypt/decrypt in-place and the key schedule to use for it, as for
+ * khazad_crypt(). The blocks must not overlap, but may share key schedules.
+ * The word cores process up to 4 blocks with different keys together, so
+ * their rounds overlap, which is faster than separate calls of khazad_crypt()
+ * when there are many blocks with few per key; the byte core processes one
+ * block at a time. With the x86 SIMD kernels, the kernel selected at run time
+ * is used instead, with several blocks per register.
+ */
+void khazad_crypt_keyed_blocks(const khazad_keyed_block_t * p_blocks, size_t num_blocks)
+{
+    khazad_kernel()->crypt_keyed_blocks(p_blocks, num_blocks);
+}
+
+/* Khazad decryption of multiple blocks, each with its own key schedule.
+ * p_blocks is as for khazad_crypt_keyed_blocks(), but with key schedules as
+ * for khazad_decrypt(), calculated with khazad_key_schedule().
+ */
+void khazad_decrypt_keyed_blocks(const khazad_keyed_block_t * p_blocks, size_t num_blocks)
+{
+    khazad_kernel()->decrypt_keyed_blocks(p_blocks, num_blocks);
+}
+
+/* Get the name of the kernel used by khazad_crypt_blocks(),
+ * khazad_decrypt_blocks(), the keyed block functions and
+ * khazad_key_schedule_multi(): "scalar", "ssse3", "avx2", "avx2-gather" or
+ * "avx512".
+ */
+const char * khazad_kernel_name(void)
+{
+    return khazad_kernel()->name;
+}
+
+#else /* ENABLE_X86_KERNELS */
+
+/* Get the name of the kernel used by khazad_crypt_blocks(),
+ * khazad_decrypt_blocks(), the keyed block functions and
+ * khazad_key_schedule_multi(). Without the x86 SIMD kernels, it is always
+ * "scalar".
+ */
+const char * khazad_kernel_name(void)
+{
+    return "scalar";
+}
+
+#endif /* ENABLE_X86_KERNELS */
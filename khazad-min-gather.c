@@ -0,0 +1,202 @@
+/*****************************************************************************
+ * khazad-min-gather.c
+ *
+ * Khazad encryption and decryption of multiple blocks with AVX2 gathers into
+ * the 64-bit T-tables, 4 blocks per register.
+ *
+ * Each round is the same combined S-box and diffusion look-up as
+ * ENABLE_T_TABLE in khazad-min.c, but with one vpgatherqq per byte position
+ * fetching that table entry for 4 blocks at once. The tables are the ones in
+ * khazad-min.c, declared in khazad-min-internal.h. Unlike the shuffle kernels,
+ * this uses memory look-ups indexed by secret data, so it is not
+ * constant-time on CPUs with data caches.
+ *
+ * This file must be compiled with -mavx2.
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Includes
+ ****************************************************************************/
+
+#include "khazad-min.h"
+#include "khazad-min-internal.h"
+
+#include <string.h>
+#include <immintrin.h>
+
+/*****************************************************************************
+ * Defines
+ ****************************************************************************/
+
+#define KHAZAD_GATHER_BLOCKS        4u
+/* Two registers are processed together, so one's gathers can overlap the
+ * other's XORs. */
+#define KHAZAD_GATHER_STEP_BLOCKS   (2u * KHAZAD_GATHER_BLOCKS)
+#define KHAZAD_GATHER_BYTES         (KHAZAD_GATHER_BLOCKS * KHAZAD_BLOCK_SIZE)
+
+/*****************************************************************************
+ * Inline functions
+ ****************************************************************************/
+
+static inline __m256i khazad_gather_lookup(__m256i a, uint_fast8_t i, __m256i byte_mask)
+{
+    __m256i index = _mm256_and_si256(_mm256_srli_epi64(a, (int)(i * 8u)), byte_mask);
+
+    return _mm256_i64gather_epi64((const long long *)khazad_t_table[i], index, 8);
+}
+
+/* S-box layer then diffusion layer. */
+static inline __m256i khazad_gather_round(__m256i a, __m256i byte_mask)
+{
+    __m256i     sum;
+
+    sum = _mm256_xor_si256(khazad_gather_lookup(a, 0, byte_mask), khazad_gather_lookup(a, 1u, byte_mask));
+    sum = _mm256_xor_si256(sum, _mm256_xor_si256(khazad_gather_lookup(a, 2u, byte_mask), khazad_gather_lookup(a, 3u, byte_mask)));
+    sum = _mm256_xor_si256(sum, _mm256_xor_si256(khazad_gather_lookup(a, 4u, byte_mask), khazad_gather_lookup(a, 5u, byte_mask)));
+    return _mm256_xor_si256(sum, _mm256_xor_si256(khazad_gather_lookup(a, 6u, byte_mask), khazad_gather_lookup(a, 7u, byte_mask)));
+}
+
+/* S-box layer only. Byte i of table i is the S-box output, as for
+ * khazad_sbox_word() in khazad-min.c. */
+static inline __m256i khazad_gather_sbox(__m256i a, __m256i byte_mask)
+{
+    __m256i         result = _mm256_setzero_si256();
+    uint_fast8_t    i;
+
+    for (i = 0; i < KHAZAD_BLOCK_SIZE; ++i)
+    {
+        result = _mm256_or_si256(result,
+                                 _mm256_and_si256(khazad_gather_lookup(a, i, byte_mask),
+                                                  _mm256_slli_epi64(byte_mask, (int)(i * 8u))));
+    }
+    return result;
+}
+
+static inline __m256i khazad_gather_key(uint64_t key)
+{
+    return _mm256_set1_epi64x((long long)key);
+}
+
+/*****************************************************************************
+ * Local functions
+ ****************************************************************************/
+
+/* Scalar diffusion layer, for the decryption round keys. The S-box is an
+ * involution, so look-ups of S(S(k)) in the T-tables give just H(k). */
+static uint64_t khazad_gather_diffusion_word(uint64_t a)
+{
+    uint64_t        result = 0;
+    uint_fast8_t    i;
+
+    for (i = 0; i < KHAZAD_BLOCK_SIZE; ++i)
+    {
+        result ^= khazad_t_table[i][(uint8_t)khazad_t_table[0][(a >> (i * 8u)) & 0xFFu]];
+    }
+    return result;
+}
+
+static void khazad_gather_crypt_step(uint8_t * p_dst, const uint8_t * p_src, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE])
+{
+    const __m256i   byte_mask = _mm256_set1_epi64x(0xFF);
+    uint_fast8_t    round;
+    __m256i         key;
+    __m256i         a;
+    __m256i         b;
+
+    key = khazad_gather_key(khazad_load_word(p_key_schedule));
+    a = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)p_src), key);
+    b = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(p_src + KHAZAD_GATHER_BYTES)), key);
+    for (round = 1u; round < KHAZAD_NUM_ROUNDS; ++round)
+    {
+        p_key_schedule += KHAZAD_BLOCK_SIZE;
+        key = khazad_gather_key(khazad_load_word(p_key_schedule));
+        a = _mm256_xor_si256(khazad_gather_round(a, byte_mask), key);
+        b = _mm256_xor_si256(khazad_gather_round(b, byte_mask), key);
+    }
+    p_key_schedule += KHAZAD_BLOCK_SIZE;
+    key = khazad_gather_key(khazad_load_word(p_key_schedule));
+    _mm256_storeu_si256((__m256i *)p_dst, _mm256_xor_si256(khazad_gather_sbox(a, byte_mask), key));
+    _mm256_storeu_si256((__m256i *)(p_dst + KHAZAD_GATHER_BYTES), _mm256_xor_si256(khazad_gather_sbox(b, byte_mask), key));
+}
+
+/* The state is carried between rounds before its S-box layer is applied, so
+ * the combined round look-ups can be used, with the round keys passed through
+ * the diffusion layer beforehand:
+ *     H(S(a) ^ k) = H(S(a)) ^ H(k)
+ * p_round_keys holds H(K_r) for r = 1 to 7.
+ */
+static void khazad_gather_decrypt_step(uint8_t * p_dst, const uint8_t * p_src, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE], const uint64_t p_round_keys[KHAZAD_NUM_ROUNDS])
+{
+    const __m256i   byte_mask = _mm256_set1_epi64x(0xFF);
+    uint_fast8_t    round;
+    __m256i         key;
+    __m256i         a;
+    __m256i         b;
+
+    key = khazad_gather_key(khazad_load_word(p_key_schedule + KHAZAD_KEY_SCHEDULE_SIZE - KHAZAD_BLOCK_SIZE));
+    a = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)p_src), key);
+    b = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(p_src + KHAZAD_GATHER_BYTES)), key);
+    for (round = KHAZAD_NUM_ROUNDS - 1u; round >= 1u; --round)
+    {
+        key = khazad_gather_key(p_round_keys[round]);
+        a = _mm256_xor_si256(khazad_gather_round(a, byte_mask), key);
+        b = _mm256_xor_si256(khazad_gather_round(b, byte_mask), key);
+    }
+    key = khazad_gather_key(khazad_load_word(p_key_schedule));
+    _mm256_storeu_si256((__m256i *)p_dst, _mm256_xor_si256(khazad_gather_sbox(a, byte_mask), key));
+    _mm256_storeu_si256((__m256i *)(p_dst + KHAZAD_GATHER_BYTES), _mm256_xor_si256(khazad_gather_sbox(b, byte_mask), key));
+}
+
+/*****************************************************************************
+ * Functions
+ ****************************************************************************/
+
+/* Encrypt (or decrypt, with a decryption key schedule) num_blocks
+ * contiguous blocks from p_src to p_dst. p_dst may equal p_src. */
+void khazad_avx2_gather_crypt_blocks(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE])
+{
+    uint8_t     tail[KHAZAD_GATHER_STEP_BLOCKS * KHAZAD_BLOCK_SIZE];
+
+    for (; num_blocks >= KHAZAD_GATHER_STEP_BLOCKS; num_blocks -= KHAZAD_GATHER_STEP_BLOCKS)
+    {
+        khazad_gather_crypt_step(p_dst, p_src, p_key_schedule);
+        p_dst += KHAZAD_GATHER_STEP_BLOCKS * KHAZAD_BLOCK_SIZE;
+        p_src += KHAZAD_GATHER_STEP_BLOCKS * KHAZAD_BLOCK_SIZE;
+    }
+    if (num_blocks)
+    {
+        memset(tail, 0, sizeof(tail));
+        memcpy(tail, p_src, num_blocks * KHAZAD_BLOCK_SIZE);
+        khazad_gather_crypt_step(tail, tail, p_key_schedule);
+        memcpy(p_dst, tail, num_blocks * KHAZAD_BLOCK_SIZE);
+    }
+}
+
+/* Decrypt num_blocks contiguous blocks from p_src to p_dst, using the
+ * regular key schedule created by khazad_key_schedule(). p_dst may equal
+ * p_src. */
+void khazad_avx2_gather_decrypt_blocks(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE])
+{
+    uint64_t        round_keys[KHAZAD_NUM_ROUNDS];
+    uint8_t         tail[KHAZAD_GATHER_STEP_BLOCKS * KHAZAD_BLOCK_SIZE];
+    uint_fast8_t    round;
+
+    round_keys[0] = 0;
+    for (round = 1u; round < KHAZAD_NUM_ROUNDS; ++round)
+    {
+        round_keys[round] = khazad_gather_diffusion_word(khazad_load_word(p_key_schedule + round * KHAZAD_BLOCK_SIZE));
+    }
+    for (; num_blocks >= KHAZAD_GATHER_STEP_BLOCKS; num_blocks -= KHAZAD_GATHER_STEP_BLOCKS)
+    {
+        khazad_gather_decrypt_step(p_dst, p_src, p_key_schedule, round_keys);
+        p_dst += KHAZAD_GATHER_STEP_BLOCKS * KHAZAD_BLOCK_SIZE;
+        p_src += KHAZAD_GATHER_STEP_BLOCKS * KHAZAD_BLOCK_SIZE;
+    }
+    if (num_blocks)
+    {
+        memset(tail, 0, sizeof(tail));
+        memcpy(tail, p_src, num_blocks * KHAZAD_BLOCK_SIZE);
+        khazad_gather_decrypt_step(tail, tail, p_key_schedule, round_keys);
+        memcpy(p_dst, tail, num_blocks * KHAZAD_BLOCK_SIZE);
+    }
+}
@@ -0,0 +1,187 @@
+/*****************************************************************************
+ * khazad-min-internal.h
+ *
+ * Helper functions shared by the Khazad implementation files. This header is
+ * not installed.
+ ****************************************************************************/
+
+#ifndef KHAZAD_MIN_INTERNAL_H
+#define KHAZAD_MIN_INTERNAL_H
+
+/*****************************************************************************
+ * Includes
+ ****************************************************************************/
+
+#include "khazad-min.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*****************************************************************************
+ * Defines
+ ****************************************************************************/
+
+/* Alignment of a structure member, and so of the structure, and padding of
+ * the structure to a multiple of it. Compilers with neither C11 nor GNU
+ * extensions get no alignment from this, only from the allocation. */
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define KHAZAD_ALIGNED(n)           _Alignas(n)
+#elif defined(__GNUC__)
+#define KHAZAD_ALIGNED(n)           __attribute__((aligned(n)))
+#else
+#define KHAZAD_ALIGNED(n)
+#endif
+
+/*****************************************************************************
+ * Inline functions
+ ****************************************************************************/
+
+/* Block byte i is held in bits 8*i to 8*i+7 of the word, regardless of the
+ * CPU's byte order. Compilers generally turn these into a single load or
+ * store on little-endian CPUs. */
+static inline uint64_t khazad_load_word(const uint8_t p_block[KHAZAD_BLOCK_SIZE])
+{
+    return (uint64_t)p_block[0] |
+           ((uint64_t)p_block[1] << 8u) |
+           ((uint64_t)p_block[2] << 16u) |
+           ((uint64_t)p_block[3] << 24u) |
+           ((uint64_t)p_block[4] << 32u) |
+           ((uint64_t)p_block[5] << 40u) |
+           ((uint64_t)p_block[6] << 48u) |
+           ((uint64_t)p_block[7] << 56u);
+}
+
+static inline void khazad_store_word(uint8_t p_block[KHAZAD_BLOCK_SIZE], uint64_t word)
+{
+    p_block[0] = (uint8_t)word;
+    p_block[1] = (uint8_t)(word >> 8u);
+    p_block[2] = (uint8_t)(word >> 16u);
+    p_block[3] = (uint8_t)(word >> 24u);
+    p_block[4] = (uint8_t)(word >> 32u);
+    p_block[5] = (uint8_t)(word >> 40u);
+    p_block[6] = (uint8_t)(word >> 48u);
+    p_block[7] = (uint8_t)(word >> 56u);
+}
+
+/* Clear memory that held key material. Through a volatile pointer, so the
+ * compiler can't remove the stores as dead, as it may for a memset() of memory
+ * that isn't read again. */
+static inline void khazad_wipe(void * p_memory, size_t size)
+{
+    volatile uint8_t  * p_byte = (volatile uint8_t *)p_memory;
+    size_t              i;
+
+    for (i = 0; i < size; ++i)
+    {
+        p_byte[i] = 0;
+    }
+}
+
+/* Allocate size bytes of zeroed memory aligned to KHAZAD_CACHE_LINE_SIZE, or
+ * return NULL. It is aligned within a larger calloc() block, whose address is
+ * kept just before it, so only C99 functions are needed. Free it with
+ * khazad_aligned_free().
+ */
+static inline void * khazad_aligned_alloc(size_t size)
+{
+    const size_t    extra = sizeof(void *) + KHAZAD_CACHE_LINE_SIZE - 1u;
+    void          * p_memory;
+    uint8_t       * p_aligned;
+
+    if (size > SIZE_MAX - extra)
+        return NULL;
+    p_memory = calloc(1u, size + extra);
+    if (p_memory == NULL)
+        return NULL;
+    p_aligned = (uint8_t *)p_memory + sizeof(void *);
+    p_aligned += (KHAZAD_CACHE_LINE_SIZE - (size_t)((uintptr_t)p_aligned % KHAZAD_CACHE_LINE_SIZE)) % KHAZAD_CACHE_LINE_SIZE;
+    memcpy(p_aligned - sizeof(void *), &p_memory, sizeof(void *));
+    return p_aligned;
+}
+
+/* Free memory from khazad_aligned_alloc(). p_aligned may be NULL. */
+static inline void khazad_aligned_free(void * p_aligned)
+{
+    void          * p_memory;
+
+    if (p_aligned == NULL)
+        return;
+    memcpy(&p_memory, (uint8_t *)p_aligned - sizeof(void *), sizeof(void *));
+    free(p_memory);
+}
+
+/* Hash a 64-bit word, with the splitmix64 finaliser. Used for hash tables of
+ * ids; it is not a cryptographic hash. */
+static inline uint64_t khazad_mix_word(uint64_t a)
+{
+    a = (a ^ (a >> 30u)) * 0xBF58476D1CE4E5B9u;
+    a = (a ^ (a >> 27u)) * 0x94D049BB133111EBu;
+    return a ^ (a >> 31u);
+}
+
+/*****************************************************************************
+ * Function prototypes
+ ****************************************************************************/
+
+#ifdef ENABLE_X86_KERNELS
+
+/* Portable implementations in khazad-min.c. With the x86 SIMD kernels, they
+ * are renamed from the public names, which are provided by
+ * khazad-min-dispatch.c instead.
+ */
+void khazad_scalar_crypt_blocks(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE]);
+void khazad_scalar_decrypt_blocks(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE]);
+void khazad_scalar_key_schedule_multi(uint8_t * p_key_schedules, const uint8_t * p_keys, size_t num_keys);
+void khazad_scalar_crypt_keyed_blocks(const khazad_keyed_block_t * p_blocks, size_t num_blocks);
+void khazad_scalar_decrypt_keyed_blocks(const khazad_keyed_block_t * p_blocks, size_t num_blocks);
+
+/* x86 SIMD kernels, in khazad-min-shuffle.c. The caller must check that the
+ * CPU supports the instruction set.
+ * The crypt functions work like khazad_crypt(), and the decrypt functions like
+ * khazad_decrypt(), on num_blocks contiguous blocks from p_src to p_dst.
+ * p_dst may equal p_src. The other functions work like
+ * khazad_key_schedule_multi(), khazad_crypt_keyed_blocks() and
+ * khazad_decrypt_keyed_blocks().
+ */
+void khazad_ssse3_crypt_blocks(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE]);
+void khazad_ssse3_decrypt_blocks(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE]);
+void khazad_avx2_crypt_blocks(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE]);
+void khazad_avx2_decrypt_blocks(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE]);
+void khazad_ssse3_key_schedule_multi(uint8_t * p_key_schedules, const uint8_t * p_keys, size_t num_keys);
+void khazad_avx2_key_schedule_multi(uint8_t * p_key_schedules, const uint8_t * p_keys, size_t num_keys);
+void khazad_ssse3_crypt_keyed_blocks(const khazad_keyed_block_t * p_blocks, size_t num_blocks);
+void khazad_ssse3_decrypt_keyed_blocks(const khazad_keyed_block_t * p_blocks, size_t num_blocks);
+void khazad_avx2_crypt_keyed_blocks(const khazad_keyed_block_t * p_blocks, size_t num_blocks);
+void khazad_avx2_decrypt_keyed_blocks(const khazad_keyed_block_t * p_blocks, size_t num_blocks);
+
+/* The eight 64-bit T-tables, which combine the S-box and the diffusion
+ * matrix, in khazad-min.c. Used by the AVX2 T-table kernel.
+ */
+extern const uint64_t khazad_t_table[KHAZAD_BLOCK_SIZE][256u];
+
+/* AVX2 T-table kernel, in khazad-min-gather.c. Same usage as the other AVX2
+ * kernel, but it does memory look-ups indexed by secret data.
+ */
+void khazad_avx2_gather_crypt_blocks(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE]);
+void khazad_avx2_gather_decrypt_blocks(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE]);
+
+#endif /* ENABLE_X86_KERNELS */
+
+#ifdef ENABLE_X86_AVX512_KERNEL
+
+/* AVX-512 VBMI and GFNI kernel, in khazad-min-avx512.c. The caller must check
+ * that the CPU supports AVX-512F, AVX-512BW, AVX-512VBMI and GFNI.
+ */
+void khazad_avx512_crypt_blocks(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE]);
+void khazad_avx512_decrypt_blocks(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE]);
+void khazad_avx512_key_schedule_multi(uint8_t * p_key_schedules, const uint8_t * p_keys, size_t num_keys);
+#if defined(__x86_64__)
+void khazad_avx512_crypt_keyed_blocks(const khazad_keyed_block_t * p_blocks, size_t num_blocks);
+void khazad_avx512_decrypt_keyed_blocks(const khazad_keyed_block_t * p_blocks, size_t num_blocks);
+#endif
+
+#endif /* ENABLE_X86_AVX512_KERNEL */
+
+#endif /* !defined(KHAZAD_MIN_INTERNAL_H) */
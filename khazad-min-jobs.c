@@ -0,0 +1,277 @@
+/*****************************************************************************
+ * khazad-min-jobs.c
+ *
+ * Khazad encryption and decryption of many blocks with mixed keys, grouped by
+ * key.
+ *
+ * Each job is a block and the id of its key. The jobs are taken a chunk at a
+ * time, and sorted by key id with a radix sort, so that each key's blocks can
+ * be gathered into a contiguous run. Each run is then processed by the
+ * multi-block functions with one key schedule, which is looked up (and
+ * prefetched) or expanded once per run. The results are scattered back to the
+ * jobs, so they stay in their original order.
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Includes
+ ****************************************************************************/
+
+#include "khazad-min.h"
+#include "khazad-min-internal.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*****************************************************************************
+ * Defines
+ ****************************************************************************/
+
+/* Number of jobs sorted together. Keys are grouped within a chunk only, so
+ * a larger chunk finds longer runs. The chunk's buffers (12 KB) are allocated
+ * once per call, rather than on the stack, which may be small on some
+ * threads. */
+#define KHAZAD_JOBS_CHUNK           1024u
+
+/* Chunk size if the buffers can't be allocated, small enough for the stack. */
+#define KHAZAD_JOBS_SMALL_CHUNK     32u
+
+/* Number of runs whose key schedules are prefetched or expanded together. */
+#define KHAZAD_JOBS_RUN_BATCH       16u
+
+#define KHAZAD_JOBS_RADIX_BITS      8u
+#define KHAZAD_JOBS_RADIX_SIZE      (1u << KHAZAD_JOBS_RADIX_BITS)
+
+#if defined(__GNUC__)
+#define KHAZAD_PREFETCH(p)          __builtin_prefetch(p)
+#else
+#define KHAZAD_PREFETCH(p)          ((void)(p))
+#endif
+
+/*****************************************************************************
+ * Types
+ ****************************************************************************/
+
+/* Buffers for one chunk: its job indices in key id order (and the radix
+ * sort's other buffer), and its blocks in that order. */
+typedef struct
+{
+    uint16_t    order[KHAZAD_JOBS_CHUNK];
+    uint16_t    temp[KHAZAD_JOBS_CHUNK];
+    uint8_t     blocks[KHAZAD_JOBS_CHUNK * KHAZAD_BLOCK_SIZE];
+} khazad_jobs_buffers_t;
+
+typedef struct
+{
+    uint16_t    order[KHAZAD_JOBS_SMALL_CHUNK];
+    uint16_t    temp[KHAZAD_JOBS_SMALL_CHUNK];
+    uint8_t     blocks[KHAZAD_JOBS_SMALL_CHUNK * KHAZAD_BLOCK_SIZE];
+} khazad_jobs_small_buffers_t;
+
+/*****************************************************************************
+ * Local functions
+ ****************************************************************************/
+
+/* Sort the job indices by key id, with an LSD radix sort. Digits that are
+ * the same for every job are skipped, so small key ids take fewer passes.
+ * Returns either p_order or p_temp, whichever holds the result. */
+static uint16_t * khazad_jobs_sort(uint16_t * p_order, uint16_t * p_temp, const khazad_job_t * p_jobs, size_t num_jobs)
+{
+    uint16_t        counts[KHAZAD_JOBS_RADIX_SIZE];
+    uint16_t      * p_swap;
+    uint_fast8_t    shift;
+    size_t          digit;
+    size_t          total;
+    size_t          count;
+    size_t          i;
+
+    for (i = 0; i < num_jobs; ++i)
+    {
+        p_order[i] = (uint16_t)i;
+    }
+    for (shift = 0; shift < 32u; shift += KHAZAD_JOBS_RADIX_BITS)
+    {
+        memset(counts, 0, sizeof(counts));
+        for (i = 0; i < num_jobs; ++i)
+        {
+            ++counts[(p_jobs[i].key_id >> shift) & (KHAZAD_JOBS_RADIX_SIZE - 1u)];
+        }
+        if (counts[(p_jobs[0].key_id >> shift) & (KHAZAD_JOBS_RADIX_SIZE - 1u)] == num_jobs)
+            continue;
+
+        total = 0;
+        for (digit = 0; digit < KHAZAD_JOBS_RADIX_SIZE; ++digit)
+        {
+            count = counts[digit];
+            counts[digit] = (uint16_t)total;
+            total += count;
+        }
+        for (i = 0; i < num_jobs; ++i)
+        {
+            digit = (p_jobs[p_order[i]].key_id >> shift) & (KHAZAD_JOBS_RADIX_SIZE - 1u);
+            p_temp[counts[digit]++] = p_order[i];
+        }
+        p_swap = p_order;
+        p_order = p_temp;
+        p_temp = p_swap;
+    }
+    return p_order;
+}
+
+/* Process one chunk of jobs, using the buffers p_order_buffer and
+ * p_temp_buffer of num_jobs indices, and p_blocks of num_jobs blocks. Key
+ * schedules are looked up in p_key_schedules, or if that is NULL, expanded
+ * from p_keys. */
+static void khazad_jobs_chunk(khazad_job_t * p_jobs, size_t num_jobs, bool decrypt, const uint8_t * p_key_schedules, const uint8_t * p_keys,
+                              uint16_t * p_order_buffer, uint16_t * p_temp_buffer, uint8_t * p_blocks)
+{
+    uint8_t         keys[KHAZAD_JOBS_RUN_BATCH * KHAZAD_KEY_SIZE];
+    uint8_t         key_schedules[KHAZAD_JOBS_RUN_BATCH * KHAZAD_KEY_SCHEDULE_SIZE];
+    size_t          run_ends[KHAZAD_JOBS_RUN_BATCH];
+    const uint8_t * p_run_key_schedules[KHAZAD_JOBS_RUN_BATCH];
+    uint16_t      * p_order;
+    uint32_t        key_id;
+    size_t          num_runs;
+    size_t          start;
+    size_t          end;
+    size_t          run;
+    size_t          i;
+
+    p_order = khazad_jobs_sort(p_order_buffer, p_temp_buffer, p_jobs, num_jobs);
+    for (i = 0; i < num_jobs; ++i)
+    {
+        memcpy(&p_blocks[i * KHAZAD_BLOCK_SIZE], p_jobs[p_order[i]].block, KHAZAD_BLOCK_SIZE);
+    }
+
+    for (start = 0; start < num_jobs; )
+    {
+        /* Find the next batch of runs, and start fetching their key
+         * schedules. */
+        end = start;
+        for (num_runs = 0; num_runs < KHAZAD_JOBS_RUN_BATCH && end < num_jobs; ++num_runs)
+        {
+            key_id = p_jobs[p_order[end]].key_id;
+            do
+            {
+                ++end;
+            } while (end < num_jobs && p_jobs[p_order[end]].key_id == key_id);
+            run_ends[num_runs] = end;
+            if (p_key_schedules != NULL)
+            {
+                p_run_key_schedules[num_runs] = p_key_schedules + (size_t)key_id * KHAZAD_KEY_SCHEDULE_SIZE;
+                KHAZAD_PREFETCH(p_run_key_schedules[num_runs]);
+                KHAZAD_PREFETCH(p_run_key_schedules[num_runs] + KHAZAD_KEY_SCHEDULE_SIZE - 1u);
+            }
+            else
+            {
+                memcpy(&keys[num_runs * KHAZAD_KEY_SIZE], p_keys + (size_t)key_id * KHAZAD_KEY_SIZE, KHAZAD_KEY_SIZE);
+                p_run_key_schedules[num_runs] = &key_schedules[num_runs * KHAZAD_KEY_SCHEDULE_SIZE];
+            }
+        }
+        if (p_key_schedules == NULL)
+        {
+            khazad_key_schedule_multi(key_schedules, keys, num_runs);
+        }
+
+        for (run = 0; run < num_runs; ++run)
+        {
+            end = run_ends[run];
+            if (decrypt)
+                khazad_decrypt_blocks(&p_blocks[start * KHAZAD_BLOCK_SIZE], &p_blocks[start * KHAZAD_BLOCK_SIZE], end - start, p_run_key_schedules[run]);
+            else
+                khazad_crypt_blocks(&p_blocks[start * KHAZAD_BLOCK_SIZE], &p_blocks[start * KHAZAD_BLOCK_SIZE], end - start, p_run_key_schedules[run]);
+            start = end;
+        }
+    }
+
+    for (i = 0; i < num_jobs; ++i)
+    {
+        memcpy(p_jobs[p_order[i]].block, &p_blocks[i * KHAZAD_BLOCK_SIZE], KHAZAD_BLOCK_SIZE);
+    }
+    khazad_wipe(p_blocks, num_jobs * KHAZAD_BLOCK_SIZE);
+    if (p_key_schedules == NULL)
+    {
+        khazad_wipe(key_schedules, sizeof(key_schedules));
+        khazad_wipe(keys, sizeof(keys));
+    }
+}
+
+static void khazad_jobs(khazad_job_t * p_jobs, size_t num_jobs, bool decrypt, const uint8_t * p_key_schedules, const uint8_t * p_keys)
+{
+    khazad_jobs_small_buffers_t     small_buffers;
+    khazad_jobs_buffers_t         * p_buffers;
+    size_t                          chunk_jobs;
+
+    if (num_jobs <= KHAZAD_JOBS_SMALL_CHUNK)
+    {
+        p_buffers = NULL;
+    }
+    else
+    {
+        p_buffers = (khazad_jobs_buffers_t *)malloc(sizeof(*p_buffers));
+    }
+    while (num_jobs)
+    {
+        if (p_buffers != NULL)
+        {
+            chunk_jobs = (num_jobs < KHAZAD_JOBS_CHUNK) ? num_jobs : KHAZAD_JOBS_CHUNK;
+            khazad_jobs_chunk(p_jobs, chunk_jobs, decrypt, p_key_schedules, p_keys,
+                              p_buffers->order, p_buffers->temp, p_buffers->blocks);
+        }
+        else
+        {
+            chunk_jobs = (num_jobs < KHAZAD_JOBS_SMALL_CHUNK) ? num_jobs : KHAZAD_JOBS_SMALL_CHUNK;
+            khazad_jobs_chunk(p_jobs, chunk_jobs, decrypt, p_key_schedules, p_keys,
+                              small_buffers.order, small_buffers.temp, small_buffers.blocks);
+        }
+        p_jobs += chunk_jobs;
+        num_jobs -= chunk_jobs;
+    }
+    free(p_buffers);
+}
+
+/*****************************************************************************
+ * Functions
+ ****************************************************************************/
+
+/* Khazad encryption (or decryption, with decryption key schedules) of many
+ * blocks with mixed keys.
+ * p_jobs points to num_jobs jobs. Each job's block is encrypted in-place,
+ * with the key schedule p_key_schedules + key_id * KHAZAD_KEY_SCHEDULE_SIZE.
+ * The jobs are grouped by key, a chunk at a time, and each group is processed
+ * by khazad_crypt_blocks(), so this suits many blocks per key in no
+ * particular order. Each key schedule is prefetched and loaded once per
+ * group.
+ */
+void khazad_crypt_jobs(khazad_job_t * p_jobs, size_t num_jobs, const uint8_t * p_key_schedules)
+{
+    khazad_jobs(p_jobs, num_jobs, false, p_key_schedules, NULL);
+}
+
+/* Khazad decryption of many blocks with mixed keys.
+ * As for khazad_crypt_jobs(), but with key schedules as for khazad_decrypt(),
+ * calculated with khazad_key_schedule().
+ */
+void khazad_decrypt_jobs(khazad_job_t * p_jobs, size_t num_jobs, const uint8_t * p_key_schedules)
+{
+    khazad_jobs(p_jobs, num_jobs, true, p_key_schedules, NULL);
+}
+
+/* Khazad encryption of many blocks with mixed keys, given the keys rather
+ * than their key schedules.
+ * p_jobs points to num_jobs jobs. Each job's block is encrypted in-place,
+ * with the 16-byte key at p_keys + key_id * KHAZAD_KEY_SIZE. Each key's
+ * schedule is calculated once per group, with khazad_key_schedule_multi().
+ */
+void khazad_crypt_jobs_with_keys(khazad_job_t * p_jobs, size_t num_jobs, const uint8_t * p_keys)
+{
+    khazad_jobs(p_jobs, num_jobs, false, NULL, p_keys);
+}
+
+/* Khazad decryption of many blocks with mixed keys, given the keys rather
+ * than their key schedules. Otherwise as for khazad_crypt_jobs_with_keys().
+ */
+void khazad_decrypt_jobs_with_keys(khazad_job_t * p_jobs, size_t num_jobs, const uint8_t * p_keys)
+{
+    khazad_jobs(p_jobs, num_jobs, true, NULL, p_keys);
+}
@@ -0,0 +1,575 @@
+/*****************************************************************************
+ * khazad-min-shuffle.c
+ *
+ * Khazad encryption and decryption of multiple blocks with x86 SIMD byte
+ * shuffles.
+ *
+ * The S-box is evaluated from its 4-bit P and Q mini-boxes (as for
+ * ENABLE_SBOX_SMALL in khazad-min.c). Each mini-box is a 16-entry table, which
+ * fits in one register and is looked up with pshufb/vpshufb, 16 or 32 bytes at
+ * a time. The diffusion layer is done with vectorised doubling in GF(2^8)
+ * modulo 0x11D, and byte shuffles within each 8-byte block. There are no
+ * memory look-ups indexed by secret data.
+ *
+ * This file is compiled twice: with -mssse3 to make the khazad_ssse3_*()
+ * functions (2 blocks per register), and with -mavx2 -DKHAZAD_SHUFFLE_AVX2 to
+ * make the khazad_avx2_*() functions (4 blocks per register). The variant is
+ * chosen by KHAZAD_SHUFFLE_AVX2 rather than __AVX2__, so that building with
+ * -mavx2 in CFLAGS still gives both.
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Includes
+ ****************************************************************************/
+
+#include "khazad-min.h"
+#include "khazad-min-internal.h"
+
+#include <string.h>
+#include <immintrin.h>
+
+/*****************************************************************************
+ * Defines
+ ****************************************************************************/
+
+#if defined(KHAZAD_SHUFFLE_AVX2)
+
+#if !defined(__AVX2__)
+#error "khazad-min-shuffle.c must be compiled with -mavx2 for KHAZAD_SHUFFLE_AVX2"
+#endif
+
+#define KHAZAD_VEC_BLOCKS           4u
+#define KHAZAD_SHUFFLE_NAME(name)   khazad_avx2_ ## name
+
+#elif defined(__SSSE3__)
+
+#define KHAZAD_VEC_BLOCKS           2u
+#define KHAZAD_SHUFFLE_NAME(name)   khazad_ssse3_ ## name
+
+#else
+#error "khazad-min-shuffle.c must be compiled with -mssse3 or -mavx2"
+#endif
+
+/* Two registers are processed together, for instruction-level
+ * parallelism. */
+#define KHAZAD_VEC_STEP_BLOCKS      (2u * KHAZAD_VEC_BLOCKS)
+#define KHAZAD_VEC_BYTES            (KHAZAD_VEC_BLOCKS * KHAZAD_BLOCK_SIZE)
+
+/* Initialisers for constant registers: 16 bytes (as two little-endian 64-bit
+ * words) repeated in each 128-bit lane, or one 64-bit word repeated. */
+#if defined(KHAZAD_SHUFFLE_AVX2)
+#define KHAZAD_VEC_CONST16(lo, hi)  { (long long)(lo), (long long)(hi), (long long)(lo), (long long)(hi) }
+#else
+#define KHAZAD_VEC_CONST16(lo, hi)  { (long long)(lo), (long long)(hi) }
+#endif
+#define KHAZAD_VEC_CONST64(a)       KHAZAD_VEC_CONST16(a, a)
+
+/*****************************************************************************
+ * Types
+ ****************************************************************************/
+
+#if defined(KHAZAD_SHUFFLE_AVX2)
+typedef __m256i khazad_vec_t;
+#else
+typedef __m128i khazad_vec_t;
+#endif
+
+/* Constants for the round functions. */
+typedef struct
+{
+    khazad_vec_t    p_hi;       /* P mini-box, output in the high nibble */
+    khazad_vec_t    p_lo;       /* P mini-box, output in the low nibble */
+    khazad_vec_t    q_hi;       /* Q mini-box, output in the high nibble */
+    khazad_vec_t    q_lo;       /* Q mini-box, output in the low nibble */
+    khazad_vec_t    nibble_mask;
+    khazad_vec_t    mix_keep_mask;
+    khazad_vec_t    mix_down_mask;
+    khazad_vec_t    mix_up_mask;
+    khazad_vec_t    reduce;
+    khazad_vec_t    permute[KHAZAD_BLOCK_SIZE];
+} khazad_vec_consts_t;
+
+/*****************************************************************************
+ * Look-up tables
+ ****************************************************************************/
+
+/* The constants are built at compile time, so each call just loads them from
+ * memory as it needs them.
+ * The mini-box tables are from sbox_small_table in khazad-min.c, which has the
+ * P box in the high nibble and the Q box in the low nibble of each entry:
+ *     p_hi[i] = table[i] & 0xF0     p_lo[i] = table[i] >> 4
+ *     q_hi[i] = table[i] << 4       q_lo[i] = table[i] & 0x0F
+ * permute[k][i] = i ^ k, for khazad_vec_permute(). */
+static const khazad_vec_consts_t khazad_vec_consts =
+{
+    KHAZAD_VEC_CONST16(0xC0B0405000E0F030u, 0x102080706090A0D0u),
+    KHAZAD_VEC_CONST16(0x0C0B0405000E0F03u, 0x0102080706090A0Du),
+    KHAZAD_VEC_CONST16(0xC03020A06050E090u, 0x8010B070D04000F0u),
+    KHAZAD_VEC_CONST16(0x0C03020A06050E09u, 0x08010B070D04000Fu),
+    KHAZAD_VEC_CONST64(0x0F0F0F0F0F0F0F0Fu),
+    KHAZAD_VEC_CONST64(0xC3C3C3C3C3C3C3C3u),
+    KHAZAD_VEC_CONST64(0x3030303030303030u),
+    KHAZAD_VEC_CONST64(0x0C0C0C0C0C0C0C0Cu),
+    KHAZAD_VEC_CONST64(0x1D1D1D1D1D1D1D1Du),
+    {
+        KHAZAD_VEC_CONST16(0x0706050403020100u, 0x0F0E0D0C0B0A0908u),
+        KHAZAD_VEC_CONST16(0x0607040502030001u, 0x0E0F0C0D0A0B0809u),
+        KHAZAD_VEC_CONST16(0x0504070601000302u, 0x0D0C0F0E09080B0Au),
+        KHAZAD_VEC_CONST16(0x0405060700010203u, 0x0C0D0E0F08090A0Bu),
+        KHAZAD_VEC_CONST16(0x0302010007060504u, 0x0B0A09080F0E0D0Cu),
+        KHAZAD_VEC_CONST16(0x0203000106070405u, 0x0A0B08090E0F0C0Du),
+        KHAZAD_VEC_CONST16(0x0100030205040706u, 0x09080B0A0D0C0F0Eu),
+        KHAZAD_VEC_CONST16(0x0001020304050607u, 0x08090A0B0C0D0E0Fu)
+    }
+};
+
+/* Key schedule round constants c_r, as for khazad_round_const_word() in
+ * khazad-min.c: the S-box outputs for 8r to 8r+7, in each 64-bit lane. */
+static const khazad_vec_t khazad_vec_round_consts[KHAZAD_NUM_ROUNDS + 1u] =
+{
+    KHAZAD_VEC_CONST64(0x4DD2D353742F54BAu),
+    KHAZAD_VEC_CONST64(0x4C9A5270BF8DAC50u),
+    KHAZAD_VEC_CONST64(0xA65B5133D197D5EAu),
+    KHAZAD_VEC_CONST64(0xFCB732DB99A848DEu),
+    KHAZAD_VEC_CONST64(0x6E41BBE29B919EE3u),
+    KHAZAD_VEC_CONST64(0x02B1F3A1956BCBA5u),
+    KHAZAD_VEC_CONST64(0x5DDA63C3141DC4CCu),
+    KHAZAD_VEC_CONST64(0x5C6C5A7FCD7DDC5Fu),
+    KHAZAD_VEC_CONST64(0x8E6F9DE8EDFF26F7u)
+};
+
+/*****************************************************************************
+ * Inline functions
+ ****************************************************************************/
+
+#if defined(KHAZAD_SHUFFLE_AVX2)
+
+static inline khazad_vec_t khazad_vec_set1_64(uint64_t a)
+{
+    return _mm256_set1_epi64x((long long)a);
+}
+
+static inline khazad_vec_t khazad_vec_load(const uint8_t * p)
+{
+    return _mm256_loadu_si256((const __m256i *)p);
+}
+
+static inline void khazad_vec_store(uint8_t * p, khazad_vec_t a)
+{
+    _mm256_storeu_si256((__m256i *)p, a);
+}
+
+static inline khazad_vec_t khazad_vec_xor(khazad_vec_t a, khazad_vec_t b)
+{
+    return _mm256_xor_si256(a, b);
+}
+
+static inline khazad_vec_t khazad_vec_and(khazad_vec_t a, khazad_vec_t b)
+{
+    return _mm256_and_si256(a, b);
+}
+
+static inline khazad_vec_t khazad_vec_or(khazad_vec_t a, khazad_vec_t b)
+{
+    return _mm256_or_si256(a, b);
+}
+
+static inline khazad_vec_t khazad_vec_shuffle(khazad_vec_t table, khazad_vec_t index)
+{
+    return _mm256_shuffle_epi8(table, index);
+}
+
+static inline khazad_vec_t khazad_vec_srli16(khazad_vec_t a, int count)
+{
+    return _mm256_srli_epi16(a, count);
+}
+
+static inline khazad_vec_t khazad_vec_slli16(khazad_vec_t a, int count)
+{
+    return _mm256_slli_epi16(a, count);
+}
+
+/* Multiply each byte by 2, modulo 0x11D. */
+static inline khazad_vec_t khazad_vec_mul2(khazad_vec_t a, const khazad_vec_consts_t * p_consts)
+{
+    khazad_vec_t    high_bit = _mm256_cmpgt_epi8(_mm256_setzero_si256(), a);
+
+    return _mm256_xor_si256(_mm256_add_epi8(a, a), _mm256_and_si256(high_bit, p_consts->reduce));
+}
+
+#else
+
+static inline khazad_vec_t khazad_vec_set1_64(uint64_t a)
+{
+    return _mm_set1_epi64x((long long)a);
+}
+
+static inline khazad_vec_t khazad_vec_load(const uint8_t * p)
+{
+    return _mm_loadu_si128((const __m128i *)p);
+}
+
+static inline void khazad_vec_store(uint8_t * p, khazad_vec_t a)
+{
+    _mm_storeu_si128((__m128i *)p, a);
+}
+
+static inline khazad_vec_t khazad_vec_xor(khazad_vec_t a, khazad_vec_t b)
+{
+    return _mm_xor_si128(a, b);
+}
+
+static inline khazad_vec_t khazad_vec_and(khazad_vec_t a, khazad_vec_t b)
+{
+    return _mm_and_si128(a, b);
+}
+
+static inline khazad_vec_t khazad_vec_or(khazad_vec_t a, khazad_vec_t b)
+{
+    return _mm_or_si128(a, b);
+}
+
+static inline khazad_vec_t khazad_vec_shuffle(khazad_vec_t table, khazad_vec_t index)
+{
+    return _mm_shuffle_epi8(table, index);
+}
+
+static inline khazad_vec_t khazad_vec_srli16(khazad_vec_t a, int count)
+{
+    return _mm_srli_epi16(a, count);
+}
+
+static inline khazad_vec_t khazad_vec_slli16(khazad_vec_t a, int count)
+{
+    return _mm_slli_epi16(a, count);
+}
+
+/* Multiply each byte by 2, modulo 0x11D. */
+static inline khazad_vec_t khazad_vec_mul2(khazad_vec_t a, const khazad_vec_consts_t * p_consts)
+{
+    khazad_vec_t    high_bit = _mm_cmpgt_epi8(_mm_setzero_si128(), a);
+
+    return _mm_xor_si128(_mm_add_epi8(a, a), _mm_and_si128(high_bit, p_consts->reduce));
+}
+
+#endif
+
+/* Output byte i of each block is input byte i ^ k. */
+static inline khazad_vec_t khazad_vec_permute(khazad_vec_t a, uint_fast8_t k, const khazad_vec_consts_t * p_consts)
+{
+    return khazad_vec_shuffle(a, p_consts->permute[k]);
+}
+
+/* One layer of mini-boxes: high nibble through table_hi, low nibble through
+ * table_lo. */
+static inline khazad_vec_t khazad_vec_sbox_layer(khazad_vec_t a, khazad_vec_t table_hi, khazad_vec_t table_lo, const khazad_vec_consts_t * p_consts)
+{
+    khazad_vec_t    hi = khazad_vec_and(khazad_vec_srli16(a, 4), p_consts->nibble_mask);
+    khazad_vec_t    lo = khazad_vec_and(a, p_consts->nibble_mask);
+
+    return khazad_vec_or(khazad_vec_shuffle(table_hi, hi), khazad_vec_shuffle(table_lo, lo));
+}
+
+/* work = (work & 0xC3) | ((work & 0x30) >> 2) | ((work & 0xC) << 2)
+ * The masks ensure no bits cross between bytes in the 16-bit shifts. */
+static inline khazad_vec_t khazad_vec_sbox_mix(khazad_vec_t a, const khazad_vec_consts_t * p_consts)
+{
+    return khazad_vec_or(khazad_vec_and(a, p_consts->mix_keep_mask),
+                         khazad_vec_or(khazad_vec_srli16(khazad_vec_and(a, p_consts->mix_down_mask), 2),
+                                       khazad_vec_slli16(khazad_vec_and(a, p_consts->mix_up_mask), 2)));
+}
+
+static inline khazad_vec_t khazad_vec_sbox(khazad_vec_t a, const khazad_vec_consts_t * p_consts)
+{
+    a = khazad_vec_sbox_layer(a, p_consts->p_hi, p_consts->q_lo, p_consts);
+    a = khazad_vec_sbox_mix(a, p_consts);
+    a = khazad_vec_sbox_layer(a, p_consts->q_hi, p_consts->p_lo, p_consts);
+    a = khazad_vec_sbox_mix(a, p_consts);
+    return khazad_vec_sbox_layer(a, p_consts->p_hi, p_consts->q_lo, p_consts);
+}
+
+/* Diffusion layer, with the same factorisation as khazad_bs_diffusion() in
+ * khazad-min-bitslice.c. P_k() is khazad_vec_permute() with k.
+ *     q1 = x + P_1(x)
+ *     q3 = x + P_3(x)
+ *     r = P_1(x) + P_6(q1)
+ *     w = P_2(q1) + P_4(q3) + P_5(2 * q3)
+ *     w = P_4(x) + r + 2 * w
+ *     y = q3 + r + 2 * w
+ */
+static inline khazad_vec_t khazad_vec_diffusion(khazad_vec_t x, const khazad_vec_consts_t * p_consts)
+{
+    khazad_vec_t    x1 = khazad_vec_permute(x, 1u, p_consts);
+    khazad_vec_t    q1 = khazad_vec_xor(x, x1);
+    khazad_vec_t    q3 = khazad_vec_xor(x, khazad_vec_permute(x, 3u, p_consts));
+    khazad_vec_t    r = khazad_vec_xor(x1, khazad_vec_permute(q1, 6u, p_consts));
+    khazad_vec_t    w;
+
+    w = khazad_vec_xor(khazad_vec_permute(q1, 2u, p_consts), khazad_vec_permute(q3, 4u, p_consts));
+    w = khazad_vec_xor(w, khazad_vec_permute(khazad_vec_mul2(q3, p_consts), 5u, p_consts));
+    w = khazad_vec_xor(khazad_vec_xor(khazad_vec_permute(x, 4u, p_consts), r), khazad_vec_mul2(w, p_consts));
+    return khazad_vec_xor(khazad_vec_xor(q3, r), khazad_vec_mul2(w, p_consts));
+}
+
+/*****************************************************************************
+ * Local functions
+ ****************************************************************************/
+
+static void khazad_vec_crypt_step(uint8_t * p_dst, const uint8_t * p_src, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE], const khazad_vec_consts_t * p_consts)
+{
+    uint_fast8_t    round;
+    khazad_vec_t    key;
+    khazad_vec_t    a;
+    khazad_vec_t    b;
+
+    key = khazad_vec_set1_64(khazad_load_word(p_key_schedule));
+    a = khazad_vec_xor(khazad_vec_load(p_src), key);
+    b = khazad_vec_xor(khazad_vec_load(p_src + KHAZAD_VEC_BYTES), key);
+    for (round = 1u; round < KHAZAD_NUM_ROUNDS; ++round)
+    {
+        p_key_schedule += KHAZAD_BLOCK_SIZE;
+        key = khazad_vec_set1_64(khazad_load_word(p_key_schedule));
+        a = khazad_vec_xor(khazad_vec_diffusion(khazad_vec_sbox(a, p_consts), p_consts), key);
+        b = khazad_vec_xor(khazad_vec_diffusion(khazad_vec_sbox(b, p_consts), p_consts), key);
+    }
+    p_key_schedule += KHAZAD_BLOCK_SIZE;
+    key = khazad_vec_set1_64(khazad_load_word(p_key_schedule));
+    khazad_vec_store(p_dst, khazad_vec_xor(khazad_vec_sbox(a, p_consts), key));
+    khazad_vec_store(p_dst + KHAZAD_VEC_BYTES, khazad_vec_xor(khazad_vec_sbox(b, p_consts), key));
+}
+
+static void khazad_vec_decrypt_step(uint8_t * p_dst, const uint8_t * p_src, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE], const khazad_vec_consts_t * p_consts)
+{
+    uint_fast8_t    round;
+    khazad_vec_t    key;
+    khazad_vec_t    a;
+    khazad_vec_t    b;
+
+    p_key_schedule += KHAZAD_KEY_SCHEDULE_SIZE - KHAZAD_BLOCK_SIZE;
+    key = khazad_vec_set1_64(khazad_load_word(p_key_schedule));
+    a = khazad_vec_sbox(khazad_vec_xor(khazad_vec_load(p_src), key), p_consts);
+    b = khazad_vec_sbox(khazad_vec_xor(khazad_vec_load(p_src + KHAZAD_VEC_BYTES), key), p_consts);
+    for (round = 1u; round < KHAZAD_NUM_ROUNDS; ++round)
+    {
+        p_key_schedule -= KHAZAD_BLOCK_SIZE;
+        key = khazad_vec_set1_64(khazad_load_word(p_key_schedule));
+        a = khazad_vec_sbox(khazad_vec_diffusion(khazad_vec_xor(a, key), p_consts), p_consts);
+        b = khazad_vec_sbox(khazad_vec_diffusion(khazad_vec_xor(b, key), p_consts), p_consts);
+    }
+    p_key_schedule -= KHAZAD_BLOCK_SIZE;
+    key = khazad_vec_set1_64(khazad_load_word(p_key_schedule));
+    khazad_vec_store(p_dst, khazad_vec_xor(a, key));
+    khazad_vec_store(p_dst + KHAZAD_VEC_BYTES, khazad_vec_xor(b, key));
+}
+
+/* Key schedules of up to KHAZAD_VEC_STEP_BLOCKS keys, one key per 64-bit
+ * lane. The key halves are gathered into lanes, and the round keys scattered
+ * back to the key schedules, through buffers. */
+static void khazad_vec_key_schedule_step(uint8_t * p_key_schedules, const uint8_t * p_keys, size_t num_keys, const khazad_vec_t p_round_consts[KHAZAD_NUM_ROUNDS + 1u], const khazad_vec_consts_t * p_consts)
+{
+    uint8_t         lanes_m2[KHAZAD_VEC_STEP_BLOCKS * KHAZAD_BLOCK_SIZE];
+    uint8_t         lanes_m1[KHAZAD_VEC_STEP_BLOCKS * KHAZAD_BLOCK_SIZE];
+    uint_fast8_t    round;
+    size_t          i;
+    khazad_vec_t    a_m2;
+    khazad_vec_t    a_m1;
+    khazad_vec_t    b_m2;
+    khazad_vec_t    b_m1;
+    khazad_vec_t    a;
+    khazad_vec_t    b;
+
+    memset(lanes_m2, 0, sizeof(lanes_m2));
+    memset(lanes_m1, 0, sizeof(lanes_m1));
+    for (i = 0; i < num_keys; ++i)
+    {
+        memcpy(&lanes_m2[i * KHAZAD_BLOCK_SIZE], p_keys + i * KHAZAD_KEY_SIZE, KHAZAD_BLOCK_SIZE);
+        memcpy(&lanes_m1[i * KHAZAD_BLOCK_SIZE], p_keys + i * KHAZAD_KEY_SIZE + KHAZAD_BLOCK_SIZE, KHAZAD_BLOCK_SIZE);
+    }
+    a_m2 = khazad_vec_load(lanes_m2);
+    b_m2 = khazad_vec_load(lanes_m2 + KHAZAD_VEC_BYTES);
+    a_m1 = khazad_vec_load(lanes_m1);
+    b_m1 = khazad_vec_load(lanes_m1 + KHAZAD_VEC_BYTES);
+    for (round = 0; round < (KHAZAD_NUM_ROUNDS + 1u); ++round)
+    {
+        a = khazad_vec_xor(khazad_vec_diffusion(khazad_vec_sbox(a_m1, p_consts), p_consts), khazad_vec_xor(p_round_consts[round], a_m2));
+        b = khazad_vec_xor(khazad_vec_diffusion(khazad_vec_sbox(b_m1, p_consts), p_consts), khazad_vec_xor(p_round_consts[round], b_m2));
+        khazad_vec_store(lanes_m2, a);
+        khazad_vec_store(lanes_m2 + KHAZAD_VEC_BYTES, b);
+        for (i = 0; i < num_keys; ++i)
+        {
+            memcpy(p_key_schedules + i * KHAZAD_KEY_SCHEDULE_SIZE + round * KHAZAD_BLOCK_SIZE, &lanes_m2[i * KHAZAD_BLOCK_SIZE], KHAZAD_BLOCK_SIZE);
+        }
+        a_m2 = a_m1;
+        b_m2 = b_m1;
+        a_m1 = a;
+        b_m1 = b;
+    }
+}
+
+/* Transpose up to KHAZAD_VEC_STEP_BLOCKS blocks and their round keys into
+ * buffers, so that lane i of each register is entry i. */
+static void khazad_vec_keyed_load(uint8_t p_state[KHAZAD_VEC_STEP_BLOCKS * KHAZAD_BLOCK_SIZE], uint8_t p_round_keys[KHAZAD_NUM_ROUNDS + 1u][KHAZAD_VEC_STEP_BLOCKS * KHAZAD_BLOCK_SIZE], const khazad_keyed_block_t * p_blocks, size_t num_blocks)
+{
+    uint_fast8_t    round;
+    size_t          i;
+
+    memset(p_state, 0, KHAZAD_VEC_STEP_BLOCKS * KHAZAD_BLOCK_SIZE);
+    memset(p_round_keys, 0, (KHAZAD_NUM_ROUNDS + 1u) * KHAZAD_VEC_STEP_BLOCKS * KHAZAD_BLOCK_SIZE);
+    for (i = 0; i < num_blocks; ++i)
+    {
+        memcpy(&p_state[i * KHAZAD_BLOCK_SIZE], p_blocks[i].p_block, KHAZAD_BLOCK_SIZE);
+        for (round = 0; round < (KHAZAD_NUM_ROUNDS + 1u); ++round)
+        {
+            memcpy(&p_round_keys[round][i * KHAZAD_BLOCK_SIZE], p_blocks[i].p_key_schedule + round * KHAZAD_BLOCK_SIZE, KHAZAD_BLOCK_SIZE);
+        }
+    }
+}
+
+static void khazad_vec_keyed_store(const khazad_keyed_block_t * p_blocks, size_t num_blocks, const uint8_t p_state[KHAZAD_VEC_STEP_BLOCKS * KHAZAD_BLOCK_SIZE])
+{
+    size_t          i;
+
+    for (i = 0; i < num_blocks; ++i)
+    {
+        memcpy(p_blocks[i].p_block, &p_state[i * KHAZAD_BLOCK_SIZE], KHAZAD_BLOCK_SIZE);
+    }
+}
+
+/* As for khazad_vec_crypt_step(), but with each block's own key schedule. */
+static void khazad_vec_crypt_keyed_step(const khazad_keyed_block_t * p_blocks, size_t num_blocks, const khazad_vec_consts_t * p_consts)
+{
+    uint8_t         state[KHAZAD_VEC_STEP_BLOCKS * KHAZAD_BLOCK_SIZE];
+    uint8_t         round_keys[KHAZAD_NUM_ROUNDS + 1u][KHAZAD_VEC_STEP_BLOCKS * KHAZAD_BLOCK_SIZE];
+    uint_fast8_t    round;
+    khazad_vec_t    a;
+    khazad_vec_t    b;
+
+    khazad_vec_keyed_load(state, round_keys, p_blocks, num_blocks);
+    a = khazad_vec_xor(khazad_vec_load(state), khazad_vec_load(round_keys[0]));
+    b = khazad_vec_xor(khazad_vec_load(state + KHAZAD_VEC_BYTES), khazad_vec_load(round_keys[0] + KHAZAD_VEC_BYTES));
+    for (round = 1u; round < KHAZAD_NUM_ROUNDS; ++round)
+    {
+        a = khazad_vec_xor(khazad_vec_diffusion(khazad_vec_sbox(a, p_consts), p_consts), khazad_vec_load(round_keys[round]));
+        b = khazad_vec_xor(khazad_vec_diffusion(khazad_vec_sbox(b, p_consts), p_consts), khazad_vec_load(round_keys[round] + KHAZAD_VEC_BYTES));
+    }
+    khazad_vec_store(state, khazad_vec_xor(khazad_vec_sbox(a, p_consts), khazad_vec_load(round_keys[KHAZAD_NUM_ROUNDS])));
+    khazad_vec_store(state + KHAZAD_VEC_BYTES, khazad_vec_xor(khazad_vec_sbox(b, p_consts), khazad_vec_load(round_keys[KHAZAD_NUM_ROUNDS] + KHAZAD_VEC_BYTES)));
+    khazad_vec_keyed_store(p_blocks, num_blocks, state);
+}
+
+/* As for khazad_vec_decrypt_step(), but with each block's own key schedule. */
+static void khazad_vec_decrypt_keyed_step(const khazad_keyed_block_t * p_blocks, size_t num_blocks, const khazad_vec_consts_t * p_consts)
+{
+    uint8_t         state[KHAZAD_VEC_STEP_BLOCKS * KHAZAD_BLOCK_SIZE];
+    uint8_t         round_keys[KHAZAD_NUM_ROUNDS + 1u][KHAZAD_VEC_STEP_BLOCKS * KHAZAD_BLOCK_SIZE];
+    uint_fast8_t    round;
+    khazad_vec_t    a;
+    khazad_vec_t    b;
+
+    khazad_vec_keyed_load(state, round_keys, p_blocks, num_blocks);
+    a = khazad_vec_sbox(khazad_vec_xor(khazad_vec_load(state), khazad_vec_load(round_keys[KHAZAD_NUM_ROUNDS])), p_consts);
+    b = khazad_vec_sbox(khazad_vec_xor(khazad_vec_load(state + KHAZAD_VEC_BYTES), khazad_vec_load(round_keys[KHAZAD_NUM_ROUNDS] + KHAZAD_VEC_BYTES)), p_consts);
+    for (round = KHAZAD_NUM_ROUNDS - 1u; round >= 1u; --round)
+    {
+        a = khazad_vec_sbox(khazad_vec_diffusion(khazad_vec_xor(a, khazad_vec_load(round_keys[round])), p_consts), p_consts);
+        b = khazad_vec_sbox(khazad_vec_diffusion(khazad_vec_xor(b, khazad_vec_load(round_keys[round] + KHAZAD_VEC_BYTES)), p_consts), p_consts);
+    }
+    khazad_vec_store(state, khazad_vec_xor(a, khazad_vec_load(round_keys[0])));
+    khazad_vec_store(state + KHAZAD_VEC_BYTES, khazad_vec_xor(b, khazad_vec_load(round_keys[0] + KHAZAD_VEC_BYTES)));
+    khazad_vec_keyed_store(p_blocks, num_blocks, state);
+}
+
+/*****************************************************************************
+ * Functions
+ ****************************************************************************/
+
+/* Encrypt (or decrypt, with a decryption key schedule) num_blocks
+ * contiguous blocks from p_src to p_dst. p_dst may equal p_src. */
+void KHAZAD_SHUFFLE_NAME(crypt_blocks)(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE])
+{
+    uint8_t         tail[KHAZAD_VEC_STEP_BLOCKS * KHAZAD_BLOCK_SIZE];
+
+    for (; num_blocks >= KHAZAD_VEC_STEP_BLOCKS; num_blocks -= KHAZAD_VEC_STEP_BLOCKS)
+    {
+        khazad_vec_crypt_step(p_dst, p_src, p_key_schedule, &khazad_vec_consts);
+        p_dst += KHAZAD_VEC_STEP_BLOCKS * KHAZAD_BLOCK_SIZE;
+        p_src += KHAZAD_VEC_STEP_BLOCKS * KHAZAD_BLOCK_SIZE;
+    }
+    if (num_blocks)
+    {
+        memset(tail, 0, sizeof(tail));
+        memcpy(tail, p_src, num_blocks * KHAZAD_BLOCK_SIZE);
+        khazad_vec_crypt_step(tail, tail, p_key_schedule, &khazad_vec_consts);
+        memcpy(p_dst, tail, num_blocks * KHAZAD_BLOCK_SIZE);
+    }
+}
+
+/* Decrypt num_blocks contiguous blocks from p_src to p_dst, using the
+ * regular key schedule created by khazad_key_schedule(). p_dst may equal
+ * p_src. */
+void KHAZAD_SHUFFLE_NAME(decrypt_blocks)(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE])
+{
+    uint8_t         tail[KHAZAD_VEC_STEP_BLOCKS * KHAZAD_BLOCK_SIZE];
+
+    for (; num_blocks >= KHAZAD_VEC_STEP_BLOCKS; num_blocks -= KHAZAD_VEC_STEP_BLOCKS)
+    {
+        khazad_vec_decrypt_step(p_dst, p_src, p_key_schedule, &khazad_vec_consts);
+        p_dst += KHAZAD_VEC_STEP_BLOCKS * KHAZAD_BLOCK_SIZE;
+        p_src += KHAZAD_VEC_STEP_BLOCKS * KHAZAD_BLOCK_SIZE;
+    }
+    if (num_blocks)
+    {
+        memset(tail, 0, sizeof(tail));
+        memcpy(tail, p_src, num_blocks * KHAZAD_BLOCK_SIZE);
+        khazad_vec_decrypt_step(tail, tail, p_key_schedule, &khazad_vec_consts);
+        memcpy(p_dst, tail, num_blocks * KHAZAD_BLOCK_SIZE);
+    }
+}
+
+/* Calculate the key schedules of num_keys keys, stored contiguously at p_keys,
+ * into contiguous key schedules at p_key_schedules, as for
+ * khazad_key_schedule(). */
+void KHAZAD_SHUFFLE_NAME(key_schedule_multi)(uint8_t * p_key_schedules, const uint8_t * p_keys, size_t num_keys)
+{
+    size_t          group_keys;
+
+    while (num_keys)
+    {
+        group_keys = (num_keys < KHAZAD_VEC_STEP_BLOCKS) ? num_keys : KHAZAD_VEC_STEP_BLOCKS;
+        khazad_vec_key_schedule_step(p_key_schedules, p_keys, group_keys, khazad_vec_round_consts, &khazad_vec_consts);
+        p_key_schedules += group_keys * KHAZAD_KEY_SCHEDULE_SIZE;
+        p_keys += group_keys * KHAZAD_KEY_SIZE;
+        num_keys -= group_keys;
+    }
+}
+
+/* Encrypt (or decrypt, with decryption key schedules) num_blocks blocks
+ * in-place, each with its own key schedule, as for
+ * khazad_crypt_keyed_blocks(). */
+void KHAZAD_SHUFFLE_NAME(crypt_keyed_blocks)(const khazad_keyed_block_t * p_blocks, size_t num_blocks)
+{
+    size_t          group_blocks;
+
+    while (num_blocks)
+    {
+        group_blocks = (num_blocks < KHAZAD_VEC_STEP_BLOCKS) ? num_blocks : KHAZAD_VEC_STEP_BLOCKS;
+        khazad_vec_crypt_keyed_step(p_blocks, group_blocks, &khazad_vec_consts);
+        p_blocks += group_blocks;
+        num_blocks -= group_blocks;
+    }
+}
+
+/* Decrypt num_blocks blocks in-place, each with its own regular key
+ * schedule, as for khazad_decrypt_keyed_blocks(). */
+void KHAZAD_SHUFFLE_NAME(decrypt_keyed_blocks)(const khazad_keyed_block_t * p_blocks, size_t num_blocks)
+{
+    size_t          group_blocks;
+
+    while (num_blocks)
+    {
+        group_blocks = (num_blocks < KHAZAD_VEC_STEP_BLOCKS) ? num_blocks : KHAZAD_VEC_STEP_BLOCKS;
+        khazad_vec_decrypt_keyed_step(p_blocks, group_blocks, &khazad_vec_consts);
+        p_blocks += group_blocks;
+        num_blocks -= group_blocks;
+    }
+}
@@ -0,0 +1,422 @@
+/*****************************************************************************
+ * khazad-min-store.c
+ *
+ * Memory-mapped files of precomputed Khazad key schedules.
+ *
+ * See khazad-min-store.h for the file format. The writer sorts the ids, then
+ * calculates the key schedules a batch at a time with
+ * khazad_key_schedule_multi(), in id order. The reader maps the whole file,
+ * checks that the header describes tables inside it, and then reads records
+ * and ids straight from the mapping.
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Includes
+ ****************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "khazad-min-store.h"
+#include "khazad-min-internal.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*****************************************************************************
+ * Defines
+ ****************************************************************************/
+
+#define KHAZAD_KS_STORE_MAGIC           "KHAZADKS"
+#define KHAZAD_KS_STORE_MAGIC_SIZE      8u
+#define KHAZAD_KS_STORE_VERSION         1u
+#define KHAZAD_KS_STORE_HEADER_SIZE     64u
+#define KHAZAD_KS_STORE_ID_SIZE         8u
+
+#define KHAZAD_KS_STORE_OFFSET_VERSION      8u
+#define KHAZAD_KS_STORE_OFFSET_FLAGS        12u
+#define KHAZAD_KS_STORE_OFFSET_NUM_RECORDS  16u
+#define KHAZAD_KS_STORE_OFFSET_RECORD_SIZE  24u
+#define KHAZAD_KS_STORE_OFFSET_IDS          32u
+#define KHAZAD_KS_STORE_OFFSET_RECORDS      40u
+
+/* Alignment of records within a file, and of the record size. */
+#define KHAZAD_KS_STORE_RECORD_ALIGN    16u
+/* Alignment of the records in files written by khazad_ks_store_write(). */
+#define KHAZAD_KS_STORE_PAGE_SIZE       4096u
+
+/* Number of key schedules calculated together when writing. */
+#define KHAZAD_KS_STORE_BATCH           256u
+
+/*****************************************************************************
+ * Types
+ ****************************************************************************/
+
+struct khazad_ks_store
+{
+    const uint8_t     * p_map;
+    size_t              map_size;
+    const uint8_t     * p_ids;
+    const uint8_t     * p_records;
+    size_t              num_records;
+    size_t              record_size;
+    unsigned            flags;
+};
+
+/* An id and its index in the caller's arrays, for sorting. */
+typedef struct
+{
+    uint64_t            id;
+    size_t              index;
+} khazad_ks_store_entry_t;
+
+/*****************************************************************************
+ * Local functions
+ ****************************************************************************/
+
+static uint32_t khazad_ks_store_load_u32(const uint8_t * p_bytes)
+{
+    return (uint32_t)p_bytes[0] |
+           ((uint32_t)p_bytes[1] << 8u) |
+           ((uint32_t)p_bytes[2] << 16u) |
+           ((uint32_t)p_bytes[3] << 24u);
+}
+
+static void khazad_ks_store_store_u32(uint8_t * p_bytes, uint32_t value)
+{
+    p_bytes[0] = (uint8_t)value;
+    p_bytes[1] = (uint8_t)(value >> 8u);
+    p_bytes[2] = (uint8_t)(value >> 16u);
+    p_bytes[3] = (uint8_t)(value >> 24u);
+}
+
+static size_t khazad_ks_store_record_size(unsigned flags)
+{
+    size_t  size = KHAZAD_KEY_SCHEDULE_SIZE;
+
+    if (flags & KHAZAD_KS_STORE_DECRYPT_KEYS)
+        size += KHAZAD_KEY_SCHEDULE_SIZE;
+    return (size + KHAZAD_KS_STORE_RECORD_ALIGN - 1u) & ~(size_t)(KHAZAD_KS_STORE_RECORD_ALIGN - 1u);
+}
+
+static int khazad_ks_store_compare(const void * p_a, const void * p_b)
+{
+    uint64_t    a = ((const khazad_ks_store_entry_t *)p_a)->id;
+    uint64_t    b = ((const khazad_ks_store_entry_t *)p_b)->id;
+
+    return (a > b) - (a < b);
+}
+
+/* Write the records, in the order of p_entries. */
+static int khazad_ks_store_write_records(FILE * p_file, const khazad_ks_store_entry_t * p_entries, const uint8_t * p_keys, size_t num_records, unsigned flags)
+{
+    uint8_t     keys[KHAZAD_KS_STORE_BATCH * KHAZAD_KEY_SIZE];
+    uint8_t     key_schedules[KHAZAD_KS_STORE_BATCH * KHAZAD_KEY_SCHEDULE_SIZE];
+    uint8_t     record[2u * KHAZAD_KEY_SCHEDULE_SIZE + KHAZAD_KS_STORE_RECORD_ALIGN];
+    size_t      record_size = khazad_ks_store_record_size(flags);
+    size_t      batch;
+    size_t      i;
+    int         result = 0;
+
+    memset(record, 0, sizeof(record));
+    while (num_records && result == 0)
+    {
+        batch = (num_records < KHAZAD_KS_STORE_BATCH) ? num_records : KHAZAD_KS_STORE_BATCH;
+        for (i = 0; i < batch; ++i)
+        {
+            memcpy(&keys[i * KHAZAD_KEY_SIZE], &p_keys[p_entries[i].index * KHAZAD_KEY_SIZE], KHAZAD_KEY_SIZE);
+        }
+        khazad_key_schedule_multi(key_schedules, keys, batch);
+        for (i = 0; i < batch; ++i)
+        {
+            memcpy(record, &key_schedules[i * KHAZAD_KEY_SCHEDULE_SIZE], KHAZAD_KEY_SCHEDULE_SIZE);
+            if (flags & KHAZAD_KS_STORE_DECRYPT_KEYS)
+                khazad_decrypt_key_schedule_from_encrypt(record + KHAZAD_KEY_SCHEDULE_SIZE, record);
+            if (fwrite(record, record_size, 1u, p_file) != 1u)
+            {
+                result = -1;
+                break;
+            }
+        }
+        p_entries += batch;
+        num_records -= batch;
+    }
+    /* Don't leave key material on the stack. */
+    khazad_wipe(keys, sizeof(keys));
+    khazad_wipe(key_schedules, sizeof(key_schedules));
+    khazad_wipe(record, sizeof(record));
+    return result;
+}
+
+static int khazad_ks_store_write_file(FILE * p_file, const khazad_ks_store_entry_t * p_entries, const uint8_t * p_keys, size_t num_records, unsigned flags)
+{
+    uint8_t     header[KHAZAD_KS_STORE_HEADER_SIZE];
+    uint8_t     id[KHAZAD_KS_STORE_ID_SIZE];
+    uint64_t    ids_offset = KHAZAD_KS_STORE_HEADER_SIZE;
+    uint64_t    records_offset;
+    uint64_t    offset;
+    size_t      i;
+
+    records_offset = ids_offset + (uint64_t)num_records * KHAZAD_KS_STORE_ID_SIZE;
+    records_offset = (records_offset + KHAZAD_KS_STORE_PAGE_SIZE - 1u) & ~(uint64_t)(KHAZAD_KS_STORE_PAGE_SIZE - 1u);
+
+    memset(header, 0, sizeof(header));
+    memcpy(header, KHAZAD_KS_STORE_MAGIC, KHAZAD_KS_STORE_MAGIC_SIZE);
+    khazad_ks_store_store_u32(header + KHAZAD_KS_STORE_OFFSET_VERSION, KHAZAD_KS_STORE_VERSION);
+    khazad_ks_store_store_u32(header + KHAZAD_KS_STORE_OFFSET_FLAGS, flags);
+    khazad_store_word(header + KHAZAD_KS_STORE_OFFSET_NUM_RECORDS, num_records);
+    khazad_ks_store_store_u32(header + KHAZAD_KS_STORE_OFFSET_RECORD_SIZE, (uint32_t)khazad_ks_store_record_size(flags));
+    khazad_store_word(header + KHAZAD_KS_STORE_OFFSET_IDS, ids_offset);
+    khazad_store_word(header + KHAZAD_KS_STORE_OFFSET_RECORDS, records_offset);
+    if (fwrite(header, sizeof(header), 1u, p_file) != 1u)
+        return -1;
+
+    for (i = 0; i < num_records; ++i)
+    {
+        khazad_store_word(id, p_entries[i].id);
+        if (fwrite(id, sizeof(id), 1u, p_file) != 1u)
+            return -1;
+    }
+    for (offset = ids_offset + (uint64_t)num_records * KHAZAD_KS_STORE_ID_SIZE; offset < records_offset; ++offset)
+    {
+        if (fputc(0, p_file) == EOF)
+            return -1;
+    }
+    return khazad_ks_store_write_records(p_file, p_entries, p_keys, num_records, flags);
+}
+
+/* Check that a mapped file is a valid store, and fill in p_store from its
+ * header. */
+static int khazad_ks_store_parse(khazad_ks_store_t * p_store)
+{
+    const uint8_t * p_header = p_store->p_map;
+    uint64_t        num_records;
+    uint64_t        record_size;
+    uint64_t        ids_offset;
+    uint64_t        records_offset;
+    unsigned        flags;
+
+    if (p_store->map_size < KHAZAD_KS_STORE_HEADER_SIZE
+        || memcmp(p_header, KHAZAD_KS_STORE_MAGIC, KHAZAD_KS_STORE_MAGIC_SIZE) != 0
+        || khazad_ks_store_load_u32(p_header + KHAZAD_KS_STORE_OFFSET_VERSION) != KHAZAD_KS_STORE_VERSION)
+        return -1;
+
+    flags = khazad_ks_store_load_u32(p_header + KHAZAD_KS_STORE_OFFSET_FLAGS);
+    num_records = khazad_load_word(p_header + KHAZAD_KS_STORE_OFFSET_NUM_RECORDS);
+    record_size = khazad_ks_store_load_u32(p_header + KHAZAD_KS_STORE_OFFSET_RECORD_SIZE);
+    ids_offset = khazad_load_word(p_header + KHAZAD_KS_STORE_OFFSET_IDS);
+    records_offset = khazad_load_word(p_header + KHAZAD_KS_STORE_OFFSET_RECORDS);
+    if ((flags & ~KHAZAD_KS_STORE_DECRYPT_KEYS) != 0
+        || record_size < khazad_ks_store_record_size(flags)
+        || (record_size % KHAZAD_KS_STORE_RECORD_ALIGN) != 0
+        || (ids_offset % KHAZAD_KS_STORE_ID_SIZE) != 0
+        || (records_offset % KHAZAD_CACHE_LINE_SIZE) != 0)
+        return -1;
+    /* Each table must fit in the file. Written this way to avoid overflow. */
+    if (ids_offset < KHAZAD_KS_STORE_HEADER_SIZE || ids_offset > p_store->map_size
+        || num_records > (p_store->map_size - ids_offset) / KHAZAD_KS_STORE_ID_SIZE
+        || records_offset < KHAZAD_KS_STORE_HEADER_SIZE || records_offset > p_store->map_size
+        || num_records > (p_store->map_size - records_offset) / record_size)
+        return -1;
+
+    p_store->p_ids = p_store->p_map + ids_offset;
+    p_store->p_records = p_store->p_map + records_offset;
+    p_store->num_records = (size_t)num_records;
+    p_store->record_size = (size_t)record_size;
+    p_store->flags = flags;
+    return 0;
+}
+
+/*****************************************************************************
+ * Functions
+ ****************************************************************************/
+
+/* Write a key schedule store file.
+ * p_ids points to num_records ids, in any order, but with no duplicates, and
+ * p_keys to the num_records 16-byte keys, stored contiguously. Each key's
+ * schedule is calculated and written in a record for its id.
+ * flags is 0, or KHAZAD_KS_STORE_DECRYPT_KEYS.
+ * The file is overwritten if it exists. To replace a store that is in use,
+ * write a new file then rename() it over the old one.
+ * Returns 0 on success, or -1 with errno set on failure. errno is EINVAL if
+ * there are duplicate ids.
+ */
+int khazad_ks_store_write(const char * p_path, const uint64_t * p_ids, const uint8_t * p_keys, size_t num_records, unsigned flags)
+{
+    khazad_ks_store_entry_t   * p_entries;
+    FILE                      * p_file;
+    size_t                      i;
+    int                         result;
+
+    if ((flags & ~KHAZAD_KS_STORE_DECRYPT_KEYS) != 0)
+    {
+        errno = EINVAL;
+        return -1;
+    }
+    p_entries = (khazad_ks_store_entry_t *)malloc((num_records ? num_records : 1u) * sizeof(*p_entries));
+    if (p_entries == NULL)
+        return -1;
+    for (i = 0; i < num_records; ++i)
+    {
+        p_entries[i].id = p_ids[i];
+        p_entries[i].index = i;
+    }
+    qsort(p_entries, num_records, sizeof(*p_entries), khazad_ks_store_compare);
+    for (i = 1u; i < num_records; ++i)
+    {
+        if (p_entries[i].id == p_entries[i - 1u].id)
+        {
+            free(p_entries);
+            errno = EINVAL;
+            return -1;
+        }
+    }
+
+    p_file = fopen(p_path, "wb");
+    if (p_file == NULL)
+    {
+        free(p_entries);
+        return -1;
+    }
+    result = khazad_ks_store_write_file(p_file, p_entries, p_keys, num_records, flags);
+    if (fclose(p_file) != 0)
+        result = -1;
+    free(p_entries);
+    return result;
+}
+
+/* Open a key schedule store file, and map it into memory, read-only.
+ * Returns NULL with errno set on failure. errno is EINVAL if the file isn't
+ * a valid store.
+ */
+khazad_ks_store_t * khazad_ks_store_open(const char * p_path)
+{
+    khazad_ks_store_t * p_store;
+    struct stat         st;
+    void              * p_map;
+    int                 fd;
+    int                 error;
+
+    fd = open(p_path, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+    if (fstat(fd, &st) != 0)
+    {
+        error = errno;
+        close(fd);
+        errno = error;
+        return NULL;
+    }
+    if (st.st_size < (off_t)KHAZAD_KS_STORE_HEADER_SIZE || (uint64_t)st.st_size > SIZE_MAX)
+    {
+        close(fd);
+        errno = EINVAL;
+        return NULL;
+    }
+    p_map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    error = errno;
+    /* The mapping stays valid after the file is closed. */
+    close(fd);
+    if (p_map == MAP_FAILED)
+    {
+        errno = error;
+        return NULL;
+    }
+
+    p_store = (khazad_ks_store_t *)calloc(1u, sizeof(*p_store));
+    if (p_store == NULL)
+    {
+        munmap(p_map, (size_t)st.st_size);
+        errno = ENOMEM;
+        return NULL;
+    }
+    p_store->p_map = (const uint8_t *)p_map;
+    p_store->map_size = (size_t)st.st_size;
+    if (khazad_ks_store_parse(p_store) != 0)
+    {
+        khazad_ks_store_close(p_store);
+        errno = EINVAL;
+        return NULL;
+    }
+    return p_store;
+}
+
+/* Unmap and close a key schedule store. Key schedules from it must not be
+ * used after this.
+ */
+void khazad_ks_store_close(khazad_ks_store_t * p_store)
+{
+    if (p_store == NULL)
+        return;
+    munmap((void *)p_store->p_map, p_store->map_size);
+    free(p_store);
+}
+
+/* Get the number of records in a key schedule store.
+ */
+size_t khazad_ks_store_num_records(const khazad_ks_store_t * p_store)
+{
+    return p_store->num_records;
+}
+
+/* Get the flags that a key schedule store was written with.
+ */
+unsigned khazad_ks_store_flags(const khazad_ks_store_t * p_store)
+{
+    return p_store->flags;
+}
+
+/* Find the record index for id, by binary search of the id table.
+ * Returns KHAZAD_KS_STORE_NOT_FOUND if the id isn't in the store.
+ */
+size_t khazad_ks_store_find(const khazad_ks_store_t * p_store, uint64_t id)
+{
+    size_t      low = 0;
+    size_t      high = p_store->num_records;
+    size_t      middle;
+    uint64_t    middle_id;
+
+    while (low < high)
+    {
+        middle = low + (high - low) / 2u;
+        middle_id = khazad_ks_store_id(p_store, middle);
+        if (middle_id == id)
+            return middle;
+        if (middle_id < id)
+            low = middle + 1u;
+        else
+            high = middle;
+    }
+    return KHAZAD_KS_STORE_NOT_FOUND;
+}
+
+/* Get the id of record index, which must be less than the number of records.
+ */
+uint64_t khazad_ks_store_id(const khazad_ks_store_t * p_store, size_t index)
+{
+    return khazad_load_word(p_store->p_ids + index * KHAZAD_KS_STORE_ID_SIZE);
+}
+
+/* Get the key schedule of record index, which must be less than the number of
+ * records. It points into the mapped file.
+ */
+const uint8_t * khazad_ks_store_key_schedule(const khazad_ks_store_t * p_store, size_t index)
+{
+    return p_store->p_records + index * p_store->record_size;
+}
+
+/* Get the decryption key schedule of record index, which must be less than the
+ * number of records. It points into the mapped file.
+ * Returns NULL if the store wasn't written with KHAZAD_KS_STORE_DECRYPT_KEYS.
+ */
+const uint8_t * khazad_ks_store_decrypt_key_schedule(const khazad_ks_store_t * p_store, size_t index)
+{
+    if ((p_store->flags & KHAZAD_KS_STORE_DECRYPT_KEYS) == 0)
+        return NULL;
+    return p_store->p_records + index * p_store->record_size + KHAZAD_KEY_SCHEDULE_SIZE;
+}
@@ -0,0 +1,119 @@
+/*****************************************************************************
+ * khazad-min-store.h
+ *
+ * Memory-mapped files of precomputed Khazad key schedules.
+ *
+ * A key schedule store is a file of fixed-size records, each holding the key
+ * schedule of one key, and optionally its decryption key schedule too, with a
+ * sorted table of 64-bit ids (such as device ids) for the records. It is
+ * opened with mmap(), so look-ups return pointers into the mapping with no
+ * copying, and processes that open the same file share one copy of it in the
+ * page cache.
+ *
+ * File format, version 1. Integers are little-endian.
+ *
+ *     Offset  Size  Field
+ *     0       8     Magic, "KHAZADKS"
+ *     8       4     Version, 1
+ *     12      4     Flags: KHAZAD_KS_STORE_DECRYPT_KEYS
+ *     16      8     Number of records, n
+ *     24      4     Record size, a multiple of 16
+ *     28      4     Reserved, 0
+ *     32      8     Offset of the id table, a multiple of 8
+ *     40      8     Offset of the records, a multiple of 64
+ *     48      16    Reserved, 0
+ *
+ * The id table is n 8-byte ids, in ascending order with no duplicates. Record
+ * i is for id i, and holds the key schedule, as from khazad_key_schedule(),
+ * followed by the decryption key schedule, as from
+ * khazad_decrypt_key_schedule(), if that flag is set. The rest of the record
+ * is padding. The records are aligned to 16 bytes, and start on a page
+ * boundary as written by khazad_ks_store_write().
+ *
+ * This needs mmap(), and is only built if it is available.
+ ****************************************************************************/
+
+#ifndef KHAZAD_MIN_STORE_H
+#define KHAZAD_MIN_STORE_H
+
+/*****************************************************************************
+ * Includes
+ ****************************************************************************/
+
+#include "khazad-min.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*****************************************************************************
+ * Defines
+ ****************************************************************************/
+
+/* Flag for khazad_ks_store_write(): store decryption key schedules too. */
+#define KHAZAD_KS_STORE_DECRYPT_KEYS    0x01u
+
+/* Returned by khazad_ks_store_find() if the id isn't in the store. */
+#define KHAZAD_KS_STORE_NOT_FOUND       SIZE_MAX
+
+/*****************************************************************************
+ * Types
+ ****************************************************************************/
+
+typedef struct khazad_ks_store khazad_ks_store_t;
+
+/*****************************************************************************
+ * Function prototypes
+ ****************************************************************************/
+
+/* Write a key schedule store file.
+ * p_ids points to num_records ids, in any order, but with no duplicates, and
+ * p_keys to the num_records 16-byte keys, stored contiguously. Each key's
+ * schedule is calculated and written in a record for its id.
+ * flags is 0, or KHAZAD_KS_STORE_DECRYPT_KEYS.
+ * The file is overwritten if it exists. To replace a store that is in use,
+ * write a new file then rename() it over the old one.
+ * Returns 0 on success, or -1 with errno set on failure. errno is EINVAL if
+ * there are duplicate ids.
+ */
+int khazad_ks_store_write(const char * p_path, const uint64_t * p_ids, const uint8_t * p_keys, size_t num_records, unsigned flags);
+
+/* Open a key schedule store file, and map it into memory, read-only.
+ * Returns NULL with errno set on failure. errno is EINVAL if the file isn't
+ * a valid store.
+ */
+khazad_ks_store_t * khazad_ks_store_open(const char * p_path);
+
+/* Unmap and close a key schedule store. Key schedules from it must not be
+ * used after this.
+ */
+void khazad_ks_store_close(khazad_ks_store_t * p_store);
+
+/* Get the number of records in a key schedule store.
+ */
+size_t khazad_ks_store_num_records(const khazad_ks_store_t * p_store);
+
+/* Get the flags that a key schedule store was written with.
+ */
+unsigned khazad_ks_store_flags(const khazad_ks_store_t * p_store);
+
+/* Find the record index for id, by binary search of the id table.
+ * Returns KHAZAD_KS_STORE_NOT_FOUND if the id isn't in the store.
+ */
+size_t khazad_ks_store_find(const khazad_ks_store_t * p_store, uint64_t id);
+
+/* Get the id of record index, which must be less than the number of records.
+ */
+uint64_t khazad_ks_store_id(const khazad_ks_store_t * p_store, size_t index);
+
+/* Get the key schedule of record index, which must be less than the number of
+ * records. It points into the mapped file.
+ */
+const uint8_t * khazad_ks_store_key_schedule(const khazad_ks_store_t * p_store, size_t index);
+
+/* Get the decryption key schedule of record index, which must be less than the
+ * number of records. It points into the mapped file.
+ * Returns NULL if the store wasn't written with KHAZAD_KS_STORE_DECRYPT_KEYS.
+ */
+const uint8_t * khazad_ks_store_decrypt_key_schedule(const khazad_ks_store_t * p_store, size_t index);
+
+#endif /* !defined(KHAZAD_MIN_STORE_H) */
@@ -0,0 +1,546 @@
+/* Generated by Python gen-t-table.py */
+
+#ifndef KHAZAD_T_TABLE_LINKAGE
+#define KHAZAD_T_TABLE_LINKAGE  static
+#endif
+
+KHAZAD_T_TABLE_LINKAGE const uint64_t khazad_t_table[KHAZAD_T_TABLE_COUNT][256u] =
+{
+    {
+        0x016AB9BB68D2D3BAu, 0xB1669AE5194DFC54u, 0xCD1465E293BC712Fu, 0x511B8725B9CD9C74u,
+        0xA457A2F70251F553u, 0x03BED6D0B86B68D3u, 0x04B5DED6BD6F6BD2u, 0xFE8552B36429D74Du,
+        0xAD4ABAFD0D5DF050u, 0x63E009CF268AE9ACu, 0x84961C09830E8A8Du, 0x1A4D91A579C6DCBFu,
+        0x4D37A73DADDD9070u, 0xA35CAAF10755F652u, 0xE117A47BC852B39Au, 0xF98E5AB5612DD44Cu,
+        0xAC200346658F23EAu, 0x1184E6C4A67362D5u, 0xC268CC55F166A497u, 0x0DA8C6DCB2636ED1u,
+        0x99D085AAFFCC5533u, 0xAA41B2FB0859F351u, 0x9C0FE2C72A71ED5Bu, 0x55AE59F304A2F7A6u,
+        0x20C1BEFE815F7FDEu, 0xE5A27AAD753DD848u, 0x7FCC29D7329AE5A8u, 0xE80ABC71C75EB699u,
+        0x3BE696E0904B70DBu, 0x9EDB8DACFAC85632u, 0x2215D19551E6C4B7u, 0xCEAAB3322BD719FCu,
+        0x93734B7048AB38E3u, 0xFD3B8463DC42BF9Eu, 0xD052FC41EF7EAE91u, 0xE61CAC7DCD56B09Bu,
+        0x947843764DAF3BE2u, 0x0661B1BD6DD6D0BBu, 0xDAF1329B5819C341u, 0x17E55779CBA5B26Eu,
+        0x5CB341F90BAEF2A5u, 0x4B561680C00B40CBu, 0x0CC27F67DAB1BD6Bu, 0xCC7EDC59FB6EA295u,
+        0x409F61E11FBEFEA1u, 0xE3C3CB1018EB08F3u, 0x302FE1814FFECEB1u, 0x0E16100C0A080602u,
+        0x5E672E92DB1749CCu, 0x663F6EA2F33751C4u, 0x53CFE84E6974271Du, 0x6C9CA07844503C14u,
+        0x730E56B0E82B58C3u, 0x349A3F57F291A563u, 0x3CED9EE6954F73DAu, 0x8E35D2D33469E75Du,
+        0x8023C2DF3E61E15Fu, 0x2ED7AEF28B5779DCu, 0x6E48CF1394E9877Du, 0x596C2694DE134ACDu,
+        0x605EDF1F9EE1817Fu, 0x9B04EAC12F75EE5Au, 0x19F34775C1ADB46Cu, 0x893EDAD5316DE45Cu,
+        0xFFEFEB080CFB04F7u, 0xF2472DD4BE986A26u, 0xC7B7AB3824DB1CFFu, 0xB9113B547E932AEDu,
+        0xA236134A6F8725E8u, 0xF4269C69D34EBA9Du, 0x10EE5F7FCEA1B16Fu, 0x8D8B04038C028F8Eu,
+        0x4FE3C8567D642B19u, 0x479469E71ABAFDA0u, 0xEADED31A17E70DF0u, 0x98BA3C11971E8689u,
+        0x2D697822333C110Fu, 0x153138121B1C0907u, 0x6AFD11C52986ECAFu, 0xDB9B8B2030CB10FBu,
+        0x3858403028201808u, 0x6B97A87E41543F15u, 0x237F682E3934170Du, 0x1C2C201814100C04u,
+        0x070B080605040301u, 0x21AB0745E98DAC64u, 0x27CAB6F8845B7CDFu, 0x5F0D9729B3C59A76u,
+        0x7264EF0B80F98B79u, 0x29DCA6F48E537ADDu, 0xB3B2F58EC9F4473Du, 0x628AB0744E583A16u,
+        0xBDA4E582C3FC413Fu, 0x85FCA5B2EBDC5937u, 0x1EF84F73C4A9B76Du, 0xA895DD90D8E04838u,
+        0x0877A1B167DED6B9u, 0x442ABF37A2D19573u, 0xA53D1B4C6A8326E9u, 0x8BEAB5BEE1D45F35u,
+        0xB66D92E31C49FF55u, 0x4A3CAF3BA8D99371u, 0x7C72FF078AF18D7Bu, 0x839D140F860A898Cu,
+        0x4321B731A7D59672u, 0x9FB13417921A8588u, 0xF8E4E30E09FF07F6u, 0xD6334DFC82A87E2Au,
+        0xBAAFED84C6F8423Eu, 0x8728CAD93B65E25Eu, 0xF54C25D2BB9C6927u, 0xCFC00A894305CA46u,
+        0x247460283C30140Cu, 0x26A00F43EC89AF65u, 0x05DF676DD5BDB868u, 0x3A8C2F5BF899A361u,
+        0x091D180A0F0C0503u, 0x7D1846BCE2235EC1u, 0xB87B82EF1641F957u, 0x1899FECEA97F67D6u,
+        0x35F086EC9A4376D9u, 0x9512FACD257DE858u, 0x32FB8EEA9F4775D8u, 0x2FBD1749E385AA66u,
+        0x1F92F6C8AC7B64D7u, 0xA683CD9CD2E84E3Au, 0x424B0E8ACF0745C8u, 0xB4B9FD88CCF0443Cu,
+        0xDC90832635CF13FAu, 0xC563C453F462A796u, 0x52A551F501A6F4A7u, 0xEF01B477C25AB598u,
+        0xBE1A33527B9729ECu, 0x0F7CA9B762DAD5B8u, 0x6F2276A8FC3B54C7u, 0x6DF619C32C82EFAEu,
+        0x02D46F6BD0B9BB69u, 0xECBF62A77A31DD4Bu, 0x76D131DD3D96E0ABu, 0x78C721D1379EE6A9u,
+        0x28B61F4FE681A967u, 0x364E503C22281E0Au, 0xC8CB028F4601C947u, 0xE4C8C3161DEF0BF2u,
+        0x2C03C1995BEEC2B5u, 0xEE6B0DCCAA886622u, 0x81497B6456B332E5u, 0xB00C235E719F2FEEu,
+        0x1D4699A37CC2DFBEu, 0xD13845FA87AC7D2Bu, 0xA0E27C21BF3E9E81u, 0x7EA6906C5A483612u,
+        0xAEF46C2DB5369883u, 0x41F5D85A776C2D1Bu, 0x2A6270243638120Eu, 0xE96005CAAF8C6523u,
+        0xF1F9FB0406F302F5u, 0xC6DD12834C09CF45u, 0xE77615C6A5846321u, 0x50713E9ED11F4FCEu,
+        0xE2A972AB7039DB49u, 0xC4097DE89CB0742Cu, 0xD58D9B2C3AC316F9u, 0x8854636E59BF37E6u,
+        0x251ED99354E2C7B6u, 0xD8255DF088A07828u, 0x6581B8724B5C3917u, 0xA9FF642BB0329B82u,
+        0x46FED05C72682E1Au, 0x96AC2C1D9D16808Bu, 0xC0BCA33E21DF1FFEu, 0x91A7241B9812838Au,
+        0x3F5348362D241B09u, 0x4540068CCA0346C9u, 0xB2D84C35A1269487u, 0xF7984AB96B25D24Eu,
+        0x9D655B7C42A33EE1u, 0xCA1F6DE496B8722Eu, 0x8642736253B731E4u, 0x9A6E537A47A73DE0u,
+        0xAB2B0B40608B20EBu, 0xD759F447EA7AAD90u, 0x5BB849FF0EAAF1A4u, 0x5AD2F0446678221Eu,
+        0xBCCE5C39AB2E9285u, 0x3D87275DFD9DA060u, 0x0000000000000000u, 0xFB5A35DEB1946F25u,
+        0xF6F2F30203F701F4u, 0xEDD5DB1C12E30EF1u, 0xCB75D45FFE6AA194u, 0x3145583A272C1D0Bu,
+        0x8F5F6B685CBB34E7u, 0x56108F23BCC99F75u, 0xB7072B58749B2CEFu, 0x8CE1BDB8E4D05C34u,
+        0x97C695A6F5C45331u, 0x168FEEC2A37761D4u, 0x0AA3CEDAB7676DD0u, 0xB5D34433A4229786u,
+        0x6755D7199BE5827Eu, 0x64EB01C9238EEAADu, 0xC9A1BB342ED31AFDu, 0xDF2E55F68DA47B29u,
+        0x90CD9DA0F0C05030u, 0xA188C59AD7EC4D3Bu, 0xFA308C65D946BC9Fu, 0xD286932A3FC715F8u,
+        0x68297EAEF93F57C6u, 0x79AD986A5F4C3513u, 0x123A30141E180A06u, 0x1B27281E11140F05u,
+        0x613466A4F63352C5u, 0x77BB886655443311u, 0x58069F2FB6C19977u, 0x6943C71591ED847Cu,
+        0x7B79F7018FF58E7Au, 0x756FE70D85FD8878u, 0x82F7ADB4EED85A36u, 0x54C4E0486C70241Cu,
+        0xAF9ED596DDE44B39u, 0x9219F2CB2079EB59u, 0x48E8C05078602818u, 0xBF708AE91345FA56u,
+        0x3E39F18D45F6C8B3u, 0x3724E9874AFACDB0u, 0xFC513DD8B4906C24u, 0xE07D1DC0A0806020u,
+        0x3932F98B40F2CBB2u, 0xD94FE44BE072AB92u, 0x4E8971ED15B6F8A3u, 0x7A134EBAE7275DC0u,
+        0xC1D61A85490DCC44u, 0x33913751F795A662u, 0x70B0806050403010u, 0x2B08C99F5EEAC1B4u,
+        0xBBC5543FAE2A9184u, 0xD4E722975211C543u, 0xDE44EC4DE576A893u, 0x74055EB6ED2F5BC2u,
+        0xEBB46AA17F35DE4Au, 0x145B81A973CEDABDu, 0x8A800C0589068C8Fu, 0xC30275EE99B4772Du,
+        0x135089AF76CAD9BCu, 0xF32D946FD64AB99Cu, 0x0BC97761DFB5BE6Au, 0xDDFA3A9D5D1DC040u,
+        0x577A3698D41B4CCFu, 0x498279EB10B2FBA2u, 0xA7E97427BA3A9D80u, 0xF09342BF6E21D14Fu,
+        0x5DD9F842637C211Fu, 0x4C5D1E86C50F43CAu, 0x71DA39DB3892E3AAu, 0xD3EC2A915715C642u,
+    },
+#if KHAZAD_T_TABLE_COUNT > 1u
+    {
+        0x6A01BBB9D268BAD3u, 0x66B1E59A4D1954FCu, 0x14CDE265BC932F71u, 0x1B512587CDB9749Cu,
+        0x57A4F7A2510253F5u, 0xBE03D0D66BB8D368u, 0xB504D6DE6FBDD26Bu, 0x85FEB35229644DD7u,
+        0x4AADFDBA5D0D50F0u, 0xE063CF098A26ACE9u, 0x9684091C0E838D8Au, 0x4D1AA591C679BFDCu,
+        0x374D3DA7DDAD7090u, 0x5CA3F1AA550752F6u, 0x17E17BA452C89AB3u, 0x8EF9B55A2D614CD4u,
+        0x20AC46038F65EA23u, 0x8411C4E673A6D562u, 0x68C255CC66F197A4u, 0xA80DDCC663B2D16Eu,
+        0xD099AA85CCFF3355u, 0x41AAFBB2590851F3u, 0x0F9CC7E2712A5BEDu, 0xAE55F359A204A6F7u,
+        0xC120FEBE5F81DE7Fu, 0xA2E5AD7A3D7548D8u, 0xCC7FD7299A32A8E5u, 0x0AE871BC5EC799B6u,
+        0xE63BE0964B90DB70u, 0xDB9EAC8DC8FA3256u, 0x152295D1E651B7C4u, 0xAACE32B3D72BFC19u,
+        0x7393704BAB48E338u, 0x3BFD638442DC9EBFu, 0x52D041FC7EEF91AEu, 0x1CE67DAC56CD9BB0u,
+        0x78947643AF4DE23Bu, 0x6106BDB1D66DBBD0u, 0xF1DA9B32195841C3u, 0xE5177957A5CB6EB2u,
+        0xB35CF941AE0BA5F2u, 0x564B80160BC0CB40u, 0xC20C677FB1DA6BBDu, 0x7ECC59DC6EFB95A2u,
+        0x9F40E161BE1FA1FEu, 0xC3E310CBEB18F308u, 0x2F3081E1FE4FB1CEu, 0x160E0C10080A0206u,
+        0x675E922E17DBCC49u, 0x3F66A26E37F3C451u, 0xCF534EE874691D27u, 0x9C6C78A05044143Cu,
+        0x0E73B0562BE8C358u, 0x9A34573F91F263A5u, 0xED3CE69E4F95DA73u, 0x358ED3D269345DE7u,
+        0x2380DFC2613E5FE1u, 0xD72EF2AE578BDC79u, 0x486E13CFE9947D87u, 0x6C59942613DECD4Au,
+        0x5E601FDFE19E7F81u, 0x049BC1EA752F5AEEu, 0xF3197547ADC16CB4u, 0x3E89D5DA6D315CE4u,
+        0xEFFF08EBFB0CF704u, 0x47F2D42D98BE266Au, 0xB7C738ABDB24FF1Cu, 0x11B9543B937EED2Au,
+        0x36A24A13876FE825u, 0x26F4699C4ED39DBAu, 0xEE107F5FA1CE6FB1u, 0x8B8D0304028C8E8Fu,
+        0xE34F56C8647D192Bu, 0x9447E769BA1AA0FDu, 0xDEEA1AD3E717F00Du, 0xBA98113C1E978986u,
+        0x692D22783C330F11u, 0x311512381C1B0709u, 0xFD6AC5118629AFECu, 0x9BDB208BCB30FB10u,
+        0x5838304020280818u, 0x976B7EA85441153Fu, 0x7F232E6834390D17u, 0x2C1C18201014040Cu,
+        0x0B07060804050103u, 0xAB2145078DE964ACu, 0xCA27F8B65B84DF7Cu, 0x0D5F2997C5B3769Au,
+        0x64720BEFF980798Bu, 0xDC29F4A6538EDD7Au, 0xB2B38EF5F4C93D47u, 0x8A6274B0584E163Au,
+        0xA4BD82E5FCC33F41u, 0xFC85B2A5DCEB3759u, 0xF81E734FA9C46DB7u, 0x95A890DDE0D83848u,
+        0x7708B1A1DE67B9D6u, 0x2A4437BFD1A27395u, 0x3DA54C1B836AE926u, 0xEA8BBEB5D4E1355Fu,
+        0x6DB6E392491C55FFu, 0x3C4A3BAFD9A87193u, 0x727C07FFF18A7B8Du, 0x9D830F140A868C89u,
+        0x214331B7D5A77296u, 0xB19F17341A928885u, 0xE4F80EE3FF09F607u, 0x33D6FC4DA8822A7Eu,
+        0xAFBA84EDF8C63E42u, 0x2887D9CA653B5EE2u, 0x4CF5D2259CBB2769u, 0xC0CF890A054346CAu,
+        0x74242860303C0C14u, 0xA026430F89EC65AFu, 0xDF056D67BDD568B8u, 0x8C3A5B2F99F861A3u,
+        0x1D090A180C0F0305u, 0x187DBC4623E2C15Eu, 0x7BB8EF82411657F9u, 0x9918CEFE7FA9D667u,
+        0xF035EC86439AD976u, 0x1295CDFA7D2558E8u, 0xFB32EA8E479FD875u, 0xBD2F491785E366AAu,
+        0x921FC8F67BACD764u, 0x83A69CCDE8D23A4Eu, 0x4B428A0E07CFC845u, 0xB9B488FDF0CC3C44u,
+        0x90DC2683CF35FA13u, 0x63C553C462F496A7u, 0xA552F551A601A7F4u, 0x01EF77B45AC298B5u,
+        0x1ABE5233977BEC29u, 0x7C0FB7A9DA62B8D5u, 0x226FA8763BFCC754u, 0xF66DC319822CAEEFu,
+        0xD4026B6FB9D069BBu, 0xBFECA762317A4BDDu, 0xD176DD31963DABE0u, 0xC778D1219E37A9E6u,
+        0xB6284F1F81E667A9u, 0x4E363C5028220A1Eu, 0xCBC88F02014647C9u, 0xC8E416C3EF1DF20Bu,
+        0x032C99C1EE5BB5C2u, 0x6BEECC0D88AA2266u, 0x4981647BB356E532u, 0x0CB05E239F71EE2Fu,
+        0x461DA399C27CBEDFu, 0x38D1FA45AC872B7Du, 0xE2A0217C3EBF819Eu, 0xA67E6C90485A1236u,
+        0xF4AE2D6C36B58398u, 0xF5415AD86C771B2Du, 0x622A247038360E12u, 0x60E9CA058CAF2365u,
+        0xF9F104FBF306F502u, 0xDDC68312094C45CFu, 0x76E7C61584A52163u, 0x71509E3E1FD1CE4Fu,
+        0xA9E2AB72397049DBu, 0x09C4E87DB09C2C74u, 0x8DD52C9BC33AF916u, 0x54886E63BF59E637u,
+        0x1E2593D9E254B6C7u, 0x25D8F05DA0882878u, 0x816572B85C4B1739u, 0xFFA92B6432B0829Bu,
+        0xFE465CD068721A2Eu, 0xAC961D2C169D8B80u, 0xBCC03EA3DF21FE1Fu, 0xA7911B2412988A83u,
+        0x533F3648242D091Bu, 0x40458C0603CAC946u, 0xD8B2354C26A18794u, 0x98F7B94A256B4ED2u,
+        0x659D7C5BA342E13Eu, 0x1FCAE46DB8962E72u, 0x42866273B753E431u, 0x6E9A7A53A747E03Du,
+        0x2BAB400B8B60EB20u, 0x59D747F47AEA90ADu, 0xB85BFF49AA0EA4F1u, 0xD25A44F078661E22u,
+        0xCEBC395C2EAB8592u, 0x873D5D279DFD60A0u, 0x0000000000000000u, 0x5AFBDE3594B1256Fu,
+        0xF2F602F3F703F401u, 0xD5ED1CDBE312F10Eu, 0x75CB5FD46AFE94A1u, 0x45313A582C270B1Du,
+        0x5F8F686BBB5CE734u, 0x1056238FC9BC759Fu, 0x07B7582B9B74EF2Cu, 0xE18CB8BDD0E4345Cu,
+        0xC697A695C4F53153u, 0x8F16C2EE77A3D461u, 0xA30ADACE67B7D06Du, 0xD3B5334422A48697u,
+        0x556719D7E59B7E82u, 0xEB64C9018E23ADEAu, 0xA1C934BBD32EFD1Au, 0x2EDFF655A48D297Bu,
+        0xCD90A09DC0F03050u, 0x88A19AC5ECD73B4Du, 0x30FA658C46D99FBCu, 0x86D22A93C73FF815u,
+        0x2968AE7E3FF9C657u, 0xAD796A984C5F1335u, 0x3A121430181E060Au, 0x271B1E281411050Fu,
+        0x3461A46633F6C552u, 0xBB77668844551133u, 0x06582F9FC1B67799u, 0x436915C7ED917C84u,
+        0x797B01F7F58F7A8Eu, 0x6F750DE7FD857888u, 0xF782B4ADD8EE365Au, 0xC45448E0706C1C24u,
+        0x9EAF96D5E4DD394Bu, 0x1992CBF2792059EBu, 0xE84850C060781828u, 0x70BFE98A451356FAu,
+        0x393E8DF1F645B3C8u, 0x243787E9FA4AB0CDu, 0x51FCD83D90B4246Cu, 0x7DE0C01D80A02060u,
+        0x32398BF9F240B2CBu, 0x4FD94BE472E092ABu, 0x894EED71B615A3F8u, 0x137ABA4E27E7C05Du,
+        0xD6C1851A0D4944CCu, 0x9133513795F762A6u, 0xB070608040501030u, 0x082B9FC9EA5EB4C1u,
+        0xC5BB3F542AAE8491u, 0xE7D49722115243C5u, 0x44DE4DEC76E593A8u, 0x0574B65E2FEDC25Bu,
+        0xB4EBA16A357F4ADEu, 0x5B14A981CE73BDDAu, 0x808A050C06898F8Cu, 0x02C3EE75B4992D77u,
+        0x5013AF89CA76BCD9u, 0x2DF36F944AD69CB9u, 0xC90B6177B5DF6ABEu, 0xFADD9D3A1D5D40C0u,
+        0x7A5798361BD4CF4Cu, 0x8249EB79B210A2FBu, 0xE9A727743ABA809Du, 0x93F0BF42216E4FD1u,
+        0xD95D42F87C631F21u, 0x5D4C861E0FC5CA43u, 0xDA71DB399238AAE3u, 0xECD3912A155742C6u,
+    },
+    {
+        0xB9BB016AD3BA68D2u, 0x9AE5B166FC54194Du, 0x65E2CD14712F93BCu, 0x8725511B9C74B9CDu,
+        0xA2F7A457F5530251u, 0xD6D003BE68D3B86Bu, 0xDED604B56BD2BD6Fu, 0x52B3FE85D74D6429u,
+        0xBAFDAD4AF0500D5Du, 0x09CF63E0E9AC268Au, 0x1C0984968A8D830Eu, 0x91A51A4DDCBF79C6u,
+        0xA73D4D379070ADDDu, 0xAAF1A35CF6520755u, 0xA47BE117B39AC852u, 0x5AB5F98ED44C612Du,
+        0x0346AC2023EA658Fu, 0xE6C4118462D5A673u, 0xCC55C268A497F166u, 0xC6DC0DA86ED1B263u,
+        0x85AA99D05533FFCCu, 0xB2FBAA41F3510859u, 0xE2C79C0FED5B2A71u, 0x59F355AEF7A604A2u,
+        0xBEFE20C17FDE815Fu, 0x7AADE5A2D848753Du, 0x29D77FCCE5A8329Au, 0xBC71E80AB699C75Eu,
+        0x96E03BE670DB904Bu, 0x8DAC9EDB5632FAC8u, 0xD1952215C4B751E6u, 0xB332CEAA19FC2BD7u,
+        0x4B70937338E348ABu, 0x8463FD3BBF9EDC42u, 0xFC41D052AE91EF7Eu, 0xAC7DE61CB09BCD56u,
+        0x437694783BE24DAFu, 0xB1BD0661D0BB6DD6u, 0x329BDAF1C3415819u, 0x577917E5B26ECBA5u,
+        0x41F95CB3F2A50BAEu, 0x16804B5640CBC00Bu, 0x7F670CC2BD6BDAB1u, 0xDC59CC7EA295FB6Eu,
+        0x61E1409FFEA11FBEu, 0xCB10E3C308F318EBu, 0xE181302FCEB14FFEu, 0x100C0E1606020A08u,
+        0x2E925E6749CCDB17u, 0x6EA2663F51C4F337u, 0xE84E53CF271D6974u, 0xA0786C9C3C144450u,
+        0x56B0730E58C3E82Bu, 0x3F57349AA563F291u, 0x9EE63CED73DA954Fu, 0xD2D38E35E75D3469u,
+        0xC2DF8023E15F3E61u, 0xAEF22ED779DC8B57u, 0xCF136E48877D94E9u, 0x2694596C4ACDDE13u,
+        0xDF1F605E817F9EE1u, 0xEAC19B04EE5A2F75u, 0x477519F3B46CC1ADu, 0xDAD5893EE45C316Du,
+        0xEB08FFEF04F70CFBu, 0x2DD4F2476A26BE98u, 0xAB38C7B71CFF24DBu, 0x3B54B9112AED7E93u,
+        0x134AA23625E86F87u, 0x9C69F426BA9DD34Eu, 0x5F7F10EEB16FCEA1u, 0x04038D8B8F8E8C02u,
+        0xC8564FE32B197D64u, 0x69E74794FDA01ABAu, 0xD31AEADE0DF017E7u, 0x3C1198BA8689971Eu,
+        0x78222D69110F333Cu, 0x3812153109071B1Cu, 0x11C56AFDECAF2986u, 0x8B20DB9B10FB30CBu,
+        0x4030385818082820u, 0xA87E6B973F154154u, 0x682E237F170D3934u, 0x20181C2C0C041410u,
+        0x0806070B03010504u, 0x074521ABAC64E98Du, 0xB6F827CA7CDF845Bu, 0x97295F0D9A76B3C5u,
+        0xEF0B72648B7980F9u, 0xA6F429DC7ADD8E53u, 0xF58EB3B2473DC9F4u, 0xB074628A3A164E58u,
+        0xE582BDA4413FC3FCu, 0xA5B285FC5937EBDCu, 0x4F731EF8B76DC4A9u, 0xDD90A8954838D8E0u,
+        0xA1B10877D6B967DEu, 0xBF37442A9573A2D1u, 0x1B4CA53D26E96A83u, 0xB5BE8BEA5F35E1D4u,
+        0x92E3B66DFF551C49u, 0xAF3B4A3C9371A8D9u, 0xFF077C728D7B8AF1u, 0x140F839D898C860Au,
+        0xB73143219672A7D5u, 0x34179FB18588921Au, 0xE30EF8E407F609FFu, 0x4DFCD6337E2A82A8u,
+        0xED84BAAF423EC6F8u, 0xCAD98728E25E3B65u, 0x25D2F54C6927BB9Cu, 0x0A89CFC0CA464305u,
+        0x60282474140C3C30u, 0x0F4326A0AF65EC89u, 0x676D05DFB868D5BDu, 0x2F5B3A8CA361F899u,
+        0x180A091D05030F0Cu, 0x46BC7D185EC1E223u, 0x82EFB87BF9571641u, 0xFECE189967D6A97Fu,
+        0x86EC35F076D99A43u, 0xFACD9512E858257Du, 0x8EEA32FB75D89F47u, 0x17492FBDAA66E385u,
+        0xF6C81F9264D7AC7Bu, 0xCD9CA6834E3AD2E8u, 0x0E8A424B45C8CF07u, 0xFD88B4B9443CCCF0u,
+        0x8326DC9013FA35CFu, 0xC453C563A796F462u, 0x51F552A5F4A701A6u, 0xB477EF01B598C25Au,
+        0x3352BE1A29EC7B97u, 0xA9B70F7CD5B862DAu, 0x76A86F2254C7FC3Bu, 0x19C36DF6EFAE2C82u,
+        0x6F6B02D4BB69D0B9u, 0x62A7ECBFDD4B7A31u, 0x31DD76D1E0AB3D96u, 0x21D178C7E6A9379Eu,
+        0x1F4F28B6A967E681u, 0x503C364E1E0A2228u, 0x028FC8CBC9474601u, 0xC316E4C80BF21DEFu,
+        0xC1992C03C2B55BEEu, 0x0DCCEE6B6622AA88u, 0x7B64814932E556B3u, 0x235EB00C2FEE719Fu,
+        0x99A31D46DFBE7CC2u, 0x45FAD1387D2B87ACu, 0x7C21A0E29E81BF3Eu, 0x906C7EA636125A48u,
+        0x6C2DAEF49883B536u, 0xD85A41F52D1B776Cu, 0x70242A62120E3638u, 0x05CAE9606523AF8Cu,
+        0xFB04F1F902F506F3u, 0x1283C6DDCF454C09u, 0x15C6E7766321A584u, 0x3E9E50714FCED11Fu,
+        0x72ABE2A9DB497039u, 0x7DE8C409742C9CB0u, 0x9B2CD58D16F93AC3u, 0x636E885437E659BFu,
+        0xD993251EC7B654E2u, 0x5DF0D825782888A0u, 0xB872658139174B5Cu, 0x642BA9FF9B82B032u,
+        0xD05C46FE2E1A7268u, 0x2C1D96AC808B9D16u, 0xA33EC0BC1FFE21DFu, 0x241B91A7838A9812u,
+        0x48363F531B092D24u, 0x068C454046C9CA03u, 0x4C35B2D89487A126u, 0x4AB9F798D24E6B25u,
+        0x5B7C9D653EE142A3u, 0x6DE4CA1F722E96B8u, 0x7362864231E453B7u, 0x537A9A6E3DE047A7u,
+        0x0B40AB2B20EB608Bu, 0xF447D759AD90EA7Au, 0x49FF5BB8F1A40EAAu, 0xF0445AD2221E6678u,
+        0x5C39BCCE9285AB2Eu, 0x275D3D87A060FD9Du, 0x0000000000000000u, 0x35DEFB5A6F25B194u,
+        0xF302F6F201F403F7u, 0xDB1CEDD50EF112E3u, 0xD45FCB75A194FE6Au, 0x583A31451D0B272Cu,
+        0x6B688F5F34E75CBBu, 0x8F2356109F75BCC9u, 0x2B58B7072CEF749Bu, 0xBDB88CE15C34E4D0u,
+        0x95A697C65331F5C4u, 0xEEC2168F61D4A377u, 0xCEDA0AA36DD0B767u, 0x4433B5D39786A422u,
+        0xD7196755827E9BE5u, 0x01C964EBEAAD238Eu, 0xBB34C9A11AFD2ED3u, 0x55F6DF2E7B298DA4u,
+        0x9DA090CD5030F0C0u, 0xC59AA1884D3BD7ECu, 0x8C65FA30BC9FD946u, 0x932AD28615F83FC7u,
+        0x7EAE682957C6F93Fu, 0x986A79AD35135F4Cu, 0x3014123A0A061E18u, 0x281E1B270F051114u,
+        0x66A4613452C5F633u, 0x886677BB33115544u, 0x9F2F58069977B6C1u, 0xC7156943847C91EDu,
+        0xF7017B798E7A8FF5u, 0xE70D756F887885FDu, 0xADB482F75A36EED8u, 0xE04854C4241C6C70u,
+        0xD596AF9E4B39DDE4u, 0xF2CB9219EB592079u, 0xC05048E828187860u, 0x8AE9BF70FA561345u,
+        0xF18D3E39C8B345F6u, 0xE9873724CDB04AFAu, 0x3DD8FC516C24B490u, 0x1DC0E07D6020A080u,
+        0xF98B3932CBB240F2u, 0xE44BD94FAB92E072u, 0x71ED4E89F8A315B6u, 0x4EBA7A135DC0E727u,
+        0x1A85C1D6CC44490Du, 0x37513391A662F795u, 0x806070B030105040u, 0xC99F2B08C1B45EEAu,
+        0x543FBBC59184AE2Au, 0x2297D4E7C5435211u, 0xEC4DDE44A893E576u, 0x5EB674055BC2ED2Fu,
+        0x6AA1EBB4DE4A7F35u, 0x81A9145BDABD73CEu, 0x0C058A808C8F8906u, 0x75EEC302772D99B4u,
+        0x89AF1350D9BC76CAu, 0x946FF32DB99CD64Au, 0x77610BC9BE6ADFB5u, 0x3A9DDDFAC0405D1Du,
+        0x3698577A4CCFD41Bu, 0x79EB4982FBA210B2u, 0x7427A7E99D80BA3Au, 0x42BFF093D14F6E21u,
+        0xF8425DD9211F637Cu, 0x1E864C5D43CAC50Fu, 0x39DB71DAE3AA3892u, 0x2A91D3ECC6425715u,
+    },
+    {
+        0xBBB96A01BAD3D268u, 0xE59A66B154FC4D19u, 0xE26514CD2F71BC93u, 0x25871B51749CCDB9u,
+        0xF7A257A453F55102u, 0xD0D6BE03D3686BB8u, 0xD6DEB504D26B6FBDu, 0xB35285FE4DD72964u,
+        0xFDBA4AAD50F05D0Du, 0xCF09E063ACE98A26u, 0x091C96848D8A0E83u, 0xA5914D1ABFDCC679u,
+        0x3DA7374D7090DDADu, 0xF1AA5CA352F65507u, 0x7BA417E19AB352C8u, 0xB55A8EF94CD42D61u,
+        0x460320ACEA238F65u, 0xC4E68411D56273A6u, 0x55CC68C297A466F1u, 0xDCC6A80DD16E63B2u,
+        0xAA85D0993355CCFFu, 0xFBB241AA51F35908u, 0xC7E20F9C5BED712Au, 0xF359AE55A6F7A204u,
+        0xFEBEC120DE7F5F81u, 0xAD7AA2E548D83D75u, 0xD729CC7FA8E59A32u, 0x71BC0AE899B65EC7u,
+        0xE096E63BDB704B90u, 0xAC8DDB9E3256C8FAu, 0x95D11522B7C4E651u, 0x32B3AACEFC19D72Bu,
+        0x704B7393E338AB48u, 0x63843BFD9EBF42DCu, 0x41FC52D091AE7EEFu, 0x7DAC1CE69BB056CDu,
+        0x76437894E23BAF4Du, 0xBDB16106BBD0D66Du, 0x9B32F1DA41C31958u, 0x7957E5176EB2A5CBu,
+        0xF941B35CA5F2AE0Bu, 0x8016564BCB400BC0u, 0x677FC20C6BBDB1DAu, 0x59DC7ECC95A26EFBu,
+        0xE1619F40A1FEBE1Fu, 0x10CBC3E3F308EB18u, 0x81E12F30B1CEFE4Fu, 0x0C10160E0206080Au,
+        0x922E675ECC4917DBu, 0xA26E3F66C45137F3u, 0x4EE8CF531D277469u, 0x78A09C6C143C5044u,
+        0xB0560E73C3582BE8u, 0x573F9A3463A591F2u, 0xE69EED3CDA734F95u, 0xD3D2358E5DE76934u,
+        0xDFC223805FE1613Eu, 0xF2AED72EDC79578Bu, 0x13CF486E7D87E994u, 0x94266C59CD4A13DEu,
+        0x1FDF5E607F81E19Eu, 0xC1EA049B5AEE752Fu, 0x7547F3196CB4ADC1u, 0xD5DA3E895CE46D31u,
+        0x08EBEFFFF704FB0Cu, 0xD42D47F2266A98BEu, 0x38ABB7C7FF1CDB24u, 0x543B11B9ED2A937Eu,
+        0x4A1336A2E825876Fu, 0x699C26F49DBA4ED3u, 0x7F5FEE106FB1A1CEu, 0x03048B8D8E8F028Cu,
+        0x56C8E34F192B647Du, 0xE7699447A0FDBA1Au, 0x1AD3DEEAF00DE717u, 0x113CBA9889861E97u,
+        0x2278692D0F113C33u, 0x1238311507091C1Bu, 0xC511FD6AAFEC8629u, 0x208B9BDBFB10CB30u,
+        0x3040583808182028u, 0x7EA8976B153F5441u, 0x2E687F230D173439u, 0x18202C1C040C1014u,
+        0x06080B0701030405u, 0x4507AB2164AC8DE9u, 0xF8B6CA27DF7C5B84u, 0x29970D5F769AC5B3u,
+        0x0BEF6472798BF980u, 0xF4A6DC29DD7A538Eu, 0x8EF5B2B33D47F4C9u, 0x74B08A62163A584Eu,
+        0x82E5A4BD3F41FCC3u, 0xB2A5FC853759DCEBu, 0x734FF81E6DB7A9C4u, 0x90DD95A83848E0D8u,
+        0xB1A17708B9D6DE67u, 0x37BF2A447395D1A2u, 0x4C1B3DA5E926836Au, 0xBEB5EA8B355FD4E1u,
+        0xE3926DB655FF491Cu, 0x3BAF3C4A7193D9A8u, 0x07FF727C7B8DF18Au, 0x0F149D838C890A86u,
+        0x31B721437296D5A7u, 0x1734B19F88851A92u, 0x0EE3E4F8F607FF09u, 0xFC4D33D62A7EA882u,
+        0x84EDAFBA3E42F8C6u, 0xD9CA28875EE2653Bu, 0xD2254CF527699CBBu, 0x890AC0CF46CA0543u,
+        0x286074240C14303Cu, 0x430FA02665AF89ECu, 0x6D67DF0568B8BDD5u, 0x5B2F8C3A61A399F8u,
+        0x0A181D0903050C0Fu, 0xBC46187DC15E23E2u, 0xEF827BB857F94116u, 0xCEFE9918D6677FA9u,
+        0xEC86F035D976439Au, 0xCDFA129558E87D25u, 0xEA8EFB32D875479Fu, 0x4917BD2F66AA85E3u,
+        0xC8F6921FD7647BACu, 0x9CCD83A63A4EE8D2u, 0x8A0E4B42C84507CFu, 0x88FDB9B43C44F0CCu,
+        0x268390DCFA13CF35u, 0x53C463C596A762F4u, 0xF551A552A7F4A601u, 0x77B401EF98B55AC2u,
+        0x52331ABEEC29977Bu, 0xB7A97C0FB8D5DA62u, 0xA876226FC7543BFCu, 0xC319F66DAEEF822Cu,
+        0x6B6FD40269BBB9D0u, 0xA762BFEC4BDD317Au, 0xDD31D176ABE0963Du, 0xD121C778A9E69E37u,
+        0x4F1FB62867A981E6u, 0x3C504E360A1E2822u, 0x8F02CBC847C90146u, 0x16C3C8E4F20BEF1Du,
+        0x99C1032CB5C2EE5Bu, 0xCC0D6BEE226688AAu, 0x647B4981E532B356u, 0x5E230CB0EE2F9F71u,
+        0xA399461DBEDFC27Cu, 0xFA4538D12B7DAC87u, 0x217CE2A0819E3EBFu, 0x6C90A67E1236485Au,
+        0x2D6CF4AE839836B5u, 0x5AD8F5411B2D6C77u, 0x2470622A0E123836u, 0xCA0560E923658CAFu,
+        0x04FBF9F1F502F306u, 0x8312DDC645CF094Cu, 0xC61576E7216384A5u, 0x9E3E7150CE4F1FD1u,
+        0xAB72A9E249DB3970u, 0xE87D09C42C74B09Cu, 0x2C9B8DD5F916C33Au, 0x6E635488E637BF59u,
+        0x93D91E25B6C7E254u, 0xF05D25D82878A088u, 0x72B8816517395C4Bu, 0x2B64FFA9829B32B0u,
+        0x5CD0FE461A2E6872u, 0x1D2CAC968B80169Du, 0x3EA3BCC0FE1FDF21u, 0x1B24A7918A831298u,
+        0x3648533F091B242Du, 0x8C064045C94603CAu, 0x354CD8B2879426A1u, 0xB94A98F74ED2256Bu,
+        0x7C5B659DE13EA342u, 0xE46D1FCA2E72B896u, 0x62734286E431B753u, 0x7A536E9AE03DA747u,
+        0x400B2BABEB208B60u, 0x47F459D790AD7AEAu, 0xFF49B85BA4F1AA0Eu, 0x44F0D25A1E227866u,
+        0x395CCEBC85922EABu, 0x5D27873D60A09DFDu, 0x0000000000000000u, 0xDE355AFB256F94B1u,
+        0x02F3F2F6F401F703u, 0x1CDBD5EDF10EE312u, 0x5FD475CB94A16AFEu, 0x3A5845310B1D2C27u,
+        0x686B5F8FE734BB5Cu, 0x238F1056759FC9BCu, 0x582B07B7EF2C9B74u, 0xB8BDE18C345CD0E4u,
+        0xA695C6973153C4F5u, 0xC2EE8F16D46177A3u, 0xDACEA30AD06D67B7u, 0x3344D3B5869722A4u,
+        0x19D755677E82E59Bu, 0xC901EB64ADEA8E23u, 0x34BBA1C9FD1AD32Eu, 0xF6552EDF297BA48Du,
+        0xA09DCD903050C0F0u, 0x9AC588A13B4DECD7u, 0x658C30FA9FBC46D9u, 0x2A9386D2F815C73Fu,
+        0xAE7E2968C6573FF9u, 0x6A98AD7913354C5Fu, 0x14303A12060A181Eu, 0x1E28271B050F1411u,
+        0xA4663461C55233F6u, 0x6688BB7711334455u, 0x2F9F06587799C1B6u, 0x15C743697C84ED91u,
+        0x01F7797B7A8EF58Fu, 0x0DE76F757888FD85u, 0xB4ADF782365AD8EEu, 0x48E0C4541C24706Cu,
+        0x96D59EAF394BE4DDu, 0xCBF2199259EB7920u, 0x50C0E84818286078u, 0xE98A70BF56FA4513u,
+        0x8DF1393EB3C8F645u, 0x87E92437B0CDFA4Au, 0xD83D51FC246C90B4u, 0xC01D7DE0206080A0u,
+        0x8BF93239B2CBF240u, 0x4BE44FD992AB72E0u, 0xED71894EA3F8B615u, 0xBA4E137AC05D27E7u,
+        0x851AD6C144CC0D49u, 0x5137913362A695F7u, 0x6080B07010304050u, 0x9FC9082BB4C1EA5Eu,
+        0x3F54C5BB84912AAEu, 0x9722E7D443C51152u, 0x4DEC44DE93A876E5u, 0xB65E0574C25B2FEDu,
+        0xA16AB4EB4ADE357Fu, 0xA9815B14BDDACE73u, 0x050C808A8F8C0689u, 0xEE7502C32D77B499u,
+        0xAF895013BCD9CA76u, 0x6F942DF39CB94AD6u, 0x6177C90B6ABEB5DFu, 0x9D3AFADD40C01D5Du,
+        0x98367A57CF4C1BD4u, 0xEB798249A2FBB210u, 0x2774E9A7809D3ABAu, 0xBF4293F04FD1216Eu,
+        0x42F8D95D1F217C63u, 0x861E5D4CCA430FC5u, 0xDB39DA71AAE39238u, 0x912AECD342C61557u,
+    },
+    {
+        0x68D2D3BA016AB9BBu, 0x194DFC54B1669AE5u, 0x93BC712FCD1465E2u, 0xB9CD9C74511B8725u,
+        0x0251F553A457A2F7u, 0xB86B68D303BED6D0u, 0xBD6F6BD204B5DED6u, 0x6429D74DFE8552B3u,
+        0x0D5DF050AD4ABAFDu, 0x268AE9AC63E009CFu, 0x830E8A8D84961C09u, 0x79C6DCBF1A4D91A5u,
+        0xADDD90704D37A73Du, 0x0755F652A35CAAF1u, 0xC852B39AE117A47Bu, 0x612DD44CF98E5AB5u,
+        0x658F23EAAC200346u, 0xA67362D51184E6C4u, 0xF166A497C268CC55u, 0xB2636ED10DA8C6DCu,
+        0xFFCC553399D085AAu, 0x0859F351AA41B2FBu, 0x2A71ED5B9C0FE2C7u, 0x04A2F7A655AE59F3u,
+        0x815F7FDE20C1BEFEu, 0x753DD848E5A27AADu, 0x329AE5A87FCC29D7u, 0xC75EB699E80ABC71u,
+        0x904B70DB3BE696E0u, 0xFAC856329EDB8DACu, 0x51E6C4B72215D195u, 0x2BD719FCCEAAB332u,
+        0x48AB38E393734B70u, 0xDC42BF9EFD3B8463u, 0xEF7EAE91D052FC41u, 0xCD56B09BE61CAC7Du,
+        0x4DAF3BE294784376u, 0x6DD6D0BB0661B1BDu, 0x5819C341DAF1329Bu, 0xCBA5B26E17E55779u,
+        0x0BAEF2A55CB341F9u, 0xC00B40CB4B561680u, 0xDAB1BD6B0CC27F67u, 0xFB6EA295CC7EDC59u,
+        0x1FBEFEA1409F61E1u, 0x18EB08F3E3C3CB10u, 0x4FFECEB1302FE181u, 0x0A0806020E16100Cu,
+        0xDB1749CC5E672E92u, 0xF33751C4663F6EA2u, 0x6974271D53CFE84Eu, 0x44503C146C9CA078u,
+        0xE82B58C3730E56B0u, 0xF291A563349A3F57u, 0x954F73DA3CED9EE6u, 0x3469E75D8E35D2D3u,
+        0x3E61E15F8023C2DFu, 0x8B5779DC2ED7AEF2u, 0x94E9877D6E48CF13u, 0xDE134ACD596C2694u,
+        0x9EE1817F605EDF1Fu, 0x2F75EE5A9B04EAC1u, 0xC1ADB46C19F34775u, 0x316DE45C893EDAD5u,
+        0x0CFB04F7FFEFEB08u, 0xBE986A26F2472DD4u, 0x24DB1CFFC7B7AB38u, 0x7E932AEDB9113B54u,
+        0x6F8725E8A236134Au, 0xD34EBA9DF4269C69u, 0xCEA1B16F10EE5F7Fu, 0x8C028F8E8D8B0403u,
+        0x7D642B194FE3C856u, 0x1ABAFDA0479469E7u, 0x17E70DF0EADED31Au, 0x971E868998BA3C11u,
+        0x333C110F2D697822u, 0x1B1C090715313812u, 0x2986ECAF6AFD11C5u, 0x30CB10FBDB9B8B20u,
+        0x2820180838584030u, 0x41543F156B97A87Eu, 0x3934170D237F682Eu, 0x14100C041C2C2018u,
+        0x05040301070B0806u, 0xE98DAC6421AB0745u, 0x845B7CDF27CAB6F8u, 0xB3C59A765F0D9729u,
+        0x80F98B797264EF0Bu, 0x8E537ADD29DCA6F4u, 0xC9F4473DB3B2F58Eu, 0x4E583A16628AB074u,
+        0xC3FC413FBDA4E582u, 0xEBDC593785FCA5B2u, 0xC4A9B76D1EF84F73u, 0xD8E04838A895DD90u,
+        0x67DED6B90877A1B1u, 0xA2D19573442ABF37u, 0x6A8326E9A53D1B4Cu, 0xE1D45F358BEAB5BEu,
+        0x1C49FF55B66D92E3u, 0xA8D993714A3CAF3Bu, 0x8AF18D7B7C72FF07u, 0x860A898C839D140Fu,
+        0xA7D596724321B731u, 0x921A85889FB13417u, 0x09FF07F6F8E4E30Eu, 0x82A87E2AD6334DFCu,
+        0xC6F8423EBAAFED84u, 0x3B65E25E8728CAD9u, 0xBB9C6927F54C25D2u, 0x4305CA46CFC00A89u,
+        0x3C30140C24746028u, 0xEC89AF6526A00F43u, 0xD5BDB86805DF676Du, 0xF899A3613A8C2F5Bu,
+        0x0F0C0503091D180Au, 0xE2235EC17D1846BCu, 0x1641F957B87B82EFu, 0xA97F67D61899FECEu,
+        0x9A4376D935F086ECu, 0x257DE8589512FACDu, 0x9F4775D832FB8EEAu, 0xE385AA662FBD1749u,
+        0xAC7B64D71F92F6C8u, 0xD2E84E3AA683CD9Cu, 0xCF0745C8424B0E8Au, 0xCCF0443CB4B9FD88u,
+        0x35CF13FADC908326u, 0xF462A796C563C453u, 0x01A6F4A752A551F5u, 0xC25AB598EF01B477u,
+        0x7B9729ECBE1A3352u, 0x62DAD5B80F7CA9B7u, 0xFC3B54C76F2276A8u, 0x2C82EFAE6DF619C3u,
+        0xD0B9BB6902D46F6Bu, 0x7A31DD4BECBF62A7u, 0x3D96E0AB76D131DDu, 0x379EE6A978C721D1u,
+        0xE681A96728B61F4Fu, 0x22281E0A364E503Cu, 0x4601C947C8CB028Fu, 0x1DEF0BF2E4C8C316u,
+        0x5BEEC2B52C03C199u, 0xAA886622EE6B0DCCu, 0x56B332E581497B64u, 0x719F2FEEB00C235Eu,
+        0x7CC2DFBE1D4699A3u, 0x87AC7D2BD13845FAu, 0xBF3E9E81A0E27C21u, 0x5A4836127EA6906Cu,
+        0xB5369883AEF46C2Du, 0x776C2D1B41F5D85Au, 0x3638120E2A627024u, 0xAF8C6523E96005CAu,
+        0x06F302F5F1F9FB04u, 0x4C09CF45C6DD1283u, 0xA5846321E77615C6u, 0xD11F4FCE50713E9Eu,
+        0x7039DB49E2A972ABu, 0x9CB0742CC4097DE8u, 0x3AC316F9D58D9B2Cu, 0x59BF37E68854636Eu,
+        0x54E2C7B6251ED993u, 0x88A07828D8255DF0u, 0x4B5C39176581B872u, 0xB0329B82A9FF642Bu,
+        0x72682E1A46FED05Cu, 0x9D16808B96AC2C1Du, 0x21DF1FFEC0BCA33Eu, 0x9812838A91A7241Bu,
+        0x2D241B093F534836u, 0xCA0346C94540068Cu, 0xA1269487B2D84C35u, 0x6B25D24EF7984AB9u,
+        0x42A33EE19D655B7Cu, 0x96B8722ECA1F6DE4u, 0x53B731E486427362u, 0x47A73DE09A6E537Au,
+        0x608B20EBAB2B0B40u, 0xEA7AAD90D759F447u, 0x0EAAF1A45BB849FFu, 0x6678221E5AD2F044u,
+        0xAB2E9285BCCE5C39u, 0xFD9DA0603D87275Du, 0x0000000000000000u, 0xB1946F25FB5A35DEu,
+        0x03F701F4F6F2F302u, 0x12E30EF1EDD5DB1Cu, 0xFE6AA194CB75D45Fu, 0x272C1D0B3145583Au,
+        0x5CBB34E78F5F6B68u, 0xBCC99F7556108F23u, 0x749B2CEFB7072B58u, 0xE4D05C348CE1BDB8u,
+        0xF5C4533197C695A6u, 0xA37761D4168FEEC2u, 0xB7676DD00AA3CEDAu, 0xA4229786B5D34433u,
+        0x9BE5827E6755D719u, 0x238EEAAD64EB01C9u, 0x2ED31AFDC9A1BB34u, 0x8DA47B29DF2E55F6u,
+        0xF0C0503090CD9DA0u, 0xD7EC4D3BA188C59Au, 0xD946BC9FFA308C65u, 0x3FC715F8D286932Au,
+        0xF93F57C668297EAEu, 0x5F4C351379AD986Au, 0x1E180A06123A3014u, 0x11140F051B27281Eu,
+        0xF63352C5613466A4u, 0x5544331177BB8866u, 0xB6C1997758069F2Fu, 0x91ED847C6943C715u,
+        0x8FF58E7A7B79F701u, 0x85FD8878756FE70Du, 0xEED85A3682F7ADB4u, 0x6C70241C54C4E048u,
+        0xDDE44B39AF9ED596u, 0x2079EB599219F2CBu, 0x7860281848E8C050u, 0x1345FA56BF708AE9u,
+        0x45F6C8B33E39F18Du, 0x4AFACDB03724E987u, 0xB4906C24FC513DD8u, 0xA0806020E07D1DC0u,
+        0x40F2CBB23932F98Bu, 0xE072AB92D94FE44Bu, 0x15B6F8A34E8971EDu, 0xE7275DC07A134EBAu,
+        0x490DCC44C1D61A85u, 0xF795A66233913751u, 0x5040301070B08060u, 0x5EEAC1B42B08C99Fu,
+        0xAE2A9184BBC5543Fu, 0x5211C543D4E72297u, 0xE576A893DE44EC4Du, 0xED2F5BC274055EB6u,
+        0x7F35DE4AEBB46AA1u, 0x73CEDABD145B81A9u, 0x89068C8F8A800C05u, 0x99B4772DC30275EEu,
+        0x76CAD9BC135089AFu, 0xD64AB99CF32D946Fu, 0xDFB5BE6A0BC97761u, 0x5D1DC040DDFA3A9Du,
+        0xD41B4CCF577A3698u, 0x10B2FBA2498279EBu, 0xBA3A9D80A7E97427u, 0x6E21D14FF09342BFu,
+        0x637C211F5DD9F842u, 0xC50F43CA4C5D1E86u, 0x3892E3AA71DA39DBu, 0x5715C642D3EC2A91u,
+    },
+    {
+        0xD268BAD36A01BBB9u, 0x4D1954FC66B1E59Au, 0xBC932F7114CDE265u, 0xCDB9749C1B512587u,
+        0x510253F557A4F7A2u, 0x6BB8D368BE03D0D6u, 0x6FBDD26BB504D6DEu, 0x29644DD785FEB352u,
+        0x5D0D50F04AADFDBAu, 0x8A26ACE9E063CF09u, 0x0E838D8A9684091Cu, 0xC679BFDC4D1AA591u,
+        0xDDAD7090374D3DA7u, 0x550752F65CA3F1AAu, 0x52C89AB317E17BA4u, 0x2D614CD48EF9B55Au,
+        0x8F65EA2320AC4603u, 0x73A6D5628411C4E6u, 0x66F197A468C255CCu, 0x63B2D16EA80DDCC6u,
+        0xCCFF3355D099AA85u, 0x590851F341AAFBB2u, 0x712A5BED0F9CC7E2u, 0xA204A6F7AE55F359u,
+        0x5F81DE7FC120FEBEu, 0x3D7548D8A2E5AD7Au, 0x9A32A8E5CC7FD729u, 0x5EC799B60AE871BCu,
+        0x4B90DB70E63BE096u, 0xC8FA3256DB9EAC8Du, 0xE651B7C4152295D1u, 0xD72BFC19AACE32B3u,
+        0xAB48E3387393704Bu, 0x42DC9EBF3BFD6384u, 0x7EEF91AE52D041FCu, 0x56CD9BB01CE67DACu,
+        0xAF4DE23B78947643u, 0xD66DBBD06106BDB1u, 0x195841C3F1DA9B32u, 0xA5CB6EB2E5177957u,
+        0xAE0BA5F2B35CF941u, 0x0BC0CB40564B8016u, 0xB1DA6BBDC20C677Fu, 0x6EFB95A27ECC59DCu,
+        0xBE1FA1FE9F40E161u, 0xEB18F308C3E310CBu, 0xFE4FB1CE2F3081E1u, 0x080A0206160E0C10u,
+        0x17DBCC49675E922Eu, 0x37F3C4513F66A26Eu, 0x74691D27CF534EE8u, 0x5044143C9C6C78A0u,
+        0x2BE8C3580E73B056u, 0x91F263A59A34573Fu, 0x4F95DA73ED3CE69Eu, 0x69345DE7358ED3D2u,
+        0x613E5FE12380DFC2u, 0x578BDC79D72EF2AEu, 0xE9947D87486E13CFu, 0x13DECD4A6C599426u,
+        0xE19E7F815E601FDFu, 0x752F5AEE049BC1EAu, 0xADC16CB4F3197547u, 0x6D315CE43E89D5DAu,
+        0xFB0CF704EFFF08EBu, 0x98BE266A47F2D42Du, 0xDB24FF1CB7C738ABu, 0x937EED2A11B9543Bu,
+        0x876FE82536A24A13u, 0x4ED39DBA26F4699Cu, 0xA1CE6FB1EE107F5Fu, 0x028C8E8F8B8D0304u,
+        0x647D192BE34F56C8u, 0xBA1AA0FD9447E769u, 0xE717F00DDEEA1AD3u, 0x1E978986BA98113Cu,
+        0x3C330F11692D2278u, 0x1C1B070931151238u, 0x8629AFECFD6AC511u, 0xCB30FB109BDB208Bu,
+        0x2028081858383040u, 0x5441153F976B7EA8u, 0x34390D177F232E68u, 0x1014040C2C1C1820u,
+        0x040501030B070608u, 0x8DE964ACAB214507u, 0x5B84DF7CCA27F8B6u, 0xC5B3769A0D5F2997u,
+        0xF980798B64720BEFu, 0x538EDD7ADC29F4A6u, 0xF4C93D47B2B38EF5u, 0x584E163A8A6274B0u,
+        0xFCC33F41A4BD82E5u, 0xDCEB3759FC85B2A5u, 0xA9C46DB7F81E734Fu, 0xE0D8384895A890DDu,
+        0xDE67B9D67708B1A1u, 0xD1A273952A4437BFu, 0x836AE9263DA54C1Bu, 0xD4E1355FEA8BBEB5u,
+        0x491C55FF6DB6E392u, 0xD9A871933C4A3BAFu, 0xF18A7B8D727C07FFu, 0x0A868C899D830F14u,
+        0xD5A77296214331B7u, 0x1A928885B19F1734u, 0xFF09F607E4F80EE3u, 0xA8822A7E33D6FC4Du,
+        0xF8C63E42AFBA84EDu, 0x653B5EE22887D9CAu, 0x9CBB27694CF5D225u, 0x054346CAC0CF890Au,
+        0x303C0C1474242860u, 0x89EC65AFA026430Fu, 0xBDD568B8DF056D67u, 0x99F861A38C3A5B2Fu,
+        0x0C0F03051D090A18u, 0x23E2C15E187DBC46u, 0x411657F97BB8EF82u, 0x7FA9D6679918CEFEu,
+        0x439AD976F035EC86u, 0x7D2558E81295CDFAu, 0x479FD875FB32EA8Eu, 0x85E366AABD2F4917u,
+        0x7BACD764921FC8F6u, 0xE8D23A4E83A69CCDu, 0x07CFC8454B428A0Eu, 0xF0CC3C44B9B488FDu,
+        0xCF35FA1390DC2683u, 0x62F496A763C553C4u, 0xA601A7F4A552F551u, 0x5AC298B501EF77B4u,
+        0x977BEC291ABE5233u, 0xDA62B8D57C0FB7A9u, 0x3BFCC754226FA876u, 0x822CAEEFF66DC319u,
+        0xB9D069BBD4026B6Fu, 0x317A4BDDBFECA762u, 0x963DABE0D176DD31u, 0x9E37A9E6C778D121u,
+        0x81E667A9B6284F1Fu, 0x28220A1E4E363C50u, 0x014647C9CBC88F02u, 0xEF1DF20BC8E416C3u,
+        0xEE5BB5C2032C99C1u, 0x88AA22666BEECC0Du, 0xB356E5324981647Bu, 0x9F71EE2F0CB05E23u,
+        0xC27CBEDF461DA399u, 0xAC872B7D38D1FA45u, 0x3EBF819EE2A0217Cu, 0x485A1236A67E6C90u,
+        0x36B58398F4AE2D6Cu, 0x6C771B2DF5415AD8u, 0x38360E12622A2470u, 0x8CAF236560E9CA05u,
+        0xF306F502F9F104FBu, 0x094C45CFDDC68312u, 0x84A5216376E7C615u, 0x1FD1CE4F71509E3Eu,
+        0x397049DBA9E2AB72u, 0xB09C2C7409C4E87Du, 0xC33AF9168DD52C9Bu, 0xBF59E63754886E63u,
+        0xE254B6C71E2593D9u, 0xA088287825D8F05Du, 0x5C4B1739816572B8u, 0x32B0829BFFA92B64u,
+        0x68721A2EFE465CD0u, 0x169D8B80AC961D2Cu, 0xDF21FE1FBCC03EA3u, 0x12988A83A7911B24u,
+        0x242D091B533F3648u, 0x03CAC94640458C06u, 0x26A18794D8B2354Cu, 0x256B4ED298F7B94Au,
+        0xA342E13E659D7C5Bu, 0xB8962E721FCAE46Du, 0xB753E43142866273u, 0xA747E03D6E9A7A53u,
+        0x8B60EB202BAB400Bu, 0x7AEA90AD59D747F4u, 0xAA0EA4F1B85BFF49u, 0x78661E22D25A44F0u,
+        0x2EAB8592CEBC395Cu, 0x9DFD60A0873D5D27u, 0x0000000000000000u, 0x94B1256F5AFBDE35u,
+        0xF703F401F2F602F3u, 0xE312F10ED5ED1CDBu, 0x6AFE94A175CB5FD4u, 0x2C270B1D45313A58u,
+        0xBB5CE7345F8F686Bu, 0xC9BC759F1056238Fu, 0x9B74EF2C07B7582Bu, 0xD0E4345CE18CB8BDu,
+        0xC4F53153C697A695u, 0x77A3D4618F16C2EEu, 0x67B7D06DA30ADACEu, 0x22A48697D3B53344u,
+        0xE59B7E82556719D7u, 0x8E23ADEAEB64C901u, 0xD32EFD1AA1C934BBu, 0xA48D297B2EDFF655u,
+        0xC0F03050CD90A09Du, 0xECD73B4D88A19AC5u, 0x46D99FBC30FA658Cu, 0xC73FF81586D22A93u,
+        0x3FF9C6572968AE7Eu, 0x4C5F1335AD796A98u, 0x181E060A3A121430u, 0x1411050F271B1E28u,
+        0x33F6C5523461A466u, 0x44551133BB776688u, 0xC1B6779906582F9Fu, 0xED917C84436915C7u,
+        0xF58F7A8E797B01F7u, 0xFD8578886F750DE7u, 0xD8EE365AF782B4ADu, 0x706C1C24C45448E0u,
+        0xE4DD394B9EAF96D5u, 0x792059EB1992CBF2u, 0x60781828E84850C0u, 0x451356FA70BFE98Au,
+        0xF645B3C8393E8DF1u, 0xFA4AB0CD243787E9u, 0x90B4246C51FCD83Du, 0x80A020607DE0C01Du,
+        0xF240B2CB32398BF9u, 0x72E092AB4FD94BE4u, 0xB615A3F8894EED71u, 0x27E7C05D137ABA4Eu,
+        0x0D4944CCD6C1851Au, 0x95F762A691335137u, 0x40501030B0706080u, 0xEA5EB4C1082B9FC9u,
+        0x2AAE8491C5BB3F54u, 0x115243C5E7D49722u, 0x76E593A844DE4DECu, 0x2FEDC25B0574B65Eu,
+        0x357F4ADEB4EBA16Au, 0xCE73BDDA5B14A981u, 0x06898F8C808A050Cu, 0xB4992D7702C3EE75u,
+        0xCA76BCD95013AF89u, 0x4AD69CB92DF36F94u, 0xB5DF6ABEC90B6177u, 0x1D5D40C0FADD9D3Au,
+        0x1BD4CF4C7A579836u, 0xB210A2FB8249EB79u, 0x3ABA809DE9A72774u, 0x216E4FD193F0BF42u,
+        0x7C631F21D95D42F8u, 0x0FC5CA435D4C861Eu, 0x9238AAE3DA71DB39u, 0x155742C6ECD3912Au,
+    },
+    {
+        0xD3BA68D2B9BB016Au, 0xFC54194D9AE5B166u, 0x712F93BC65E2CD14u, 0x9C74B9CD8725511Bu,
+        0xF5530251A2F7A457u, 0x68D3B86BD6D003BEu, 0x6BD2BD6FDED604B5u, 0xD74D642952B3FE85u,
+        0xF0500D5DBAFDAD4Au, 0xE9AC268A09CF63E0u, 0x8A8D830E1C098496u, 0xDCBF79C691A51A4Du,
+        0x9070ADDDA73D4D37u, 0xF6520755AAF1A35Cu, 0xB39AC852A47BE117u, 0xD44C612D5AB5F98Eu,
+        0x23EA658F0346AC20u, 0x62D5A673E6C41184u, 0xA497F166CC55C268u, 0x6ED1B263C6DC0DA8u,
+        0x5533FFCC85AA99D0u, 0xF3510859B2FBAA41u, 0xED5B2A71E2C79C0Fu, 0xF7A604A259F355AEu,
+        0x7FDE815FBEFE20C1u, 0xD848753D7AADE5A2u, 0xE5A8329A29D77FCCu, 0xB699C75EBC71E80Au,
+        0x70DB904B96E03BE6u, 0x5632FAC88DAC9EDBu, 0xC4B751E6D1952215u, 0x19FC2BD7B332CEAAu,
+        0x38E348AB4B709373u, 0xBF9EDC428463FD3Bu, 0xAE91EF7EFC41D052u, 0xB09BCD56AC7DE61Cu,
+        0x3BE24DAF43769478u, 0xD0BB6DD6B1BD0661u, 0xC3415819329BDAF1u, 0xB26ECBA5577917E5u,
+        0xF2A50BAE41F95CB3u, 0x40CBC00B16804B56u, 0xBD6BDAB17F670CC2u, 0xA295FB6EDC59CC7Eu,
+        0xFEA11FBE61E1409Fu, 0x08F318EBCB10E3C3u, 0xCEB14FFEE181302Fu, 0x06020A08100C0E16u,
+        0x49CCDB172E925E67u, 0x51C4F3376EA2663Fu, 0x271D6974E84E53CFu, 0x3C144450A0786C9Cu,
+        0x58C3E82B56B0730Eu, 0xA563F2913F57349Au, 0x73DA954F9EE63CEDu, 0xE75D3469D2D38E35u,
+        0xE15F3E61C2DF8023u, 0x79DC8B57AEF22ED7u, 0x877D94E9CF136E48u, 0x4ACDDE132694596Cu,
+        0x817F9EE1DF1F605Eu, 0xEE5A2F75EAC19B04u, 0xB46CC1AD477519F3u, 0xE45C316DDAD5893Eu,
+        0x04F70CFBEB08FFEFu, 0x6A26BE982DD4F247u, 0x1CFF24DBAB38C7B7u, 0x2AED7E933B54B911u,
+        0x25E86F87134AA236u, 0xBA9DD34E9C69F426u, 0xB16FCEA15F7F10EEu, 0x8F8E8C0204038D8Bu,
+        0x2B197D64C8564FE3u, 0xFDA01ABA69E74794u, 0x0DF017E7D31AEADEu, 0x8689971E3C1198BAu,
+        0x110F333C78222D69u, 0x09071B1C38121531u, 0xECAF298611C56AFDu, 0x10FB30CB8B20DB9Bu,
+        0x1808282040303858u, 0x3F154154A87E6B97u, 0x170D3934682E237Fu, 0x0C04141020181C2Cu,
+        0x030105040806070Bu, 0xAC64E98D074521ABu, 0x7CDF845BB6F827CAu, 0x9A76B3C597295F0Du,
+        0x8B7980F9EF0B7264u, 0x7ADD8E53A6F429DCu, 0x473DC9F4F58EB3B2u, 0x3A164E58B074628Au,
+        0x413FC3FCE582BDA4u, 0x5937EBDCA5B285FCu, 0xB76DC4A94F731EF8u, 0x4838D8E0DD90A895u,
+        0xD6B967DEA1B10877u, 0x9573A2D1BF37442Au, 0x26E96A831B4CA53Du, 0x5F35E1D4B5BE8BEAu,
+        0xFF551C4992E3B66Du, 0x9371A8D9AF3B4A3Cu, 0x8D7B8AF1FF077C72u, 0x898C860A140F839Du,
+        0x9672A7D5B7314321u, 0x8588921A34179FB1u, 0x07F609FFE30EF8E4u, 0x7E2A82A84DFCD633u,
+        0x423EC6F8ED84BAAFu, 0xE25E3B65CAD98728u, 0x6927BB9C25D2F54Cu, 0xCA4643050A89CFC0u,
+        0x140C3C3060282474u, 0xAF65EC890F4326A0u, 0xB868D5BD676D05DFu, 0xA361F8992F5B3A8Cu,
+        0x05030F0C180A091Du, 0x5EC1E22346BC7D18u, 0xF957164182EFB87Bu, 0x67D6A97FFECE1899u,
+        0x76D99A4386EC35F0u, 0xE858257DFACD9512u, 0x75D89F478EEA32FBu, 0xAA66E38517492FBDu,
+        0x64D7AC7BF6C81F92u, 0x4E3AD2E8CD9CA683u, 0x45C8CF070E8A424Bu, 0x443CCCF0FD88B4B9u,
+        0x13FA35CF8326DC90u, 0xA796F462C453C563u, 0xF4A701A651F552A5u, 0xB598C25AB477EF01u,
+        0x29EC7B973352BE1Au, 0xD5B862DAA9B70F7Cu, 0x54C7FC3B76A86F22u, 0xEFAE2C8219C36DF6u,
+        0xBB69D0B96F6B02D4u, 0xDD4B7A3162A7ECBFu, 0xE0AB3D9631DD76D1u, 0xE6A9379E21D178C7u,
+        0xA967E6811F4F28B6u, 0x1E0A2228503C364Eu, 0xC9474601028FC8CBu, 0x0BF21DEFC316E4C8u,
+        0xC2B55BEEC1992C03u, 0x6622AA880DCCEE6Bu, 0x32E556B37B648149u, 0x2FEE719F235EB00Cu,
+        0xDFBE7CC299A31D46u, 0x7D2B87AC45FAD138u, 0x9E81BF3E7C21A0E2u, 0x36125A48906C7EA6u,
+        0x9883B5366C2DAEF4u, 0x2D1B776CD85A41F5u, 0x120E363870242A62u, 0x6523AF8C05CAE960u,
+        0x02F506F3FB04F1F9u, 0xCF454C091283C6DDu, 0x6321A58415C6E776u, 0x4FCED11F3E9E5071u,
+        0xDB49703972ABE2A9u, 0x742C9CB07DE8C409u, 0x16F93AC39B2CD58Du, 0x37E659BF636E8854u,
+        0xC7B654E2D993251Eu, 0x782888A05DF0D825u, 0x39174B5CB8726581u, 0x9B82B032642BA9FFu,
+        0x2E1A7268D05C46FEu, 0x808B9D162C1D96ACu, 0x1FFE21DFA33EC0BCu, 0x838A9812241B91A7u,
+        0x1B092D2448363F53u, 0x46C9CA03068C4540u, 0x9487A1264C35B2D8u, 0xD24E6B254AB9F798u,
+        0x3EE142A35B7C9D65u, 0x722E96B86DE4CA1Fu, 0x31E453B773628642u, 0x3DE047A7537A9A6Eu,
+        0x20EB608B0B40AB2Bu, 0xAD90EA7AF447D759u, 0xF1A40EAA49FF5BB8u, 0x221E6678F0445AD2u,
+        0x9285AB2E5C39BCCEu, 0xA060FD9D275D3D87u, 0x0000000000000000u, 0x6F25B19435DEFB5Au,
+        0x01F403F7F302F6F2u, 0x0EF112E3DB1CEDD5u, 0xA194FE6AD45FCB75u, 0x1D0B272C583A3145u,
+        0x34E75CBB6B688F5Fu, 0x9F75BCC98F235610u, 0x2CEF749B2B58B707u, 0x5C34E4D0BDB88CE1u,
+        0x5331F5C495A697C6u, 0x61D4A377EEC2168Fu, 0x6DD0B767CEDA0AA3u, 0x9786A4224433B5D3u,
+        0x827E9BE5D7196755u, 0xEAAD238E01C964EBu, 0x1AFD2ED3BB34C9A1u, 0x7B298DA455F6DF2Eu,
+        0x5030F0C09DA090CDu, 0x4D3BD7ECC59AA188u, 0xBC9FD9468C65FA30u, 0x15F83FC7932AD286u,
+        0x57C6F93F7EAE6829u, 0x35135F4C986A79ADu, 0x0A061E183014123Au, 0x0F051114281E1B27u,
+        0x52C5F63366A46134u, 0x33115544886677BBu, 0x9977B6C19F2F5806u, 0x847C91EDC7156943u,
+        0x8E7A8FF5F7017B79u, 0x887885FDE70D756Fu, 0x5A36EED8ADB482F7u, 0x241C6C70E04854C4u,
+        0x4B39DDE4D596AF9Eu, 0xEB592079F2CB9219u, 0x28187860C05048E8u, 0xFA5613458AE9BF70u,
+        0xC8B345F6F18D3E39u, 0xCDB04AFAE9873724u, 0x6C24B4903DD8FC51u, 0x6020A0801DC0E07Du,
+        0xCBB240F2F98B3932u, 0xAB92E072E44BD94Fu, 0xF8A315B671ED4E89u, 0x5DC0E7274EBA7A13u,
+        0xCC44490D1A85C1D6u, 0xA662F79537513391u, 0x30105040806070B0u, 0xC1B45EEAC99F2B08u,
+        0x9184AE2A543FBBC5u, 0xC54352112297D4E7u, 0xA893E576EC4DDE44u, 0x5BC2ED2F5EB67405u,
+        0xDE4A7F356AA1EBB4u, 0xDABD73CE81A9145Bu, 0x8C8F89060C058A80u, 0x772D99B475EEC302u,
+        0xD9BC76CA89AF1350u, 0xB99CD64A946FF32Du, 0xBE6ADFB577610BC9u, 0xC0405D1D3A9DDDFAu,
+        0x4CCFD41B3698577Au, 0xFBA210B279EB4982u, 0x9D80BA3A7427A7E9u, 0xD14F6E2142BFF093u,
+        0x211F637CF8425DD9u, 0x43CAC50F1E864C5Du, 0xE3AA389239DB71DAu, 0xC64257152A91D3ECu,
+    },
+    {
+        0xBAD3D268BBB96A01u, 0x54FC4D19E59A66B1u, 0x2F71BC93E26514CDu, 0x749CCDB925871B51u,
+        0x53F55102F7A257A4u, 0xD3686BB8D0D6BE03u, 0xD26B6FBDD6DEB504u, 0x4DD72964B35285FEu,
+        0x50F05D0DFDBA4AADu, 0xACE98A26CF09E063u, 0x8D8A0E83091C9684u, 0xBFDCC679A5914D1Au,
+        0x7090DDAD3DA7374Du, 0x52F65507F1AA5CA3u, 0x9AB352C87BA417E1u, 0x4CD42D61B55A8EF9u,
+        0xEA238F65460320ACu, 0xD56273A6C4E68411u, 0x97A466F155CC68C2u, 0xD16E63B2DCC6A80Du,
+        0x3355CCFFAA85D099u, 0x51F35908FBB241AAu, 0x5BED712AC7E20F9Cu, 0xA6F7A204F359AE55u,
+        0xDE7F5F81FEBEC120u, 0x48D83D75AD7AA2E5u, 0xA8E59A32D729CC7Fu, 0x99B65EC771BC0AE8u,
+        0xDB704B90E096E63Bu, 0x3256C8FAAC8DDB9Eu, 0xB7C4E65195D11522u, 0xFC19D72B32B3AACEu,
+        0xE338AB48704B7393u, 0x9EBF42DC63843BFDu, 0x91AE7EEF41FC52D0u, 0x9BB056CD7DAC1CE6u,
+        0xE23BAF4D76437894u, 0xBBD0D66DBDB16106u, 0x41C319589B32F1DAu, 0x6EB2A5CB7957E517u,
+        0xA5F2AE0BF941B35Cu, 0xCB400BC08016564Bu, 0x6BBDB1DA677FC20Cu, 0x95A26EFB59DC7ECCu,
+        0xA1FEBE1FE1619F40u, 0xF308EB1810CBC3E3u, 0xB1CEFE4F81E12F30u, 0x0206080A0C10160Eu,
+        0xCC4917DB922E675Eu, 0xC45137F3A26E3F66u, 0x1D2774694EE8CF53u, 0x143C504478A09C6Cu,
+        0xC3582BE8B0560E73u, 0x63A591F2573F9A34u, 0xDA734F95E69EED3Cu, 0x5DE76934D3D2358Eu,
+        0x5FE1613EDFC22380u, 0xDC79578BF2AED72Eu, 0x7D87E99413CF486Eu, 0xCD4A13DE94266C59u,
+        0x7F81E19E1FDF5E60u, 0x5AEE752FC1EA049Bu, 0x6CB4ADC17547F319u, 0x5CE46D31D5DA3E89u,
+        0xF704FB0C08EBEFFFu, 0x266A98BED42D47F2u, 0xFF1CDB2438ABB7C7u, 0xED2A937E543B11B9u,
+        0xE825876F4A1336A2u, 0x9DBA4ED3699C26F4u, 0x6FB1A1CE7F5FEE10u, 0x8E8F028C03048B8Du,
+        0x192B647D56C8E34Fu, 0xA0FDBA1AE7699447u, 0xF00DE7171AD3DEEAu, 0x89861E97113CBA98u,
+        0x0F113C332278692Du, 0x07091C1B12383115u, 0xAFEC8629C511FD6Au, 0xFB10CB30208B9BDBu,
+        0x0818202830405838u, 0x153F54417EA8976Bu, 0x0D1734392E687F23u, 0x040C101418202C1Cu,
+        0x0103040506080B07u, 0x64AC8DE94507AB21u, 0xDF7C5B84F8B6CA27u, 0x769AC5B329970D5Fu,
+        0x798BF9800BEF6472u, 0xDD7A538EF4A6DC29u, 0x3D47F4C98EF5B2B3u, 0x163A584E74B08A62u,
+        0x3F41FCC382E5A4BDu, 0x3759DCEBB2A5FC85u, 0x6DB7A9C4734FF81Eu, 0x3848E0D890DD95A8u,
+        0xB9D6DE67B1A17708u, 0x7395D1A237BF2A44u, 0xE926836A4C1B3DA5u, 0x355FD4E1BEB5EA8Bu,
+        0x55FF491CE3926DB6u, 0x7193D9A83BAF3C4Au, 0x7B8DF18A07FF727Cu, 0x8C890A860F149D83u,
+        0x7296D5A731B72143u, 0x88851A921734B19Fu, 0xF607FF090EE3E4F8u, 0x2A7EA882FC4D33D6u,
+        0x3E42F8C684EDAFBAu, 0x5EE2653BD9CA2887u, 0x27699CBBD2254CF5u, 0x46CA0543890AC0CFu,
+        0x0C14303C28607424u, 0x65AF89EC430FA026u, 0x68B8BDD56D67DF05u, 0x61A399F85B2F8C3Au,
+        0x03050C0F0A181D09u, 0xC15E23E2BC46187Du, 0x57F94116EF827BB8u, 0xD6677FA9CEFE9918u,
+        0xD976439AEC86F035u, 0x58E87D25CDFA1295u, 0xD875479FEA8EFB32u, 0x66AA85E34917BD2Fu,
+        0xD7647BACC8F6921Fu, 0x3A4EE8D29CCD83A6u, 0xC84507CF8A0E4B42u, 0x3C44F0CC88FDB9B4u,
+        0xFA13CF35268390DCu, 0x96A762F453C463C5u, 0xA7F4A601F551A552u, 0x98B55AC277B401EFu,
+        0xEC29977B52331ABEu, 0xB8D5DA62B7A97C0Fu, 0xC7543BFCA876226Fu, 0xAEEF822CC319F66Du,
+        0x69BBB9D06B6FD402u, 0x4BDD317AA762BFECu, 0xABE0963DDD31D176u, 0xA9E69E37D121C778u,
+        0x67A981E64F1FB628u, 0x0A1E28223C504E36u, 0x47C901468F02CBC8u, 0xF20BEF1D16C3C8E4u,
+        0xB5C2EE5B99C1032Cu, 0x226688AACC0D6BEEu, 0xE532B356647B4981u, 0xEE2F9F715E230CB0u,
+        0xBEDFC27CA399461Du, 0x2B7DAC87FA4538D1u, 0x819E3EBF217CE2A0u, 0x1236485A6C90A67Eu,
+        0x839836B52D6CF4AEu, 0x1B2D6C775AD8F541u, 0x0E1238362470622Au, 0x23658CAFCA0560E9u,
+        0xF502F30604FBF9F1u, 0x45CF094C8312DDC6u, 0x216384A5C61576E7u, 0xCE4F1FD19E3E7150u,
+        0x49DB3970AB72A9E2u, 0x2C74B09CE87D09C4u, 0xF916C33A2C9B8DD5u, 0xE637BF596E635488u,
+        0xB6C7E25493D91E25u, 0x2878A088F05D25D8u, 0x17395C4B72B88165u, 0x829B32B02B64FFA9u,
+        0x1A2E68725CD0FE46u, 0x8B80169D1D2CAC96u, 0xFE1FDF213EA3BCC0u, 0x8A8312981B24A791u,
+        0x091B242D3648533Fu, 0xC94603CA8C064045u, 0x879426A1354CD8B2u, 0x4ED2256BB94A98F7u,
+        0xE13EA3427C5B659Du, 0x2E72B896E46D1FCAu, 0xE431B75362734286u, 0xE03DA7477A536E9Au,
+        0xEB208B60400B2BABu, 0x90AD7AEA47F459D7u, 0xA4F1AA0EFF49B85Bu, 0x1E22786644F0D25Au,
+        0x85922EAB395CCEBCu, 0x60A09DFD5D27873Du, 0x0000000000000000u, 0x256F94B1DE355AFBu,
+        0xF401F70302F3F2F6u, 0xF10EE3121CDBD5EDu, 0x94A16AFE5FD475CBu, 0x0B1D2C273A584531u,
+        0xE734BB5C686B5F8Fu, 0x759FC9BC238F1056u, 0xEF2C9B74582B07B7u, 0x345CD0E4B8BDE18Cu,
+        0x3153C4F5A695C697u, 0xD46177A3C2EE8F16u, 0xD06D67B7DACEA30Au, 0x869722A43344D3B5u,
+        0x7E82E59B19D75567u, 0xADEA8E23C901EB64u, 0xFD1AD32E34BBA1C9u, 0x297BA48DF6552EDFu,
+        0x3050C0F0A09DCD90u, 0x3B4DECD79AC588A1u, 0x9FBC46D9658C30FAu, 0xF815C73F2A9386D2u,
+        0xC6573FF9AE7E2968u, 0x13354C5F6A98AD79u, 0x060A181E14303A12u, 0x050F14111E28271Bu,
+        0xC55233F6A4663461u, 0x113344556688BB77u, 0x7799C1B62F9F0658u, 0x7C84ED9115C74369u,
+        0x7A8EF58F01F7797Bu, 0x7888FD850DE76F75u, 0x365AD8EEB4ADF782u, 0x1C24706C48E0C454u,
+        0x394BE4DD96D59EAFu, 0x59EB7920CBF21992u, 0x1828607850C0E848u, 0x56FA4513E98A70BFu,
+        0xB3C8F6458DF1393Eu, 0xB0CDFA4A87E92437u, 0x246C90B4D83D51FCu, 0x206080A0C01D7DE0u,
+        0xB2CBF2408BF93239u, 0x92AB72E04BE44FD9u, 0xA3F8B615ED71894Eu, 0xC05D27E7BA4E137Au,
+        0x44CC0D49851AD6C1u, 0x62A695F751379133u, 0x103040506080B070u, 0xB4C1EA5E9FC9082Bu,
+        0x84912AAE3F54C5BBu, 0x43C511529722E7D4u, 0x93A876E54DEC44DEu, 0xC25B2FEDB65E0574u,
+        0x4ADE357FA16AB4EBu, 0xBDDACE73A9815B14u, 0x8F8C0689050C808Au, 0x2D77B499EE7502C3u,
+        0xBCD9CA76AF895013u, 0x9CB94AD66F942DF3u, 0x6ABEB5DF6177C90Bu, 0x40C01D5D9D3AFADDu,
+        0xCF4C1BD498367A57u, 0xA2FBB210EB798249u, 0x809D3ABA2774E9A7u, 0x4FD1216EBF4293F0u,
+        0x1F217C6342F8D95Du, 0xCA430FC5861E5D4Cu, 0xAAE39238DB39DA71u, 0x42C61557912AECD3u,
+    },
+#endif
+};
+
+static const uint64_t khazad_round_const[KHAZAD_NUM_ROUNDS + 1u] =
+{
+    0x4DD2D353742F54BAu, 0x4C9A5270BF8DAC50u, 0xA65B5133D197D5EAu, 0xFCB732DB99A848DEu,
+    0x6E41BBE29B919EE3u, 0x02B1F3A1956BCBA5u, 0x5DDA63C3141DC4CCu, 0x5C6C5A7FCD7DDC5Fu,
+    0x8E6F9DE8EDFF26F7u,
+};
@@ -0,0 +1,394 @@
+/*****************************************************************************
+ * khazad-min-tiered.c
+ *
+ * Tiered storage of Khazad keys: compact on-the-fly key schedule state for
+ * cold keys, and full key schedules for hot keys.
+ *
+ * The records are in an open-addressing hash table with linear probing, no
+ * more than 80% full. Removal shifts later records of the probe sequence back
+ * into the gap, so there are no tombstones. A hot record holds the index of
+ * its slot in the hot set, and each hot slot holds the index of its record,
+ * so both are updated whenever either moves.
+ *
+ * The hot key schedules are stored contiguously, apart from the CLOCK state,
+ * so the hot set is 72 bytes per key plus 8 for its slot.
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Includes
+ ****************************************************************************/
+
+#include "khazad-min-tiered.h"
+#include "khazad-min-internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/*****************************************************************************
+ * Defines
+ ****************************************************************************/
+
+/* Values of a record's hot member that aren't hot slot indices. */
+#define KHAZAD_TIERED_EMPTY         UINT32_MAX
+#define KHAZAD_TIERED_COLD          (UINT32_MAX - 1u)
+
+/* Table indices are calculated with a 32-bit multiply and shift. */
+#define KHAZAD_TIERED_MAX_KEYS      (UINT32_MAX / 2u)
+
+/*****************************************************************************
+ * Types
+ ****************************************************************************/
+
+typedef struct
+{
+    uint64_t    id;
+    uint8_t     start_key[KHAZAD_KEY_SIZE];
+    /* Blocks processed since the key was added or demoted. */
+    uint32_t    count;
+    /* Hot slot index, or KHAZAD_TIERED_COLD or KHAZAD_TIERED_EMPTY. */
+    uint32_t    hot;
+} khazad_tiered_record_t;
+
+typedef struct
+{
+    uint32_t    record;
+    /* Set by use, cleared by the clock hand. */
+    uint8_t     referenced;
+} khazad_tiered_hot_t;
+
+struct khazad_tiered
+{
+    khazad_tiered_record_t    * p_records;
+    size_t                      table_size;
+    size_t                      num_keys;
+    size_t                      max_keys;
+    uint8_t                   * p_key_schedules;
+    khazad_tiered_hot_t       * p_hot;
+    size_t                      num_hot;
+    size_t                      max_hot;
+    size_t                      hand;
+    uint32_t                    promote_threshold;
+    uint64_t                    hot_accesses;
+    uint64_t                    cold_accesses;
+    uint64_t                    promotions;
+    uint64_t                    demotions;
+};
+
+/*****************************************************************************
+ * Inline functions
+ ****************************************************************************/
+
+/* The home index of id in the table: the hash scaled to the table size, which
+ * needn't be a power of 2. */
+static inline size_t khazad_tiered_home(const khazad_tiered_t * p_tiered, uint64_t id)
+{
+    return (size_t)(((khazad_mix_word(id) >> 32u) * (uint64_t)p_tiered->table_size) >> 32u);
+}
+
+static inline size_t khazad_tiered_next(const khazad_tiered_t * p_tiered, size_t index)
+{
+    return (index + 1u == p_tiered->table_size) ? 0 : index + 1u;
+}
+
+static inline uint8_t * khazad_tiered_key_schedule(khazad_tiered_t * p_tiered, size_t slot)
+{
+    return &p_tiered->p_key_schedules[slot * KHAZAD_KEY_SCHEDULE_SIZE];
+}
+
+/*****************************************************************************
+ * Local functions
+ ****************************************************************************/
+
+/* Find the record index for id, or the empty record that ends its probe
+ * sequence. The table always has an empty record, so this terminates. */
+static size_t khazad_tiered_find(const khazad_tiered_t * p_tiered, uint64_t id)
+{
+    size_t  index = khazad_tiered_home(p_tiered, id);
+
+    while (p_tiered->p_records[index].hot != KHAZAD_TIERED_EMPTY && p_tiered->p_records[index].id != id)
+    {
+        index = khazad_tiered_next(p_tiered, index);
+    }
+    return index;
+}
+
+/* Free the hot slot of a record, and make it cold. The last hot slot is moved
+ * into the gap, to keep the hot set contiguous. */
+static void khazad_tiered_free_hot(khazad_tiered_t * p_tiered, khazad_tiered_record_t * p_record)
+{
+    size_t  slot = p_record->hot;
+    size_t  last = p_tiered->num_hot - 1u;
+
+    if (slot != last)
+    {
+        memcpy(khazad_tiered_key_schedule(p_tiered, slot), khazad_tiered_key_schedule(p_tiered, last), KHAZAD_KEY_SCHEDULE_SIZE);
+        p_tiered->p_hot[slot] = p_tiered->p_hot[last];
+        p_tiered->p_records[p_tiered->p_hot[slot].record].hot = (uint32_t)slot;
+    }
+    khazad_wipe(khazad_tiered_key_schedule(p_tiered, last), KHAZAD_KEY_SCHEDULE_SIZE);
+    p_tiered->num_hot = last;
+    if (p_tiered->hand >= p_tiered->num_hot)
+        p_tiered->hand = 0;
+    p_record->hot = KHAZAD_TIERED_COLD;
+    p_record->count = 0;
+}
+
+/* Choose a hot slot to reuse, by the CLOCK algorithm, and demote its key. The
+ * hot set must be full. */
+static size_t khazad_tiered_clock_victim(khazad_tiered_t * p_tiered)
+{
+    khazad_tiered_record_t    * p_record;
+    size_t                      slot;
+
+    for (;;)
+    {
+        slot = p_tiered->hand;
+        if (++p_tiered->hand == p_tiered->num_hot)
+            p_tiered->hand = 0;
+        if (!p_tiered->p_hot[slot].referenced)
+            break;
+        p_tiered->p_hot[slot].referenced = 0;
+    }
+    p_record = &p_tiered->p_records[p_tiered->p_hot[slot].record];
+    p_record->hot = KHAZAD_TIERED_COLD;
+    p_record->count = 0;
+    ++p_tiered->demotions;
+    return slot;
+}
+
+/* Promote a cold record to the hot set, if it has one. */
+static void khazad_tiered_promote(khazad_tiered_t * p_tiered, size_t index)
+{
+    khazad_tiered_record_t    * p_record = &p_tiered->p_records[index];
+    size_t                      slot;
+
+    if (p_tiered->max_hot == 0)
+        return;
+    if (p_tiered->num_hot < p_tiered->max_hot)
+        slot = p_tiered->num_hot++;
+    else
+        slot = khazad_tiered_clock_victim(p_tiered);
+    khazad_key_schedule_from_otfks_start_key(khazad_tiered_key_schedule(p_tiered, slot), p_record->start_key);
+    p_tiered->p_hot[slot].record = (uint32_t)index;
+    p_tiered->p_hot[slot].referenced = 0;
+    p_record->hot = (uint32_t)slot;
+    ++p_tiered->promotions;
+}
+
+/* Find the key for id, counting the blocks for it and promoting it if it
+ * crosses the threshold. Returns its hot slot's key schedule, or NULL if it
+ * is cold, in which case p_record is set. Returns NULL with p_record NULL if
+ * id isn't in the store. */
+static const uint8_t * khazad_tiered_access(khazad_tiered_t * p_tiered, uint64_t id, size_t num_blocks, const khazad_tiered_record_t ** pp_record)
+{
+    size_t                      index = khazad_tiered_find(p_tiered, id);
+    khazad_tiered_record_t    * p_record = &p_tiered->p_records[index];
+
+    *pp_record = NULL;
+    if (p_record->hot == KHAZAD_TIERED_EMPTY)
+        return NULL;
+    if (p_record->hot == KHAZAD_TIERED_COLD)
+    {
+        /* Saturating add. */
+        p_record->count = (num_blocks >= UINT32_MAX - p_record->count) ? UINT32_MAX : p_record->count + (uint32_t)num_blocks;
+        if (p_record->count >= p_tiered->promote_threshold)
+            khazad_tiered_promote(p_tiered, index);
+    }
+    if (p_record->hot == KHAZAD_TIERED_COLD)
+    {
+        ++p_tiered->cold_accesses;
+        *pp_record = p_record;
+        return NULL;
+    }
+    ++p_tiered->hot_accesses;
+    p_tiered->p_hot[p_record->hot].referenced = 1u;
+    return khazad_tiered_key_schedule(p_tiered, p_record->hot);
+}
+
+/*****************************************************************************
+ * Functions
+ ****************************************************************************/
+
+/* Create a tiered key store.
+ * max_keys is the number of keys it can hold. Each takes about 40 bytes,
+ * including hash table space.
+ * hot_memory is the memory, in bytes, for the hot set. Each hot key takes 80
+ * bytes, for its key schedule and CLOCK state. It may be 0, so every key stays
+ * cold.
+ * promote_threshold is the number of blocks that a cold key processes before
+ * it is promoted; 0 or 1 promotes a key on its first use.
+ * Returns NULL if memory can't be allocated, or max_keys is too large.
+ */
+khazad_tiered_t * khazad_tiered_create(size_t max_keys, size_t hot_memory, uint32_t promote_threshold)
+{
+    khazad_tiered_t   * p_tiered;
+    size_t              i;
+
+    if (max_keys > KHAZAD_TIERED_MAX_KEYS)
+        return NULL;
+    p_tiered = (khazad_tiered_t *)calloc(1u, sizeof(*p_tiered));
+    if (p_tiered == NULL)
+        return NULL;
+    p_tiered->max_keys = max_keys;
+    /* At most 80% full, with at least one empty record. */
+    p_tiered->table_size = max_keys + max_keys / 4u + 1u;
+    p_tiered->max_hot = hot_memory / (KHAZAD_KEY_SCHEDULE_SIZE + sizeof(khazad_tiered_hot_t));
+    if (p_tiered->max_hot > max_keys)
+        p_tiered->max_hot = max_keys;
+    p_tiered->promote_threshold = promote_threshold;
+
+    p_tiered->p_records = (khazad_tiered_record_t *)calloc(p_tiered->table_size, sizeof(khazad_tiered_record_t));
+    p_tiered->p_key_schedules = (uint8_t *)calloc(p_tiered->max_hot ? p_tiered->max_hot : 1u, KHAZAD_KEY_SCHEDULE_SIZE);
+    p_tiered->p_hot = (khazad_tiered_hot_t *)calloc(p_tiered->max_hot ? p_tiered->max_hot : 1u, sizeof(khazad_tiered_hot_t));
+    if (p_tiered->p_records == NULL || p_tiered->p_key_schedules == NULL || p_tiered->p_hot == NULL)
+    {
+        khazad_tiered_destroy(p_tiered);
+        return NULL;
+    }
+    for (i = 0; i < p_tiered->table_size; ++i)
+    {
+        p_tiered->p_records[i].hot = KHAZAD_TIERED_EMPTY;
+    }
+    return p_tiered;
+}
+
+/* Free a tiered key store, first clearing all its key material.
+ */
+void khazad_tiered_destroy(khazad_tiered_t * p_tiered)
+{
+    if (p_tiered == NULL)
+        return;
+    if (p_tiered->p_records != NULL)
+        khazad_wipe(p_tiered->p_records, p_tiered->table_size * sizeof(khazad_tiered_record_t));
+    if (p_tiered->p_key_schedules != NULL)
+        khazad_wipe(p_tiered->p_key_schedules, p_tiered->max_hot * KHAZAD_KEY_SCHEDULE_SIZE);
+    free(p_tiered->p_records);
+    free(p_tiered->p_key_schedules);
+    free(p_tiered->p_hot);
+    free(p_tiered);
+}
+
+/* Add the 16-byte key p_key for id, as a cold key. If id is already in the
+ * store, its key is replaced, keeping it hot if it was hot.
+ * Returns 0 on success, or -1 if the store is full.
+ */
+int khazad_tiered_add(khazad_tiered_t * p_tiered, uint64_t id, const uint8_t p_key[KHAZAD_KEY_SIZE])
+{
+    size_t                      index = khazad_tiered_find(p_tiered, id);
+    khazad_tiered_record_t    * p_record = &p_tiered->p_records[index];
+
+    if (p_record->hot == KHAZAD_TIERED_EMPTY)
+    {
+        if (p_tiered->num_keys == p_tiered->max_keys)
+            return -1;
+        ++p_tiered->num_keys;
+        p_record->id = id;
+        p_record->hot = KHAZAD_TIERED_COLD;
+        p_record->count = 0;
+    }
+    memcpy(p_record->start_key, p_key, KHAZAD_KEY_SIZE);
+    khazad_otfks_encrypt_start_key(p_record->start_key);
+    if (p_record->hot != KHAZAD_TIERED_COLD)
+        khazad_key_schedule_from_otfks_start_key(khazad_tiered_key_schedule(p_tiered, p_record->hot), p_record->start_key);
+    return 0;
+}
+
+/* Remove id and its key from the store, if it is there.
+ */
+void khazad_tiered_remove(khazad_tiered_t * p_tiered, uint64_t id)
+{
+    size_t                      gap = khazad_tiered_find(p_tiered, id);
+    size_t                      index;
+    size_t                      home;
+    khazad_tiered_record_t    * p_records = p_tiered->p_records;
+
+    if (p_records[gap].hot == KHAZAD_TIERED_EMPTY)
+        return;
+    if (p_records[gap].hot != KHAZAD_TIERED_COLD)
+        khazad_tiered_free_hot(p_tiered, &p_records[gap]);
+    --p_tiered->num_keys;
+
+    /* Shift back each later record in the probe sequence whose home is not
+     * cyclically between the gap and itself. */
+    index = gap;
+    for (;;)
+    {
+        index = khazad_tiered_next(p_tiered, index);
+        if (p_records[index].hot == KHAZAD_TIERED_EMPTY)
+            break;
+        home = khazad_tiered_home(p_tiered, p_records[index].id);
+        if ((gap < index) ? (home > gap && home <= index) : (home > gap || home <= index))
+            continue;
+        p_records[gap] = p_records[index];
+        if (p_records[gap].hot != KHAZAD_TIERED_COLD)
+            p_tiered->p_hot[p_records[gap].hot].record = (uint32_t)gap;
+        gap = index;
+    }
+    khazad_wipe(&p_records[gap], sizeof(khazad_tiered_record_t));
+    p_records[gap].hot = KHAZAD_TIERED_EMPTY;
+}
+
+/* Khazad encryption of multiple blocks with the key for id, as for
+ * khazad_crypt_blocks(). p_dst may equal p_src, but the buffers must not
+ * otherwise overlap.
+ * Returns 0 on success, or -1 if id isn't in the store.
+ */
+int khazad_tiered_crypt_blocks(khazad_tiered_t * p_tiered, uint64_t id, uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks)
+{
+    const khazad_tiered_record_t  * p_record;
+    const uint8_t                 * p_key_schedule;
+
+    p_key_schedule = khazad_tiered_access(p_tiered, id, num_blocks, &p_record);
+    if (p_key_schedule != NULL)
+    {
+        khazad_crypt_blocks(p_dst, p_src, num_blocks, p_key_schedule);
+        return 0;
+    }
+    if (p_record == NULL)
+        return -1;
+
+    khazad_otfks_encrypt_blocks(p_dst, p_src, num_blocks, p_record->start_key);
+    return 0;
+}
+
+/* Khazad decryption of multiple blocks with the key for id, as for
+ * khazad_decrypt_blocks(). p_dst may equal p_src, but the buffers must not
+ * otherwise overlap.
+ * Returns 0 on success, or -1 if id isn't in the store.
+ */
+int khazad_tiered_decrypt_blocks(khazad_tiered_t * p_tiered, uint64_t id, uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks)
+{
+    const khazad_tiered_record_t  * p_record;
+    const uint8_t                 * p_key_schedule;
+    uint8_t                         start_key[KHAZAD_KEY_SIZE];
+
+    p_key_schedule = khazad_tiered_access(p_tiered, id, num_blocks, &p_record);
+    if (p_key_schedule != NULL)
+    {
+        khazad_decrypt_blocks(p_dst, p_src, num_blocks, p_key_schedule);
+        return 0;
+    }
+    if (p_record == NULL)
+        return -1;
+
+    /* The decryption start key state is calculated once per call. */
+    memcpy(start_key, p_record->start_key, KHAZAD_KEY_SIZE);
+    khazad_otfks_decrypt_from_encrypt_start_key(start_key);
+    khazad_otfks_decrypt_blocks(p_dst, p_src, num_blocks, start_key);
+    khazad_wipe(start_key, sizeof(start_key));
+    return 0;
+}
+
+/* Get the tiered store statistics.
+ */
+void khazad_tiered_get_stats(const khazad_tiered_t * p_tiered, khazad_tiered_stats_t * p_stats)
+{
+    p_stats->hot_accesses = p_tiered->hot_accesses;
+    p_stats->cold_accesses = p_tiered->cold_accesses;
+    p_stats->promotions = p_tiered->promotions;
+    p_stats->demotions = p_tiered->demotions;
+    p_stats->num_keys = p_tiered->num_keys;
+    p_stats->max_keys = p_tiered->max_keys;
+    p_stats->num_hot = p_tiered->num_hot;
+    p_stats->max_hot = p_tiered->max_hot;
+}
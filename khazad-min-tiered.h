@@ -0,0 +1,103 @@
+/*****************************************************************************
+ * khazad-min-tiered.h
+ *
+ * Tiered storage of Khazad keys: compact on-the-fly key schedule state for
+ * cold keys, and full key schedules for hot keys.
+ *
+ * Every key is held as its 16-byte encryption start key state for on-the-fly
+ * key schedule calculation (see khazad_otfks_encrypt_start_key()), in a
+ * 32-byte record with its id. Blocks for a cold key are processed with
+ * khazad_otfks_encrypt_blocks() and khazad_otfks_decrypt_blocks(). Once a cold
+ * key has had a threshold number of blocks processed, it is promoted: its full
+ * 72-byte key schedule is calculated from the start key state into the hot
+ * set, and its blocks are processed with khazad_crypt_blocks() and
+ * khazad_decrypt_blocks() from then on.
+ *
+ * The hot set has a fixed number of slots, from a memory budget. When it is
+ * full, a hot key is demoted to make room, chosen by the CLOCK algorithm:
+ * keys used since the clock hand last passed them are skipped.
+ *
+ * A store is not thread-safe; use one per thread, or serialise calls to it.
+ ****************************************************************************/
+
+#ifndef KHAZAD_MIN_TIERED_H
+#define KHAZAD_MIN_TIERED_H
+
+/*****************************************************************************
+ * Includes
+ ****************************************************************************/
+
+#include "khazad-min.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*****************************************************************************
+ * Types
+ ****************************************************************************/
+
+typedef struct khazad_tiered khazad_tiered_t;
+
+/* Tiered store statistics. */
+typedef struct
+{
+    /* Calls that processed blocks with a hot or cold key. */
+    uint64_t    hot_accesses;
+    uint64_t    cold_accesses;
+    uint64_t    promotions;
+    uint64_t    demotions;
+    size_t      num_keys;
+    size_t      max_keys;
+    size_t      num_hot;
+    size_t      max_hot;
+} khazad_tiered_stats_t;
+
+/*****************************************************************************
+ * Function prototypes
+ ****************************************************************************/
+
+/* Create a tiered key store.
+ * max_keys is the number of keys it can hold. Each takes about 40 bytes,
+ * including hash table space.
+ * hot_memory is the memory, in bytes, for the hot set. Each hot key takes 80
+ * bytes, for its key schedule and CLOCK state. It may be 0, so every key stays
+ * cold.
+ * promote_threshold is the number of blocks that a cold key processes before
+ * it is promoted; 0 or 1 promotes a key on its first use.
+ * Returns NULL if memory can't be allocated, or max_keys is too large.
+ */
+khazad_tiered_t * khazad_tiered_create(size_t max_keys, size_t hot_memory, uint32_t promote_threshold);
+
+/* Free a tiered key store, first clearing all its key material.
+ */
+void khazad_tiered_destroy(khazad_tiered_t * p_tiered);
+
+/* Add the 16-byte key p_key for id, as a cold key. If id is already in the
+ * store, its key is replaced, keeping it hot if it was hot.
+ * Returns 0 on success, or -1 if the store is full.
+ */
+int khazad_tiered_add(khazad_tiered_t * p_tiered, uint64_t id, const uint8_t p_key[KHAZAD_KEY_SIZE]);
+
+/* Remove id and its key from the store, if it is there.
+ */
+void khazad_tiered_remove(khazad_tiered_t * p_tiered, uint64_t id);
+
+/* Khazad encryption of multiple blocks with the key for id, as for
+ * khazad_crypt_blocks(). p_dst may equal p_src, but the buffers must not
+ * otherwise overlap.
+ * Returns 0 on success, or -1 if id isn't in the store.
+ */
+int khazad_tiered_crypt_blocks(khazad_tiered_t * p_tiered, uint64_t id, uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks);
+
+/* Khazad decryption of multiple blocks with the key for id, as for
+ * khazad_decrypt_blocks(). p_dst may equal p_src, but the buffers must not
+ * otherwise overlap.
+ * Returns 0 on success, or -1 if id isn't in the store.
+ */
+int khazad_tiered_decrypt_blocks(khazad_tiered_t * p_tiered, uint64_t id, uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks);
+
+/* Get the tiered store statistics.
+ */
+void khazad_tiered_get_stats(const khazad_tiered_t * p_tiered, khazad_tiered_stats_t * p_stats);
+
+#endif /* !defined(KHAZAD_MIN_TIERED_H) */
@@ -30,6 +30,7 @@
  ****************************************************************************/
 
 #include "khazad-min.h"
+#include "khazad-min-internal.h"
 
 #include <string.h>
 
@@ -39,11 +40,91 @@
 
 #define KHAZAD_REDUCE_BYTE      0x1Du
 
+/* Number of independent blocks processed together by khazad_crypt_blocks(),
+ * khazad_decrypt_blocks() and the keyed block functions, or keys by
+ * khazad_key_schedule_multi(), so their rounds can overlap. */
+#define KHAZAD_INTERLEAVE_BLOCKS    4u
+
+/* Number of blocks that khazad_otfks_encrypt_blocks() and
+ * khazad_otfks_decrypt_blocks() take through each round together, sharing one
+ * calculation of each round key. Small enough for the blocks to stay in L1
+ * cache between rounds. */
+#define KHAZAD_OTFKS_GROUP_BLOCKS   64u
+
+/* With the x86 SIMD kernels, the public multi-block, keyed block and multi-key
+ * functions are provided by khazad-min-dispatch.c, which calls these as the
+ * scalar kernel. The single-block and iterated functions are always these. */
+#ifdef ENABLE_X86_KERNELS
+#define khazad_crypt_blocks         khazad_scalar_crypt_blocks
+#define khazad_decrypt_blocks       khazad_scalar_decrypt_blocks
+#define khazad_key_schedule_multi   khazad_scalar_key_schedule_multi
+#define khazad_crypt_keyed_blocks   khazad_scalar_crypt_keyed_blocks
+#define khazad_decrypt_keyed_blocks khazad_scalar_decrypt_keyed_blocks
+#endif
+
+#if defined(ENABLE_T_TABLE) || defined(ENABLE_T_TABLE_DYADIC)
+
+#ifdef ENABLE_SBOX_SMALL
+#error "ENABLE_T_TABLE and ENABLE_SBOX_SMALL can't be used together"
+#endif
+#ifdef ENABLE_BYTE_CORE
+#error "ENABLE_T_TABLE and ENABLE_BYTE_CORE can't be used together"
+#endif
+
+/* Rounds are done by T-table look-up. */
+#define KHAZAD_T_TABLE          1
+
+#if defined(ENABLE_T_TABLE_DYADIC) && !defined(ENABLE_X86_KERNELS)
+/* Only table 0 is stored. The others are byte permutations of it. (The x86
+ * kernels need them all stored, below.) */
+#define KHAZAD_T_TABLE_COUNT    1u
+#else
+#define KHAZAD_T_TABLE_COUNT    KHAZAD_BLOCK_SIZE
+#endif
+
+#endif /* defined(ENABLE_T_TABLE) || defined(ENABLE_T_TABLE_DYADIC) */
+
+#ifndef ENABLE_BYTE_CORE
+
+/* The block is held in a uint64_t. */
+#define KHAZAD_WORD_CORE        1
+
+#ifndef KHAZAD_T_TABLE
+/* Without T-tables, the diffusion layer is done on the whole word at once:
+ * SWAR (SIMD within a register) doubling, and byte permutations. */
+#define KHAZAD_SWAR_CORE        1
+#endif
+
+#endif /* ENABLE_BYTE_CORE */
+
 /*****************************************************************************
  * Look-up tables
  ****************************************************************************/
 
-#ifdef ENABLE_SBOX_SMALL
+#ifdef ENABLE_X86_KERNELS
+/* The AVX2 gather kernel in khazad-min-gather.c indexes all eight T-tables,
+ * as declared in khazad-min-internal.h. They are defined here, with external
+ * linkage, whichever core is built, so the T-table core shares them. */
+#ifndef KHAZAD_T_TABLE_COUNT
+#define KHAZAD_T_TABLE_COUNT    KHAZAD_BLOCK_SIZE
+#endif
+#define KHAZAD_T_TABLE_LINKAGE
+#endif
+
+#if defined(KHAZAD_T_TABLE) || defined(ENABLE_X86_KERNELS)
+
+/* Eight (or for ENABLE_T_TABLE_DYADIC, one) 256-entry tables that combine the
+ * S-box and the diffusion matrix. The S-box itself is byte 0 of table 0, and
+ * the round constants are also included. */
+#include "khazad-min-t-table.h"    /* Generated by Python gen-t-table.py */
+
+#endif
+
+#if defined(KHAZAD_T_TABLE)
+
+/* The S-box is in the T-tables. */
+
+#elif defined(ENABLE_SBOX_SMALL)
 
 static const uint8_t sbox_small_table[16u] =
 {
@@ -79,13 +160,15 @@ static const uint8_t khazad_sbox_table[256u] =
  ****************************************************************************/
 
 static void khazad_otfks_calc_key(uint8_t p_key[KHAZAD_KEY_SIZE], uint_fast8_t start, uint_fast8_t stop);
+static void khazad_otfks_calc_key_reverse(uint8_t p_key[KHAZAD_KEY_SIZE], uint_fast8_t start, uint_fast8_t stop);
 #ifdef ENABLE_SBOX_SMALL
 static uint8_t khazad_sbox(uint8_t input);
 #endif
+#ifndef KHAZAD_WORD_CORE
 static void khazad_sbox_apply_block(uint8_t p_block[KHAZAD_BLOCK_SIZE]);
 static void khazad_sbox_add_round_const(uint8_t p_block[KHAZAD_BLOCK_SIZE], uint_fast8_t round);
-static void khazad_matrix_mul(uint8_t p_output[KHAZAD_BLOCK_SIZE], const uint8_t p_input[KHAZAD_BLOCK_SIZE]);
 static void khazad_matrix_imul(uint8_t p_block[KHAZAD_BLOCK_SIZE]);
+#endif
 
 /*****************************************************************************
  * Inline functions
@@ -130,7 +213,15 @@ static inline uint8_t khazad_mul2(uint8_t a)
 
 #endif
 
-#ifndef ENABLE_SBOX_SMALL
+#if defined(KHAZAD_T_TABLE)
+
+static inline uint8_t khazad_sbox(uint8_t a)
+{
+    /* Byte 0 of table 0 is the S-box multiplied by H[0][0] = 1. */
+    return (uint8_t)khazad_t_table[0][a];
+}
+
+#elif !defined(ENABLE_SBOX_SMALL)
 
 static inline uint8_t khazad_sbox(uint8_t a)
 {
@@ -139,6 +230,423 @@ static inline uint8_t khazad_sbox(uint8_t a)
 
 #endif
 
+#if defined(ENABLE_T_TABLE_DYADIC) || defined(KHAZAD_SWAR_CORE)
+
+/* Byte permutations of a word, output byte i = input byte (i ^ j).
+ * The diffusion matrix is dyadic, H[i][j] = h[i ^ j], so
+ *     T_j[x] = khazad_permute_j(T_0[x])
+ */
+static inline uint64_t khazad_permute_1(uint64_t a)
+{
+    return ((a & 0x00FF00FF00FF00FFu) << 8u) | ((a >> 8u) & 0x00FF00FF00FF00FFu);
+}
+
+static inline uint64_t khazad_permute_2(uint64_t a)
+{
+    return ((a & 0x0000FFFF0000FFFFu) << 16u) | ((a >> 16u) & 0x0000FFFF0000FFFFu);
+}
+
+static inline uint64_t khazad_permute_4(uint64_t a)
+{
+    /* Hopefully the compiler converts this to a single rotate instruction */
+    return (a << 32u) | (a >> 32u);
+}
+
+static inline uint64_t khazad_permute_7(uint64_t a)
+{
+    /* Hopefully the compiler converts this to a single byte-swap instruction */
+    return (a >> 56u) |
+           ((a >> 40u) & 0x000000000000FF00u) |
+           ((a >> 24u) & 0x0000000000FF0000u) |
+           ((a >> 8u) & 0x00000000FF000000u) |
+           ((a << 8u) & 0x000000FF00000000u) |
+           ((a << 24u) & 0x0000FF0000000000u) |
+           ((a << 40u) & 0x00FF000000000000u) |
+           (a << 56u);
+}
+
+static inline uint64_t khazad_permute_3(uint64_t a)
+{
+    return khazad_permute_4(khazad_permute_7(a));
+}
+
+#endif /* defined(ENABLE_T_TABLE_DYADIC) || defined(KHAZAD_SWAR_CORE) */
+
+#if defined(ENABLE_T_TABLE_DYADIC)
+
+/* S-box layer then diffusion layer, using only table 0.
+ * The sum over j of T_j[a_j] is grouped so that only cheap permutations are
+ * needed:
+ *     d_j = T_0[a_j] ^ P_7(T_0[a_(7-j)])     for j = 0 to 3
+ *     e_0 = d_0 ^ P_3(d_3)
+ *     e_1 = d_1 ^ P_3(d_2)
+ *     result = e_0 ^ P_1(e_1)
+ */
+static inline uint64_t khazad_round_word(uint64_t a)
+{
+    uint64_t    d0;
+    uint64_t    d1;
+    uint64_t    d2;
+    uint64_t    d3;
+
+    d0 = khazad_t_table[0][a & 0xFFu] ^ khazad_permute_7(khazad_t_table[0][a >> 56u]);
+    d1 = khazad_t_table[0][(a >> 8u) & 0xFFu] ^ khazad_permute_7(khazad_t_table[0][(a >> 48u) & 0xFFu]);
+    d2 = khazad_t_table[0][(a >> 16u) & 0xFFu] ^ khazad_permute_7(khazad_t_table[0][(a >> 40u) & 0xFFu]);
+    d3 = khazad_t_table[0][(a >> 24u) & 0xFFu] ^ khazad_permute_7(khazad_t_table[0][(a >> 32u) & 0xFFu]);
+
+    return d0 ^ khazad_permute_3(d3) ^ khazad_permute_1(d1 ^ khazad_permute_3(d2));
+}
+
+/* S-box layer only. */
+static inline uint64_t khazad_sbox_word(uint64_t a)
+{
+    return (khazad_t_table[0][a & 0xFFu] & 0xFFu) |
+           ((khazad_t_table[0][(a >> 8u) & 0xFFu] & 0xFFu) << 8u) |
+           ((khazad_t_table[0][(a >> 16u) & 0xFFu] & 0xFFu) << 16u) |
+           ((khazad_t_table[0][(a >> 24u) & 0xFFu] & 0xFFu) << 24u) |
+           ((khazad_t_table[0][(a >> 32u) & 0xFFu] & 0xFFu) << 32u) |
+           ((khazad_t_table[0][(a >> 40u) & 0xFFu] & 0xFFu) << 40u) |
+           ((khazad_t_table[0][(a >> 48u) & 0xFFu] & 0xFFu) << 48u) |
+           ((khazad_t_table[0][a >> 56u] & 0xFFu) << 56u);
+}
+
+#elif defined(ENABLE_T_TABLE)
+
+/* S-box layer then diffusion layer: eight look-ups and XORs. */
+static inline uint64_t khazad_round_word(uint64_t a)
+{
+    return khazad_t_table[0][a & 0xFFu] ^
+           khazad_t_table[1][(a >> 8u) & 0xFFu] ^
+           khazad_t_table[2][(a >> 16u) & 0xFFu] ^
+           khazad_t_table[3][(a >> 24u) & 0xFFu] ^
+           khazad_t_table[4][(a >> 32u) & 0xFFu] ^
+           khazad_t_table[5][(a >> 40u) & 0xFFu] ^
+           khazad_t_table[6][(a >> 48u) & 0xFFu] ^
+           khazad_t_table[7][a >> 56u];
+}
+
+/* S-box layer only. Byte i of table i is the S-box multiplied by
+ * H[i][i] = 1, so the S-box output can be masked out of the T-tables, with no
+ * shifting needed. */
+static inline uint64_t khazad_sbox_word(uint64_t a)
+{
+    return (khazad_t_table[0][a & 0xFFu] & 0x00000000000000FFu) |
+           (khazad_t_table[1][(a >> 8u) & 0xFFu] & 0x000000000000FF00u) |
+           (khazad_t_table[2][(a >> 16u) & 0xFFu] & 0x0000000000FF0000u) |
+           (khazad_t_table[3][(a >> 24u) & 0xFFu] & 0x00000000FF000000u) |
+           (khazad_t_table[4][(a >> 32u) & 0xFFu] & 0x000000FF00000000u) |
+           (khazad_t_table[5][(a >> 40u) & 0xFFu] & 0x0000FF0000000000u) |
+           (khazad_t_table[6][(a >> 48u) & 0xFFu] & 0x00FF000000000000u) |
+           (khazad_t_table[7][a >> 56u] & 0xFF00000000000000u);
+}
+
+#elif defined(KHAZAD_SWAR_CORE)
+
+/* Double all 8 bytes of the word in GF(2^8). */
+static inline uint64_t khazad_mul2_word(uint64_t a)
+{
+    return ((a & 0x7F7F7F7F7F7F7F7Fu) << 1u) ^ (((a >> 7u) & 0x0101010101010101u) * KHAZAD_REDUCE_BYTE);
+}
+
+/* S-box layer, one byte at a time. */
+static inline uint64_t khazad_sbox_word(uint64_t a)
+{
+    uint64_t        result = 0;
+    uint_fast8_t    i;
+
+    for (i = 0; i < KHAZAD_BLOCK_SIZE; ++i)
+    {
+        result |= (uint64_t)khazad_sbox((uint8_t)(a >> (i * 8u))) << (i * 8u);
+    }
+    return result;
+}
+
+/* Diffusion layer. Since H[i][j] = h[i ^ j], output byte i gets
+ * h[j] * (input byte i ^ j), for each j, so the whole word can be done at
+ * once with byte permutations. The same shared pair sums as
+ * khazad_matrix_imul() are used (see there), with P_j being
+ * khazad_permute_j():
+ *     q1 = x + P_1(x)
+ *     q3 = x + P_3(x)
+ *     r = P_1(x) + P_6(q1)
+ *     w = P_2(q1) + P_4(q3) + 2 * P_5(q3)
+ *     w = P_4(x) + r + 2 * w
+ *     y = q3 + r + 2 * w
+ * q1 is unchanged by P_1, and q3 by P_3, so the cheaper of the equivalent
+ * permutations is used for each: P_6(q1) = P_7(q1), P_2(q1) = P_3(q1) and
+ * P_5(q3) = P_6(q3).
+ * That is 3 doublings and 9 XORs, versus 3 doublings and 12 XORs for the sum
+ * of the 8 terms, and fewer permutations.
+ */
+static inline uint64_t khazad_diffusion_word(uint64_t a)
+{
+    uint64_t    a_p1 = khazad_permute_1(a);
+    uint64_t    q1 = a ^ a_p1;
+    uint64_t    q3 = a ^ khazad_permute_3(a);
+    uint64_t    r = a_p1 ^ khazad_permute_7(q1);
+    uint64_t    w;
+
+    w = khazad_permute_3(q1) ^ khazad_permute_4(q3) ^ khazad_mul2_word(khazad_permute_4(khazad_permute_2(q3)));
+    w = khazad_permute_4(a) ^ r ^ khazad_mul2_word(w);
+    return q3 ^ r ^ khazad_mul2_word(w);
+}
+
+/* S-box layer then diffusion layer. */
+static inline uint64_t khazad_round_word(uint64_t a)
+{
+    return khazad_diffusion_word(khazad_sbox_word(a));
+}
+
+/* Round constant c_r is S-box outputs for 8r to 8r+7. */
+static inline uint64_t khazad_round_const_word(uint_fast8_t round)
+{
+#ifdef ENABLE_SBOX_SMALL
+    return khazad_sbox_word(0x0706050403020100u + round * 0x0808080808080808u);
+#else
+    return khazad_load_word(&khazad_sbox_table[round * KHAZAD_BLOCK_SIZE]);
+#endif
+}
+
+#endif
+
+#if defined(KHAZAD_T_TABLE)
+
+/* Diffusion layer only. The S-box is an involution, so applying it before
+ * the combined round function leaves just the diffusion. */
+static inline uint64_t khazad_diffusion_word(uint64_t a)
+{
+    return khazad_round_word(khazad_sbox_word(a));
+}
+
+static inline uint64_t khazad_round_const_word(uint_fast8_t round)
+{
+    return khazad_round_const[round];
+}
+
+#endif /* defined(KHAZAD_T_TABLE) */
+
+#ifdef KHAZAD_WORD_CORE
+
+static inline uint64_t key_schedule_round_word(uint64_t key_m1, uint64_t key_m2, uint_fast8_t round)
+{
+    return khazad_round_word(key_m1) ^ khazad_round_const_word(round) ^ key_m2;
+}
+
+/* One decryption round, on the state before its S-box layer is applied.
+ * Since the diffusion layer is linear,
+ *     H(S(a) ^ k) = H(S(a)) ^ H(k)
+ * which allows the combined round function to be used. */
+static inline uint64_t decrypt_round_word(uint64_t a, uint64_t key)
+{
+#ifdef KHAZAD_SWAR_CORE
+    /* Without T-tables, the diffusion layer is the costly part, so do it
+     * once, after adding the key. */
+    return khazad_diffusion_word(khazad_sbox_word(a) ^ key);
+#else
+    return khazad_round_word(a) ^ khazad_diffusion_word(key);
+#endif
+}
+
+/* Encrypt num_blocks (at most KHAZAD_INTERLEAVE_BLOCKS) blocks, one round at a
+ * time across all blocks. With a constant num_blocks, the inner loops unroll
+ * into independent dependency chains. */
+static inline void crypt_words(uint64_t p_state[], size_t num_blocks, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE])
+{
+    uint_fast8_t    round;
+    size_t          i;
+    uint64_t        key;
+
+    key = khazad_load_word(p_key_schedule);
+    for (i = 0; i < num_blocks; ++i)
+        p_state[i] ^= key;
+    for (round = 1u; round < KHAZAD_NUM_ROUNDS; ++round)
+    {
+        p_key_schedule += KHAZAD_BLOCK_SIZE;
+        key = khazad_load_word(p_key_schedule);
+        for (i = 0; i < num_blocks; ++i)
+            p_state[i] = khazad_round_word(p_state[i]) ^ key;
+    }
+    p_key_schedule += KHAZAD_BLOCK_SIZE;
+    key = khazad_load_word(p_key_schedule);
+    for (i = 0; i < num_blocks; ++i)
+        p_state[i] = khazad_sbox_word(p_state[i]) ^ key;
+}
+
+/* As for crypt_words(), but decrypting as khazad_decrypt() does.
+ * p_round_keys holds K8, then H(K7) down to H(K1), then K0, as prepared by
+ * decrypt_round_keys(). */
+static inline void decrypt_words(uint64_t p_state[], size_t num_blocks, const uint64_t p_round_keys[KHAZAD_NUM_ROUNDS + 1u])
+{
+    uint_fast8_t    round;
+    size_t          i;
+
+    for (i = 0; i < num_blocks; ++i)
+        p_state[i] ^= p_round_keys[0];
+    for (round = 1u; round < KHAZAD_NUM_ROUNDS; ++round)
+    {
+        for (i = 0; i < num_blocks; ++i)
+            p_state[i] = khazad_round_word(p_state[i]) ^ p_round_keys[round];
+    }
+    for (i = 0; i < num_blocks; ++i)
+        p_state[i] = khazad_sbox_word(p_state[i]) ^ p_round_keys[KHAZAD_NUM_ROUNDS];
+}
+
+/* Prepare the round keys for decrypt_words() from the regular key schedule,
+ * so the diffusion layer is applied to them once rather than per block. */
+static inline void decrypt_round_keys(uint64_t p_round_keys[KHAZAD_NUM_ROUNDS + 1u], const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE])
+{
+    uint_fast8_t    round;
+
+    p_key_schedule += KHAZAD_KEY_SCHEDULE_SIZE - KHAZAD_BLOCK_SIZE;
+    p_round_keys[0] = khazad_load_word(p_key_schedule);
+    for (round = 1u; round < KHAZAD_NUM_ROUNDS; ++round)
+    {
+        p_key_schedule -= KHAZAD_BLOCK_SIZE;
+        p_round_keys[round] = khazad_diffusion_word(khazad_load_word(p_key_schedule));
+    }
+    p_key_schedule -= KHAZAD_BLOCK_SIZE;
+    p_round_keys[KHAZAD_NUM_ROUNDS] = khazad_load_word(p_key_schedule);
+}
+
+/* Encrypt one block with round keys that are already loaded as words, so an
+ * iterated caller can keep them in registers. With the round keys from
+ * decrypt_round_keys(), this decrypts. */
+static inline uint64_t crypt_round_keys_word(uint64_t state, const uint64_t p_round_keys[KHAZAD_NUM_ROUNDS + 1u])
+{
+    uint_fast8_t    round;
+
+    state ^= p_round_keys[0];
+    for (round = 1u; round < KHAZAD_NUM_ROUNDS; ++round)
+        state = khazad_round_word(state) ^ p_round_keys[round];
+    return khazad_sbox_word(state) ^ p_round_keys[KHAZAD_NUM_ROUNDS];
+}
+
+/* As for crypt_words(), but with each block's own key schedule. */
+static inline void crypt_keyed_words(uint64_t p_state[], size_t num_blocks, const khazad_keyed_block_t * p_blocks)
+{
+    uint_fast8_t    round;
+    size_t          i;
+
+    for (i = 0; i < num_blocks; ++i)
+        p_state[i] ^= khazad_load_word(p_blocks[i].p_key_schedule);
+    for (round = 1u; round < KHAZAD_NUM_ROUNDS; ++round)
+    {
+        for (i = 0; i < num_blocks; ++i)
+            p_state[i] = khazad_round_word(p_state[i]) ^ khazad_load_word(p_blocks[i].p_key_schedule + round * KHAZAD_BLOCK_SIZE);
+    }
+    for (i = 0; i < num_blocks; ++i)
+        p_state[i] = khazad_sbox_word(p_state[i]) ^ khazad_load_word(p_blocks[i].p_key_schedule + KHAZAD_NUM_ROUNDS * KHAZAD_BLOCK_SIZE);
+}
+
+/* As for khazad_decrypt(), but on num_blocks (at most
+ * KHAZAD_INTERLEAVE_BLOCKS) blocks together, each with its own key
+ * schedule. */
+static inline void decrypt_keyed_words(uint64_t p_state[], size_t num_blocks, const khazad_keyed_block_t * p_blocks)
+{
+    uint_fast8_t    round;
+    size_t          i;
+
+    for (i = 0; i < num_blocks; ++i)
+        p_state[i] ^= khazad_load_word(p_blocks[i].p_key_schedule + KHAZAD_NUM_ROUNDS * KHAZAD_BLOCK_SIZE);
+    for (round = KHAZAD_NUM_ROUNDS - 1u; round >= 1u; --round)
+    {
+        for (i = 0; i < num_blocks; ++i)
+            p_state[i] = decrypt_round_word(p_state[i], khazad_load_word(p_blocks[i].p_key_schedule + round * KHAZAD_BLOCK_SIZE));
+    }
+    for (i = 0; i < num_blocks; ++i)
+        p_state[i] = khazad_sbox_word(p_state[i]) ^ khazad_load_word(p_blocks[i].p_key_schedule);
+}
+
+/* Calculate the key schedules of num_keys (at most KHAZAD_INTERLEAVE_BLOCKS)
+ * keys, one round at a time across all keys, as for crypt_words(). */
+static inline void key_schedule_words(uint8_t * p_key_schedules, const uint8_t * p_keys, size_t num_keys)
+{
+    uint_fast8_t    round;
+    size_t          i;
+    uint64_t        key_m2[KHAZAD_INTERLEAVE_BLOCKS];
+    uint64_t        key_m1[KHAZAD_INTERLEAVE_BLOCKS];
+    uint64_t        key;
+
+    for (i = 0; i < num_keys; ++i)
+    {
+        key_m2[i] = khazad_load_word(p_keys + i * KHAZAD_KEY_SIZE);
+        key_m1[i] = khazad_load_word(p_keys + i * KHAZAD_KEY_SIZE + KHAZAD_BLOCK_SIZE);
+    }
+    for (round = 0; round < (KHAZAD_NUM_ROUNDS + 1u); ++round)
+    {
+        for (i = 0; i < num_keys; ++i)
+        {
+            key = key_schedule_round_word(key_m1[i], key_m2[i], round);
+            khazad_store_word(p_key_schedules + i * KHAZAD_KEY_SCHEDULE_SIZE + round * KHAZAD_BLOCK_SIZE, key);
+            key_m2[i] = key_m1[i];
+            key_m1[i] = key;
+        }
+    }
+}
+
+/* Khazad encryption with on-the-fly key schedule calculation, of the block
+ * p_block, from the start key state in p_key. On exit, p_key holds the key
+ * state that khazad_otfks_encrypt() leaves in its key buffer. When inlined,
+ * p_key stays in registers. */
+static inline void otfks_encrypt_word(uint8_t p_block[KHAZAD_BLOCK_SIZE], uint64_t p_key[2])
+{
+    uint_fast8_t    round;
+    uint64_t        key_m2 = p_key[0];
+    uint64_t        key_m1 = p_key[1];
+    uint64_t        key;
+    uint64_t        state;
+
+    state = khazad_load_word(p_block) ^ key_m2;
+    for (round = 2; round <= KHAZAD_NUM_ROUNDS; ++round)
+    {
+        /* Do round function for round r-2 */
+        state = khazad_round_word(state) ^ key_m1;
+
+        /* Calculate round r key schedule. */
+        key = key_schedule_round_word(key_m1, key_m2, round);
+        key_m2 = key_m1;
+        key_m1 = key;
+    }
+    state = khazad_sbox_word(state) ^ key_m1;
+    khazad_store_word(p_block, state);
+
+    /* Leave the key state as the byte-oriented implementation leaves its key
+     * buffer: the last round key first. */
+    p_key[0] = key_m1;
+    p_key[1] = key_m2;
+}
+
+/* Khazad decryption with on-the-fly key schedule calculation, of the block
+ * p_block, from the start key state in p_key. On exit, p_key holds the
+ * encryption start key state. When inlined, p_key stays in registers. */
+static inline void otfks_decrypt_word(uint8_t p_block[KHAZAD_BLOCK_SIZE], uint64_t p_key[2])
+{
+    uint_fast8_t    round;
+    uint64_t        key_p2 = p_key[0];
+    uint64_t        key_p1 = p_key[1];
+    uint64_t        key;
+    uint64_t        state;
+
+    state = khazad_load_word(p_block) ^ key_p2;
+    for (round = KHAZAD_NUM_ROUNDS; round >= 2u; --round)
+    {
+        /* Do round function */
+        state = decrypt_round_word(state, key_p1);
+
+        /* Calculate round r-2 key schedule, from rounds r-1 and r. */
+        key = key_schedule_round_word(key_p1, key_p2, round);
+        key_p2 = key_p1;
+        key_p1 = key;
+    }
+    state = khazad_sbox_word(state) ^ key_p1;
+    khazad_store_word(p_block, state);
+
+    p_key[0] = key_p1;
+    p_key[1] = key_p2;
+}
+
+#else /* KHAZAD_WORD_CORE */
+
 static inline void round_func(uint8_t p_block[KHAZAD_BLOCK_SIZE], const uint8_t p_key_schedule_block[KHAZAD_BLOCK_SIZE])
 {
     khazad_sbox_apply_block(p_block);
@@ -160,10 +668,424 @@ static inline void decrypt_round_func(uint8_t p_block[KHAZAD_BLOCK_SIZE], const
     khazad_sbox_apply_block(p_block);
 }
 
+#endif /* KHAZAD_WORD_CORE */
+
 /*****************************************************************************
  * Functions
  ****************************************************************************/
 
+#ifdef KHAZAD_WORD_CORE
+
+/* Khazad encryption and decryption.
+ * p_block points to a 16-byte buffer of data to encrypt/decrypt. Encryption/
+ * decryption is done in-place in that buffer.
+ * p_key_schedule points to the full calculated key schedule. If the key
+ * schedule was calculated with khazad_key_schedule(), then encryption is done.
+ * If the key schedule was calculated with khazad_decrypt_key_schedule(), then
+ * decryption is done.
+ */
+void khazad_crypt(uint8_t p_block[KHAZAD_BLOCK_SIZE], const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE])
+{
+    uint_fast8_t    round;
+    uint64_t        state;
+
+    state = khazad_load_word(p_block) ^ khazad_load_word(p_key_schedule);
+    for (round = 1u; round < KHAZAD_NUM_ROUNDS; ++round)
+    {
+        p_key_schedule += KHAZAD_BLOCK_SIZE;
+        state = khazad_round_word(state) ^ khazad_load_word(p_key_schedule);
+    }
+    p_key_schedule += KHAZAD_BLOCK_SIZE;
+    state = khazad_sbox_word(state) ^ khazad_load_word(p_key_schedule);
+    khazad_store_word(p_block, state);
+}
+
+/* This decrypt function uses the regular key schedule created by
+ * khazad_key_schedule().
+ *
+ * The state is carried between rounds before its S-box layer is applied, so
+ * that the combined S-box and diffusion round function can be used. See
+ * decrypt_round_word(). With T-tables, the inner round keys are transformed
+ * once, by decrypt_round_keys(), so each round is just the table lookups of
+ * the combined round function, as for khazad_crypt(). The key transform
+ * doesn't depend on the block, so it is off the rounds' critical path.
+ */
+void khazad_decrypt(uint8_t p_block[KHAZAD_BLOCK_SIZE], const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE])
+{
+#ifdef KHAZAD_SWAR_CORE
+    uint_fast8_t    round;
+    uint64_t        state;
+
+    p_key_schedule += KHAZAD_KEY_SCHEDULE_SIZE - KHAZAD_BLOCK_SIZE;
+    state = khazad_load_word(p_block) ^ khazad_load_word(p_key_schedule);
+    for (round = 1u; round < KHAZAD_NUM_ROUNDS; ++round)
+    {
+        p_key_schedule -= KHAZAD_BLOCK_SIZE;
+        state = decrypt_round_word(state, khazad_load_word(p_key_schedule));
+    }
+    p_key_schedule -= KHAZAD_BLOCK_SIZE;
+    state = khazad_sbox_word(state) ^ khazad_load_word(p_key_schedule);
+    khazad_store_word(p_block, state);
+#else
+    uint64_t        round_keys[KHAZAD_NUM_ROUNDS + 1u];
+
+    decrypt_round_keys(round_keys, p_key_schedule);
+    khazad_store_word(p_block, crypt_round_keys_word(khazad_load_word(p_block), round_keys));
+#endif
+}
+
+/* Khazad encryption of one block, iterated num_iterations times: the block is
+ * encrypted, then the result encrypted again, and so on.
+ * p_block points to an 8-byte block, encrypted in-place.
+ * p_key_schedule is as for khazad_crypt(). The round keys are loaded once, and
+ * the block and round keys are kept in local variables across iterations,
+ * rather than loaded and stored again by each call of khazad_crypt(). This
+ * suits key stretching, and the iterated test vectors.
+ */
+void khazad_crypt_iterate(uint8_t p_block[KHAZAD_BLOCK_SIZE], const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE], size_t num_iterations)
+{
+    uint64_t        round_keys[KHAZAD_NUM_ROUNDS + 1u];
+    uint64_t        state;
+    uint_fast8_t    round;
+
+    for (round = 0; round < (KHAZAD_NUM_ROUNDS + 1u); ++round)
+        round_keys[round] = khazad_load_word(p_key_schedule + round * KHAZAD_BLOCK_SIZE);
+    state = khazad_load_word(p_block);
+    for (; num_iterations; --num_iterations)
+        state = crypt_round_keys_word(state, round_keys);
+    khazad_store_word(p_block, state);
+}
+
+/* Khazad decryption of one block, iterated num_iterations times, reversing
+ * khazad_crypt_iterate().
+ * p_key_schedule is as for khazad_decrypt(), calculated with
+ * khazad_key_schedule(). Otherwise as for khazad_crypt_iterate().
+ */
+void khazad_decrypt_iterate(uint8_t p_block[KHAZAD_BLOCK_SIZE], const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE], size_t num_iterations)
+{
+    uint64_t        round_keys[KHAZAD_NUM_ROUNDS + 1u];
+    uint64_t        state;
+
+    decrypt_round_keys(round_keys, p_key_schedule);
+    state = khazad_load_word(p_block);
+    for (; num_iterations; --num_iterations)
+        state = crypt_round_keys_word(state, round_keys);
+    khazad_store_word(p_block, state);
+}
+
+/* Calculate full key schedule for Khazad encryption (or decryption).
+ * p_key_schedule points to a 72-byte buffer of data to store the key schedule.
+ * If the key schedule is used with khazad_crypt(), then encryption is done.
+ * If the key schedule is used with khazad_decrypt(), then decryption is done.
+ */
+void khazad_key_schedule(uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE], const uint8_t p_key[KHAZAD_KEY_SIZE])
+{
+    uint_fast8_t    round;
+    uint64_t        key_m2 = khazad_load_word(p_key);
+    uint64_t        key_m1 = khazad_load_word(p_key + KHAZAD_BLOCK_SIZE);
+    uint64_t        key;
+
+    for (round = 0; round < (KHAZAD_NUM_ROUNDS + 1u); ++round)
+    {
+        key = key_schedule_round_word(key_m1, key_m2, round);
+        khazad_store_word(p_key_schedule, key);
+        p_key_schedule += KHAZAD_BLOCK_SIZE;
+
+        key_m2 = key_m1;
+        key_m1 = key;
+    }
+}
+
+/* Calculate the full key schedule for Khazad encryption from the encryption
+ * start key state for on-the-fly key schedule calculation, as from
+ * khazad_otfks_encrypt_start_key(), instead of from the Khazad key.
+ * p_key_schedule points to a 72-byte buffer of data to store the key schedule,
+ * which is the same as from khazad_key_schedule() for the original key. The
+ * start key state is the first 16 bytes of it, so only the remaining rounds
+ * are calculated.
+ */
+void khazad_key_schedule_from_otfks_start_key(uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE], const uint8_t p_encrypt_start_key[KHAZAD_KEY_SIZE])
+{
+    uint_fast8_t    round;
+    uint64_t        key_m2 = khazad_load_word(p_encrypt_start_key);
+    uint64_t        key_m1 = khazad_load_word(p_encrypt_start_key + KHAZAD_BLOCK_SIZE);
+    uint64_t        key;
+
+    khazad_store_word(p_key_schedule, key_m2);
+    khazad_store_word(p_key_schedule + KHAZAD_BLOCK_SIZE, key_m1);
+    p_key_schedule += 2u * KHAZAD_BLOCK_SIZE;
+    for (round = 2u; round < (KHAZAD_NUM_ROUNDS + 1u); ++round)
+    {
+        key = key_schedule_round_word(key_m1, key_m2, round);
+        khazad_store_word(p_key_schedule, key);
+        p_key_schedule += KHAZAD_BLOCK_SIZE;
+
+        key_m2 = key_m1;
+        key_m1 = key;
+    }
+}
+
+/* Khazad encryption of one block, calculating the full key schedule at the
+ * same time.
+ * p_block points to an 8-byte block of plain data, encrypted in-place.
+ * p_key is the 16-byte Khazad key. Its key schedule, as from
+ * khazad_key_schedule(), is written to p_key_schedule as each round key is
+ * calculated, ready for the blocks that follow. For the first block with a
+ * new key, this is quicker than khazad_key_schedule() then khazad_crypt(),
+ * since the round keys are used as they are calculated, and the key schedule
+ * and block rounds can overlap.
+ */
+void khazad_crypt_and_expand(uint8_t p_block[KHAZAD_BLOCK_SIZE], uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE], const uint8_t p_key[KHAZAD_KEY_SIZE])
+{
+    uint_fast8_t    round;
+    uint64_t        key_m2 = khazad_load_word(p_key);
+    uint64_t        key_m1 = khazad_load_word(p_key + KHAZAD_BLOCK_SIZE);
+    uint64_t        key;
+    uint64_t        state;
+
+    key = key_schedule_round_word(key_m1, key_m2, 0);
+    khazad_store_word(p_key_schedule, key);
+    state = khazad_load_word(p_block) ^ key;
+    key_m2 = key_m1;
+    key_m1 = key;
+    for (round = 1u; round < KHAZAD_NUM_ROUNDS; ++round)
+    {
+        key = key_schedule_round_word(key_m1, key_m2, round);
+        khazad_store_word(p_key_schedule + round * KHAZAD_BLOCK_SIZE, key);
+        state = khazad_round_word(state) ^ key;
+        key_m2 = key_m1;
+        key_m1 = key;
+    }
+    key = key_schedule_round_word(key_m1, key_m2, KHAZAD_NUM_ROUNDS);
+    khazad_store_word(p_key_schedule + KHAZAD_NUM_ROUNDS * KHAZAD_BLOCK_SIZE, key);
+    state = khazad_sbox_word(state) ^ key;
+    khazad_store_word(p_block, state);
+}
+
+/* Calculate full key schedule for Khazad decryption using the common crypt
+ * function khazad_crypt().
+ * p_key_schedule points to a 72-byte buffer of data to store the key schedule.
+ * This key schedule is suitable for use with khazad_crypt() to do decryption.
+ */
+void khazad_decrypt_key_schedule(uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE], const uint8_t p_key[KHAZAD_KEY_SIZE])
+{
+    uint_fast8_t    round;
+    uint64_t        key_m2 = khazad_load_word(p_key);
+    uint64_t        key_m1 = khazad_load_word(p_key + KHAZAD_BLOCK_SIZE);
+    uint64_t        key;
+
+    /* Store in reverse order, and apply matrix multiply to rounds 1 to r-1. */
+    p_key_schedule += KHAZAD_KEY_SCHEDULE_SIZE;
+    for (round = 0; round < (KHAZAD_NUM_ROUNDS + 1u); ++round)
+    {
+        key = key_schedule_round_word(key_m1, key_m2, round);
+        p_key_schedule -= KHAZAD_BLOCK_SIZE;
+        if (round == 0 || round == KHAZAD_NUM_ROUNDS)
+            khazad_store_word(p_key_schedule, key);
+        else
+            khazad_store_word(p_key_schedule, khazad_diffusion_word(key));
+
+        key_m2 = key_m1;
+        key_m1 = key;
+    }
+}
+
+/* Calculate the key schedule for Khazad decryption using the common crypt
+ * function khazad_crypt(), from an already calculated encryption key schedule,
+ * without repeating the key schedule rounds.
+ * p_encrypt_key_schedule points to a key schedule calculated with
+ * khazad_key_schedule(), and the decryption key schedule is stored in
+ * p_key_schedule. The two may be the same buffer, but must not otherwise
+ * overlap.
+ * The conversion is its own inverse, so it also converts a decryption key
+ * schedule back to an encryption key schedule.
+ */
+void khazad_decrypt_key_schedule_from_encrypt(uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE], const uint8_t p_encrypt_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE])
+{
+    uint_fast8_t    round;
+    uint64_t        key_0;
+    uint64_t        key_1;
+    uint8_t       * p_key_1 = p_key_schedule + KHAZAD_KEY_SCHEDULE_SIZE - KHAZAD_BLOCK_SIZE;
+    const uint8_t * p_encrypt_key_1 = p_encrypt_key_schedule + KHAZAD_KEY_SCHEDULE_SIZE - KHAZAD_BLOCK_SIZE;
+
+    /* Swap round keys r and 8-r in pairs, so it works in-place. The first and
+     * last round keys are used as they are, and the diffusion layer is applied
+     * to rounds 1 to r-1. */
+    key_0 = khazad_load_word(p_encrypt_key_schedule);
+    key_1 = khazad_load_word(p_encrypt_key_1);
+    khazad_store_word(p_key_schedule, key_1);
+    khazad_store_word(p_key_1, key_0);
+    for (round = 1u; round < (KHAZAD_NUM_ROUNDS + 1u) / 2u; ++round)
+    {
+        p_key_schedule += KHAZAD_BLOCK_SIZE;
+        p_encrypt_key_schedule += KHAZAD_BLOCK_SIZE;
+        p_key_1 -= KHAZAD_BLOCK_SIZE;
+        p_encrypt_key_1 -= KHAZAD_BLOCK_SIZE;
+        key_0 = khazad_diffusion_word(khazad_load_word(p_encrypt_key_schedule));
+        key_1 = khazad_diffusion_word(khazad_load_word(p_encrypt_key_1));
+        khazad_store_word(p_key_schedule, key_1);
+        khazad_store_word(p_key_1, key_0);
+    }
+    /* The middle round key stays in place. */
+    p_key_schedule += KHAZAD_BLOCK_SIZE;
+    p_encrypt_key_schedule += KHAZAD_BLOCK_SIZE;
+    khazad_store_word(p_key_schedule, khazad_diffusion_word(khazad_load_word(p_encrypt_key_schedule)));
+}
+
+/* Khazad encryption and decryption of multiple blocks.
+ * p_src points to num_blocks 8-byte blocks, stored contiguously, and the
+ * result is written to p_dst. p_dst may equal p_src, but the buffers must not
+ * otherwise overlap.
+ * p_key_schedule is as for khazad_crypt().
+ * The word cores (T-table and SWAR) process up to 4 independent blocks
+ * together, so their rounds overlap; the byte core processes one block at a
+ * time. With the x86 SIMD kernels, the kernel selected at run time (see
+ * khazad_kernel_name()) is used instead, with several blocks per register.
+ */
+void khazad_crypt_blocks(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE])
+{
+    uint64_t    state[KHAZAD_INTERLEAVE_BLOCKS];
+    size_t      group_blocks;
+    size_t      i;
+
+    while (num_blocks)
+    {
+        group_blocks = (num_blocks < KHAZAD_INTERLEAVE_BLOCKS) ? num_blocks : KHAZAD_INTERLEAVE_BLOCKS;
+        for (i = 0; i < group_blocks; ++i)
+            state[i] = khazad_load_word(p_src + i * KHAZAD_BLOCK_SIZE);
+        if (group_blocks == KHAZAD_INTERLEAVE_BLOCKS)
+            crypt_words(state, KHAZAD_INTERLEAVE_BLOCKS, p_key_schedule);
+        else
+            crypt_words(state, group_blocks, p_key_schedule);
+        for (i = 0; i < group_blocks; ++i)
+            khazad_store_word(p_dst + i * KHAZAD_BLOCK_SIZE, state[i]);
+        p_dst += group_blocks * KHAZAD_BLOCK_SIZE;
+        p_src += group_blocks * KHAZAD_BLOCK_SIZE;
+        num_blocks -= group_blocks;
+    }
+}
+
+/* Khazad decryption of multiple blocks.
+ * p_src points to num_blocks 8-byte blocks of encrypted data, stored
+ * contiguously, and the result is written to p_dst. p_dst may equal p_src, but
+ * the buffers must not otherwise overlap.
+ * p_key_schedule is as for khazad_decrypt(), calculated with
+ * khazad_key_schedule().
+ */
+void khazad_decrypt_blocks(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE])
+{
+    uint64_t    round_keys[KHAZAD_NUM_ROUNDS + 1u];
+    uint64_t    state[KHAZAD_INTERLEAVE_BLOCKS];
+    size_t      group_blocks;
+    size_t      i;
+
+    decrypt_round_keys(round_keys, p_key_schedule);
+    while (num_blocks)
+    {
+        group_blocks = (num_blocks < KHAZAD_INTERLEAVE_BLOCKS) ? num_blocks : KHAZAD_INTERLEAVE_BLOCKS;
+        for (i = 0; i < group_blocks; ++i)
+            state[i] = khazad_load_word(p_src + i * KHAZAD_BLOCK_SIZE);
+        if (group_blocks == KHAZAD_INTERLEAVE_BLOCKS)
+            decrypt_words(state, KHAZAD_INTERLEAVE_BLOCKS, round_keys);
+        else
+            decrypt_words(state, group_blocks, round_keys);
+        for (i = 0; i < group_blocks; ++i)
+            khazad_store_word(p_dst + i * KHAZAD_BLOCK_SIZE, state[i]);
+        p_dst += group_blocks * KHAZAD_BLOCK_SIZE;
+        p_src += group_blocks * KHAZAD_BLOCK_SIZE;
+        num_blocks -= group_blocks;
+    }
+}
+
+/* Calculate the full key schedules for Khazad encryption (or decryption) of
+ * several keys.
+ * p_keys points to num_keys 16-byte keys, stored contiguously, and
+ * p_key_schedules to a buffer for num_keys 72-byte key schedules, in the same
+ * format as from khazad_key_schedule().
+ * The word cores process up to 4 keys together, so their rounds overlap,
+ * which is faster than separate calls of khazad_key_schedule() when there are
+ * many keys to set up; the byte core calculates one key schedule at a time.
+ * With the x86 SIMD kernels, the kernel selected at run time is used instead,
+ * with several keys per register.
+ */
+void khazad_key_schedule_multi(uint8_t * p_key_schedules, const uint8_t * p_keys, size_t num_keys)
+{
+    size_t      group_keys;
+
+    while (num_keys)
+    {
+        group_keys = (num_keys < KHAZAD_INTERLEAVE_BLOCKS) ? num_keys : KHAZAD_INTERLEAVE_BLOCKS;
+        if (group_keys == KHAZAD_INTERLEAVE_BLOCKS)
+            key_schedule_words(p_key_schedules, p_keys, KHAZAD_INTERLEAVE_BLOCKS);
+        else
+            key_schedule_words(p_key_schedules, p_keys, group_keys);
+        p_key_schedules += group_keys * KHAZAD_KEY_SCHEDULE_SIZE;
+        p_keys += group_keys * KHAZAD_KEY_SIZE;
+        num_keys -= group_keys;
+    }
+}
+
+/* Khazad encryption and decryption of multiple blocks, each with its own key
+ * schedule.
+ * p_blocks points to an array of num_blocks entries, each giving a block to
+ * encrypt/decrypt in-place and the key schedule to use for it, as for
+ * khazad_crypt(). The blocks must not overlap, but may share key schedules.
+ * The word cores process up to 4 blocks with different keys together, so
+ * their rounds overlap, which is faster than separate calls of khazad_crypt()
+ * when there are many blocks with few per key; the byte core processes one
+ * block at a time. With the x86 SIMD kernels, the kernel selected at run time
+ * is used instead, with several blocks per register.
+ */
+void khazad_crypt_keyed_blocks(const khazad_keyed_block_t * p_blocks, size_t num_blocks)
+{
+    uint64_t    state[KHAZAD_INTERLEAVE_BLOCKS];
+    size_t      group_blocks;
+    size_t      i;
+
+    while (num_blocks)
+    {
+        group_blocks = (num_blocks < KHAZAD_INTERLEAVE_BLOCKS) ? num_blocks : KHAZAD_INTERLEAVE_BLOCKS;
+        for (i = 0; i < group_blocks; ++i)
+            state[i] = khazad_load_word(p_blocks[i].p_block);
+        if (group_blocks == KHAZAD_INTERLEAVE_BLOCKS)
+            crypt_keyed_words(state, KHAZAD_INTERLEAVE_BLOCKS, p_blocks);
+        else
+            crypt_keyed_words(state, group_blocks, p_blocks);
+        for (i = 0; i < group_blocks; ++i)
+            khazad_store_word(p_blocks[i].p_block, state[i]);
+        p_blocks += group_blocks;
+        num_blocks -= group_blocks;
+    }
+}
+
+/* Khazad decryption of multiple blocks, each with its own key schedule.
+ * p_blocks is as for khazad_crypt_keyed_blocks(), but with key schedules as
+ * for khazad_decrypt(), calculated with khazad_key_schedule().
+ */
+void khazad_decrypt_keyed_blocks(const khazad_keyed_block_t * p_blocks, size_t num_blocks)
+{
+    uint64_t    state[KHAZAD_INTERLEAVE_BLOCKS];
+    size_t      group_blocks;
+    size_t      i;
+
+    while (num_blocks)
+    {
+        group_blocks = (num_blocks < KHAZAD_INTERLEAVE_BLOCKS) ? num_blocks : KHAZAD_INTERLEAVE_BLOCKS;
+        for (i = 0; i < group_blocks; ++i)
+            state[i] = khazad_load_word(p_blocks[i].p_block);
+        if (group_blocks == KHAZAD_INTERLEAVE_BLOCKS)
+            decrypt_keyed_words(state, KHAZAD_INTERLEAVE_BLOCKS, p_blocks);
+        else
+            decrypt_keyed_words(state, group_blocks, p_blocks);
+        for (i = 0; i < group_blocks; ++i)
+            khazad_store_word(p_blocks[i].p_block, state[i]);
+        p_blocks += group_blocks;
+        num_blocks -= group_blocks;
+    }
+}
+
+#else /* KHAZAD_WORD_CORE */
+
 /* Khazad encryption and decryption.
  * p_block points to a 16-byte buffer of data to encrypt/decrypt. Encryption/
  * decryption is done in-place in that buffer.
@@ -216,6 +1138,31 @@ void khazad_decrypt(uint8_t p_block[KHAZAD_BLOCK_SIZE], const uint8_t p_key_sche
     khazad_add_block(p_block, p_key_schedule);
 }
 
+/* Khazad encryption of one block, iterated num_iterations times: the block is
+ * encrypted, then the result encrypted again, and so on.
+ * p_block points to an 8-byte block, encrypted in-place.
+ * p_key_schedule is as for khazad_crypt(). The round keys are loaded once, and
+ * the block and round keys are kept in local variables across iterations,
+ * rather than loaded and stored again by each call of khazad_crypt(). This
+ * suits key stretching, and the iterated test vectors.
+ */
+void khazad_crypt_iterate(uint8_t p_block[KHAZAD_BLOCK_SIZE], const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE], size_t num_iterations)
+{
+    for (; num_iterations; --num_iterations)
+        khazad_crypt(p_block, p_key_schedule);
+}
+
+/* Khazad decryption of one block, iterated num_iterations times, reversing
+ * khazad_crypt_iterate().
+ * p_key_schedule is as for khazad_decrypt(), calculated with
+ * khazad_key_schedule(). Otherwise as for khazad_crypt_iterate().
+ */
+void khazad_decrypt_iterate(uint8_t p_block[KHAZAD_BLOCK_SIZE], const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE], size_t num_iterations)
+{
+    for (; num_iterations; --num_iterations)
+        khazad_decrypt(p_block, p_key_schedule);
+}
+
 /* Calculate full key schedule for Khazad encryption (or decryption).
  * p_key_schedule points to a 72-byte buffer of data to store the key schedule.
  * If the key schedule is used with khazad_crypt(), then encryption is done.
@@ -240,19 +1187,103 @@ void khazad_key_schedule(uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE], const
     }
 }
 
+/* Calculate the full key schedule for Khazad encryption from the encryption
+ * start key state for on-the-fly key schedule calculation, as from
+ * khazad_otfks_encrypt_start_key(), instead of from the Khazad key.
+ * p_key_schedule points to a 72-byte buffer of data to store the key schedule,
+ * which is the same as from khazad_key_schedule() for the original key. The
+ * start key state is the first 16 bytes of it, so only the remaining rounds
+ * are calculated.
+ */
+void khazad_key_schedule_from_otfks_start_key(uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE], const uint8_t p_encrypt_start_key[KHAZAD_KEY_SIZE])
+{
+    uint_fast8_t    round;
+    uint8_t       * p_key_0;
+
+    memcpy(p_key_schedule, p_encrypt_start_key, KHAZAD_KEY_SIZE);
+    p_key_0 = p_key_schedule + 2u * KHAZAD_BLOCK_SIZE;
+    for (round = 2u; round < (KHAZAD_NUM_ROUNDS + 1u); ++round)
+    {
+        memcpy(p_key_0, p_key_0 - KHAZAD_BLOCK_SIZE, KHAZAD_BLOCK_SIZE);
+        key_schedule_round_func(p_key_0, round);
+        khazad_add_block(p_key_0, p_key_0 - 2u * KHAZAD_BLOCK_SIZE);
+        p_key_0 += KHAZAD_BLOCK_SIZE;
+    }
+}
+
+/* Khazad encryption of one block, calculating the full key schedule at the
+ * same time.
+ * p_block points to an 8-byte block of plain data, encrypted in-place.
+ * p_key is the 16-byte Khazad key. Its key schedule, as from
+ * khazad_key_schedule(), is written to p_key_schedule as each round key is
+ * calculated, ready for the blocks that follow. For the first block with a
+ * new key, this is quicker than khazad_key_schedule() then khazad_crypt(),
+ * since the round keys are used as they are calculated, and the key schedule
+ * and block rounds can overlap.
+ */
+void khazad_crypt_and_expand(uint8_t p_block[KHAZAD_BLOCK_SIZE], uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE], const uint8_t p_key[KHAZAD_KEY_SIZE])
+{
+    uint_fast8_t    round;
+    uint8_t       * p_key_0 = p_key_schedule;
+    const uint8_t * p_key_m2 = p_key;
+    const uint8_t * p_key_m1 = p_key + KHAZAD_BLOCK_SIZE;
+    uint8_t         block[KHAZAD_BLOCK_SIZE];
+
+    /* Work on a local copy of the block, which the compiler knows can't
+     * alias the key schedule. */
+    memcpy(block, p_block, KHAZAD_BLOCK_SIZE);
+    for (round = 0; ; ++round)
+    {
+        memcpy(p_key_0, p_key_m1, KHAZAD_BLOCK_SIZE);
+        key_schedule_round_func(p_key_0, round);
+        khazad_add_block(p_key_0, p_key_m2);
+
+        if (round >= KHAZAD_NUM_ROUNDS)
+            break;
+        if (round == 0)
+            khazad_add_block(block, p_key_0);
+        else
+            round_func(block, p_key_0);
+
+        p_key_m2 = p_key_m1;
+        p_key_m1 = p_key_0;
+        p_key_0 += KHAZAD_BLOCK_SIZE;
+    }
+    khazad_sbox_apply_block(block);
+    khazad_add_block(block, p_key_0);
+    memcpy(p_block, block, KHAZAD_BLOCK_SIZE);
+}
+
 /* Calculate full key schedule for Khazad decryption using the common crypt
  * function khazad_crypt().
  * p_key_schedule points to a 72-byte buffer of data to store the key schedule.
  * This key schedule is suitable for use with khazad_crypt() to do decryption.
  */
 void khazad_decrypt_key_schedule(uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE], const uint8_t p_key[KHAZAD_KEY_SIZE])
+{
+    khazad_key_schedule(p_key_schedule, p_key);
+    khazad_decrypt_key_schedule_from_encrypt(p_key_schedule, p_key_schedule);
+}
+
+/* Calculate the key schedule for Khazad decryption using the common crypt
+ * function khazad_crypt(), from an already calculated encryption key schedule,
+ * without repeating the key schedule rounds.
+ * p_encrypt_key_schedule points to a key schedule calculated with
+ * khazad_key_schedule(), and the decryption key schedule is stored in
+ * p_key_schedule. The two may be the same buffer, but must not otherwise
+ * overlap.
+ * The conversion is its own inverse, so it also converts a decryption key
+ * schedule back to an encryption key schedule.
+ */
+void khazad_decrypt_key_schedule_from_encrypt(uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE], const uint8_t p_encrypt_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE])
 {
     uint_fast8_t    round;
     uint8_t       * p_key_0;
     uint8_t       * p_key_1;
     uint8_t         key_temp[KHAZAD_BLOCK_SIZE];
 
-    khazad_key_schedule(p_key_schedule, p_key);
+    if (p_key_schedule != p_encrypt_key_schedule)
+        memcpy(p_key_schedule, p_encrypt_key_schedule, KHAZAD_KEY_SCHEDULE_SIZE);
 
     /* Reverse order */
     p_key_0 = p_key_schedule;
@@ -275,6 +1306,111 @@ void khazad_decrypt_key_schedule(uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE
     }
 }
 
+/* Khazad encryption and decryption of multiple blocks.
+ * p_src points to num_blocks 8-byte blocks, stored contiguously, and the
+ * result is written to p_dst. p_dst may equal p_src, but the buffers must not
+ * otherwise overlap.
+ * p_key_schedule is as for khazad_crypt().
+ * The word cores (T-table and SWAR) process up to 4 independent blocks
+ * together, so their rounds overlap; the byte core processes one block at a
+ * time. With the x86 SIMD kernels, the kernel selected at run time (see
+ * khazad_kernel_name()) is used instead, with several blocks per register.
+ */
+void khazad_crypt_blocks(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE])
+{
+    if (p_dst != p_src)
+        memcpy(p_dst, p_src, num_blocks * KHAZAD_BLOCK_SIZE);
+    for (; num_blocks; --num_blocks)
+    {
+        khazad_crypt(p_dst, p_key_schedule);
+        p_dst += KHAZAD_BLOCK_SIZE;
+    }
+}
+
+/* Khazad decryption of multiple blocks.
+ * p_src points to num_blocks 8-byte blocks of encrypted data, stored
+ * contiguously, and the result is written to p_dst. p_dst may equal p_src, but
+ * the buffers must not otherwise overlap.
+ * p_key_schedule is as for khazad_decrypt(), calculated with
+ * khazad_key_schedule().
+ */
+void khazad_decrypt_blocks(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE])
+{
+    if (p_dst != p_src)
+        memcpy(p_dst, p_src, num_blocks * KHAZAD_BLOCK_SIZE);
+    for (; num_blocks; --num_blocks)
+    {
+        khazad_decrypt(p_dst, p_key_schedule);
+        p_dst += KHAZAD_BLOCK_SIZE;
+    }
+}
+
+/* Calculate the full key schedules for Khazad encryption (or decryption) of
+ * several keys.
+ * p_keys points to num_keys 16-byte keys, stored contiguously, and
+ * p_key_schedules to a buffer for num_keys 72-byte key schedules, in the same
+ * format as from khazad_key_schedule().
+ * The word cores process up to 4 keys together, so their rounds overlap,
+ * which is faster than separate calls of khazad_key_schedule() when there are
+ * many keys to set up; the byte core calculates one key schedule at a time.
+ * With the x86 SIMD kernels, the kernel selected at run time is used instead,
+ * with several keys per register.
+ */
+void khazad_key_schedule_multi(uint8_t * p_key_schedules, const uint8_t * p_keys, size_t num_keys)
+{
+    for (; num_keys; --num_keys)
+    {
+        khazad_key_schedule(p_key_schedules, p_keys);
+        p_key_schedules += KHAZAD_KEY_SCHEDULE_SIZE;
+        p_keys += KHAZAD_KEY_SIZE;
+    }
+}
+
+/* Khazad encryption and decryption of multiple blocks, each with its own key
+ * schedule.
+ * p_blocks points to an array of num_blocks entries, each giving a block to
+ * encrypt/decrypt in-place and the key schedule to use for it, as for
+ * khazad_crypt(). The blocks must not overlap, but may share key schedules.
+ * The word cores process up to 4 blocks with different keys together, so
+ * their rounds overlap, which is faster than separate calls of khazad_crypt()
+ * when there are many blocks with few per key; the byte core processes one
+ * block at a time. With the x86 SIMD kernels, the kernel selected at run time
+ * is used instead, with several blocks per register.
+ */
+void khazad_crypt_keyed_blocks(const khazad_keyed_block_t * p_blocks, size_t num_blocks)
+{
+    for (; num_blocks; --num_blocks)
+    {
+        khazad_crypt(p_blocks->p_block, p_blocks->p_key_schedule);
+        ++p_blocks;
+    }
+}
+
+/* Khazad decryption of multiple blocks, each with its own key schedule.
+ * p_blocks is as for khazad_crypt_keyed_blocks(), but with key schedules as
+ * for khazad_decrypt(), calculated with khazad_key_schedule().
+ */
+void khazad_decrypt_keyed_blocks(const khazad_keyed_block_t * p_blocks, size_t num_blocks)
+{
+    for (; num_blocks; --num_blocks)
+    {
+        khazad_decrypt(p_blocks->p_block, p_blocks->p_key_schedule);
+        ++p_blocks;
+    }
+}
+
+#endif /* KHAZAD_WORD_CORE */
+
+/* Convert an encryption key schedule, calculated with khazad_key_schedule(),
+ * to a decryption key schedule for khazad_crypt(), in-place.
+ * This is the same as khazad_decrypt_key_schedule_from_encrypt() with the
+ * same buffer for both.
+ */
+void khazad_decrypt_key_schedule_in_place(uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE])
+{
+    khazad_decrypt_key_schedule_from_encrypt(p_key_schedule, p_key_schedule);
+}
+
 /* Calculate the starting key state needed for encryption with on-the-fly key
  * schedule calculation. The starting encryption key state is the first 16
  * bytes of the Khazad key schedule, which is not the Khazad key itself but two
@@ -309,6 +1445,243 @@ void khazad_otfks_decrypt_from_encrypt_start_key(uint8_t p_key[KHAZAD_KEY_SIZE])
     khazad_otfks_calc_key(p_key, 2u, KHAZAD_NUM_ROUNDS);
 }
 
+/* This calculates the encryption start key from the decryption start key,
+ * the reverse of khazad_otfks_decrypt_from_encrypt_start_key().
+ */
+void khazad_otfks_encrypt_from_decrypt_start_key(uint8_t p_key[KHAZAD_KEY_SIZE])
+{
+    khazad_otfks_calc_key_reverse(p_key, KHAZAD_NUM_ROUNDS, 2u);
+}
+
+/* Initialise an on-the-fly key schedule session for the Khazad key p_key.
+ */
+void khazad_otfks_session_init(khazad_otfks_session_t * p_session, const uint8_t p_key[KHAZAD_KEY_SIZE])
+{
+    memcpy(p_session->key_state, p_key, KHAZAD_KEY_SIZE);
+    khazad_otfks_encrypt_start_key(p_session->key_state);
+    p_session->flags = 0;
+}
+
+/* Clear an on-the-fly key schedule session, so no key material is left in
+ * memory. It must be initialised again before further use.
+ */
+void khazad_otfks_session_wipe(khazad_otfks_session_t * p_session)
+{
+    khazad_wipe(p_session, sizeof(*p_session));
+}
+
+/* Khazad encryption of the block p_block, in-place, with an on-the-fly key
+ * schedule session.
+ * The key state is left at the decryption end of the key schedule, so a
+ * following khazad_otfks_session_decrypt() starts straight away. After a
+ * decryption, it starts straight away too; only after another encryption
+ * must the key state first be taken back through the key schedule.
+ */
+void khazad_otfks_session_encrypt(khazad_otfks_session_t * p_session, uint8_t p_block[KHAZAD_BLOCK_SIZE])
+{
+    if (p_session->flags & KHAZAD_OTFKS_SESSION_DECRYPT_START)
+        khazad_otfks_encrypt_from_decrypt_start_key(p_session->key_state);
+    /* This leaves the decryption start key state. */
+    khazad_otfks_encrypt(p_block, p_session->key_state);
+    p_session->flags |= KHAZAD_OTFKS_SESSION_DECRYPT_START;
+}
+
+/* Khazad decryption of the block p_block, in-place, with an on-the-fly key
+ * schedule session. As for khazad_otfks_session_encrypt(), in the other
+ * direction.
+ */
+void khazad_otfks_session_decrypt(khazad_otfks_session_t * p_session, uint8_t p_block[KHAZAD_BLOCK_SIZE])
+{
+    if ((p_session->flags & KHAZAD_OTFKS_SESSION_DECRYPT_START) == 0)
+        khazad_otfks_decrypt_from_encrypt_start_key(p_session->key_state);
+    /* This leaves the encryption start key state. */
+    khazad_otfks_decrypt(p_block, p_session->key_state);
+    p_session->flags &= ~KHAZAD_OTFKS_SESSION_DECRYPT_START;
+}
+
+#ifdef KHAZAD_WORD_CORE
+
+/* Khazad encryption with on-the-fly key schedule calculation.
+ *
+ * p_block points to a 16-byte buffer of plain data to encrypt. Encryption
+ * is done in-place in that buffer.
+ * p_encrypt_start_key must initially point to a starting key state for
+ * encryption, which must be calculated from the Khazad key, by the function
+ * khazad_otfks_encrypt_start_key(). Key schedule is calculated on-the-fly in
+ * that buffer, so the buffer must re-initialised for subsequent encryption
+ * operations.
+ */
+void khazad_otfks_encrypt(uint8_t p_block[KHAZAD_BLOCK_SIZE], uint8_t p_encrypt_start_key[KHAZAD_KEY_SIZE])
+{
+    uint64_t        key[2];
+
+    key[0] = khazad_load_word(p_encrypt_start_key);
+    key[1] = khazad_load_word(p_encrypt_start_key + KHAZAD_BLOCK_SIZE);
+    otfks_encrypt_word(p_block, key);
+    khazad_store_word(p_encrypt_start_key, key[0]);
+    khazad_store_word(p_encrypt_start_key + KHAZAD_BLOCK_SIZE, key[1]);
+}
+
+/* Khazad decryption with on-the-fly key schedule calculation.
+ *
+ * p_block points to a 16-byte buffer of encrypted data to decrypt. Decryption
+ * is done in-place in that buffer.
+ * p_decrypt_start_key must initially point to a starting key state for
+ * decryption, which must be calculated from the Khazad key, by the function
+ * khazad_otfks_decrypt_start_key(). Key schedule is calculated on-the-fly in
+ * that buffer, so the buffer must re-initialised for subsequent encryption
+ * operations.
+ */
+void khazad_otfks_decrypt(uint8_t p_block[KHAZAD_BLOCK_SIZE], uint8_t p_decrypt_start_key[KHAZAD_KEY_SIZE])
+{
+    uint64_t        key[2];
+
+    key[0] = khazad_load_word(p_decrypt_start_key);
+    key[1] = khazad_load_word(p_decrypt_start_key + KHAZAD_BLOCK_SIZE);
+    otfks_decrypt_word(p_block, key);
+    /* The key buffer is left holding the encryption start key state. */
+    khazad_store_word(p_decrypt_start_key, key[0]);
+    khazad_store_word(p_decrypt_start_key + KHAZAD_BLOCK_SIZE, key[1]);
+}
+
+/* Khazad encryption with on-the-fly key schedule calculation, as for
+ * khazad_otfks_encrypt(), but leaving the start key state unchanged.
+ *
+ * The key schedule is calculated in local variables rather than in the
+ * p_encrypt_start_key buffer, so it needn't be restored before the next
+ * block, and one start key state can be used by several threads at once.
+ */
+void khazad_otfks_encrypt_const(uint8_t p_block[KHAZAD_BLOCK_SIZE], const uint8_t p_encrypt_start_key[KHAZAD_KEY_SIZE])
+{
+    uint64_t        key[2];
+
+    key[0] = khazad_load_word(p_encrypt_start_key);
+    key[1] = khazad_load_word(p_encrypt_start_key + KHAZAD_BLOCK_SIZE);
+    otfks_encrypt_word(p_block, key);
+}
+
+/* Khazad decryption with on-the-fly key schedule calculation, as for
+ * khazad_otfks_decrypt(), but leaving the start key state unchanged.
+ *
+ * The key schedule is calculated in local variables rather than in the
+ * p_decrypt_start_key buffer, so it needn't be restored before the next
+ * block, and one start key state can be used by several threads at once.
+ */
+void khazad_otfks_decrypt_const(uint8_t p_block[KHAZAD_BLOCK_SIZE], const uint8_t p_decrypt_start_key[KHAZAD_KEY_SIZE])
+{
+    uint64_t        key[2];
+
+    key[0] = khazad_load_word(p_decrypt_start_key);
+    key[1] = khazad_load_word(p_decrypt_start_key + KHAZAD_BLOCK_SIZE);
+    otfks_decrypt_word(p_block, key);
+}
+
+/* Khazad encryption of multiple blocks with on-the-fly key schedule
+ * calculation.
+ * p_src points to num_blocks 8-byte blocks of plain data, stored contiguously,
+ * and the result is written to p_dst. p_dst may equal p_src, but the buffers
+ * must not otherwise overlap.
+ * p_encrypt_start_key is as for khazad_otfks_encrypt_const(), and is left
+ * unchanged.
+ * Each round key is calculated once, and applied to a group of up to 64
+ * blocks before the next, so the blocks share the key schedule calculation,
+ * which still only needs the 16-byte key state.
+ */
+void khazad_otfks_encrypt_blocks(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const uint8_t p_encrypt_start_key[KHAZAD_KEY_SIZE])
+{
+    uint_fast8_t    round;
+    uint64_t        key_m2;
+    uint64_t        key_m1;
+    uint64_t        key;
+    uint8_t       * p_block;
+    size_t          group_blocks;
+    size_t          i;
+
+    if (p_dst != p_src)
+        memcpy(p_dst, p_src, num_blocks * KHAZAD_BLOCK_SIZE);
+    while (num_blocks)
+    {
+        group_blocks = (num_blocks < KHAZAD_OTFKS_GROUP_BLOCKS) ? num_blocks : KHAZAD_OTFKS_GROUP_BLOCKS;
+        key_m2 = khazad_load_word(p_encrypt_start_key);
+        key_m1 = khazad_load_word(p_encrypt_start_key + KHAZAD_BLOCK_SIZE);
+
+        for (i = 0, p_block = p_dst; i < group_blocks; ++i, p_block += KHAZAD_BLOCK_SIZE)
+            khazad_store_word(p_block, khazad_load_word(p_block) ^ key_m2);
+        for (round = 2; round <= KHAZAD_NUM_ROUNDS; ++round)
+        {
+            /* Do round function for round r-2 on all the blocks. */
+            for (i = 0, p_block = p_dst; i < group_blocks; ++i, p_block += KHAZAD_BLOCK_SIZE)
+                khazad_store_word(p_block, khazad_round_word(khazad_load_word(p_block)) ^ key_m1);
+
+            /* Calculate round r key schedule. */
+            key = key_schedule_round_word(key_m1, key_m2, round);
+            key_m2 = key_m1;
+            key_m1 = key;
+        }
+        for (i = 0, p_block = p_dst; i < group_blocks; ++i, p_block += KHAZAD_BLOCK_SIZE)
+            khazad_store_word(p_block, khazad_sbox_word(khazad_load_word(p_block)) ^ key_m1);
+
+        p_dst += group_blocks * KHAZAD_BLOCK_SIZE;
+        num_blocks -= group_blocks;
+    }
+}
+
+/* Khazad decryption of multiple blocks with on-the-fly key schedule
+ * calculation.
+ * p_src points to num_blocks 8-byte blocks of encrypted data, stored
+ * contiguously, and the result is written to p_dst. p_dst may equal p_src, but
+ * the buffers must not otherwise overlap.
+ * p_decrypt_start_key is as for khazad_otfks_decrypt_const(), and is left
+ * unchanged.
+ * As for khazad_otfks_encrypt_blocks(), each round key is calculated once per
+ * group of up to 64 blocks.
+ */
+void khazad_otfks_decrypt_blocks(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const uint8_t p_decrypt_start_key[KHAZAD_KEY_SIZE])
+{
+    uint_fast8_t    round;
+    uint64_t        key_p2;
+    uint64_t        key_p1;
+    uint64_t        key;
+    uint8_t       * p_block;
+    size_t          group_blocks;
+    size_t          i;
+
+    if (p_dst != p_src)
+        memcpy(p_dst, p_src, num_blocks * KHAZAD_BLOCK_SIZE);
+    while (num_blocks)
+    {
+        group_blocks = (num_blocks < KHAZAD_OTFKS_GROUP_BLOCKS) ? num_blocks : KHAZAD_OTFKS_GROUP_BLOCKS;
+        key_p2 = khazad_load_word(p_decrypt_start_key);
+        key_p1 = khazad_load_word(p_decrypt_start_key + KHAZAD_BLOCK_SIZE);
+
+        for (i = 0, p_block = p_dst; i < group_blocks; ++i, p_block += KHAZAD_BLOCK_SIZE)
+            khazad_store_word(p_block, khazad_load_word(p_block) ^ key_p2);
+        for (round = KHAZAD_NUM_ROUNDS; round >= 2u; --round)
+        {
+            /* Do round function on all the blocks. */
+            for (i = 0, p_block = p_dst; i < group_blocks; ++i, p_block += KHAZAD_BLOCK_SIZE)
+                khazad_store_word(p_block, decrypt_round_word(khazad_load_word(p_block), key_p1));
+
+            /* Calculate round r-2 key schedule, from rounds r-1 and r. */
+            key = key_schedule_round_word(key_p1, key_p2, round);
+            key_p2 = key_p1;
+            key_p1 = key;
+        }
+        for (i = 0, p_block = p_dst; i < group_blocks; ++i, p_block += KHAZAD_BLOCK_SIZE)
+            khazad_store_word(p_block, khazad_sbox_word(khazad_load_word(p_block)) ^ key_p1);
+
+        p_dst += group_blocks * KHAZAD_BLOCK_SIZE;
+        num_blocks -= group_blocks;
+    }
+}
+
+void _khazad_sbox_apply_block_for_test(uint8_t p_block[KHAZAD_BLOCK_SIZE])
+{
+    khazad_store_word(p_block, khazad_sbox_word(khazad_load_word(p_block)));
+}
+
+#else /* KHAZAD_WORD_CORE */
+
 /* Khazad encryption with on-the-fly key schedule calculation.
  *
  * p_block points to a 16-byte buffer of plain data to encrypt. Encryption
@@ -393,15 +1766,240 @@ void khazad_otfks_decrypt(uint8_t p_block[KHAZAD_BLOCK_SIZE], uint8_t p_decrypt_
     khazad_add_block(p_block, p_key_schedule_m1);
 }
 
+/* Khazad encryption with on-the-fly key schedule calculation, as for
+ * khazad_otfks_encrypt(), but leaving the start key state unchanged.
+ *
+ * The key schedule is calculated in local variables rather than in the
+ * p_encrypt_start_key buffer, so it needn't be restored before the next
+ * block, and one start key state can be used by several threads at once.
+ */
+void khazad_otfks_encrypt_const(uint8_t p_block[KHAZAD_BLOCK_SIZE], const uint8_t p_encrypt_start_key[KHAZAD_KEY_SIZE])
+{
+    uint8_t         key[KHAZAD_KEY_SIZE];
+
+    memcpy(key, p_encrypt_start_key, KHAZAD_KEY_SIZE);
+    khazad_otfks_encrypt(p_block, key);
+}
+
+/* Khazad decryption with on-the-fly key schedule calculation, as for
+ * khazad_otfks_decrypt(), but leaving the start key state unchanged.
+ *
+ * The key schedule is calculated in local variables rather than in the
+ * p_decrypt_start_key buffer, so it needn't be restored before the next
+ * block, and one start key state can be used by several threads at once.
+ */
+void khazad_otfks_decrypt_const(uint8_t p_block[KHAZAD_BLOCK_SIZE], const uint8_t p_decrypt_start_key[KHAZAD_KEY_SIZE])
+{
+    uint8_t         key[KHAZAD_KEY_SIZE];
+
+    memcpy(key, p_decrypt_start_key, KHAZAD_KEY_SIZE);
+    khazad_otfks_decrypt(p_block, key);
+}
+
+/* Khazad encryption of multiple blocks with on-the-fly key schedule
+ * calculation.
+ * p_src points to num_blocks 8-byte blocks of plain data, stored contiguously,
+ * and the result is written to p_dst. p_dst may equal p_src, but the buffers
+ * must not otherwise overlap.
+ * p_encrypt_start_key is as for khazad_otfks_encrypt_const(), and is left
+ * unchanged.
+ * Each round key is calculated once, and applied to a group of up to 64
+ * blocks before the next, so the blocks share the key schedule calculation,
+ * which still only needs the 16-byte key state.
+ */
+void khazad_otfks_encrypt_blocks(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const uint8_t p_encrypt_start_key[KHAZAD_KEY_SIZE])
+{
+    uint_fast8_t    round;
+    uint8_t         key[KHAZAD_KEY_SIZE];
+    uint8_t       * p_key_schedule;
+    uint8_t       * p_key_schedule_m1;
+    uint8_t       * p_key_schedule_temp;
+    uint8_t         key_temp[KHAZAD_BLOCK_SIZE];
+    uint8_t       * p_block;
+    size_t          group_blocks;
+    size_t          i;
+
+    if (p_dst != p_src)
+        memcpy(p_dst, p_src, num_blocks * KHAZAD_BLOCK_SIZE);
+    while (num_blocks)
+    {
+        group_blocks = (num_blocks < KHAZAD_OTFKS_GROUP_BLOCKS) ? num_blocks : KHAZAD_OTFKS_GROUP_BLOCKS;
+        memcpy(key, p_encrypt_start_key, KHAZAD_KEY_SIZE);
+        p_key_schedule = key + KHAZAD_BLOCK_SIZE;
+        p_key_schedule_m1 = key;
+
+        for (i = 0, p_block = p_dst; i < group_blocks; ++i, p_block += KHAZAD_BLOCK_SIZE)
+            khazad_add_block(p_block, p_key_schedule_m1);
+        for (round = 2; ; ++round)
+        {
+            /* Do round function for round r-2 on all the blocks. */
+            for (i = 0, p_block = p_dst; i < group_blocks; ++i, p_block += KHAZAD_BLOCK_SIZE)
+                round_func(p_block, p_key_schedule);
+
+            /* Get round r-1 key schedule and apply round function. */
+            memcpy(key_temp, p_key_schedule, KHAZAD_BLOCK_SIZE);
+            key_schedule_round_func(key_temp, round);
+            /* Add round r-2 key schedule, overwriting it. This becomes round r key schedule. */
+            khazad_add_block(p_key_schedule_m1, key_temp);
+
+            if (round >= KHAZAD_NUM_ROUNDS)
+                break;
+
+            /* Swap key schedule pointers. */
+            p_key_schedule_temp = p_key_schedule_m1;
+            p_key_schedule_m1 = p_key_schedule;
+            p_key_schedule = p_key_schedule_temp;
+        }
+        for (i = 0, p_block = p_dst; i < group_blocks; ++i, p_block += KHAZAD_BLOCK_SIZE)
+        {
+            khazad_sbox_apply_block(p_block);
+            khazad_add_block(p_block, p_key_schedule_m1);
+        }
+
+        p_dst += group_blocks * KHAZAD_BLOCK_SIZE;
+        num_blocks -= group_blocks;
+    }
+}
+
+/* Khazad decryption of multiple blocks with on-the-fly key schedule
+ * calculation.
+ * p_src points to num_blocks 8-byte blocks of encrypted data, stored
+ * contiguously, and the result is written to p_dst. p_dst may equal p_src, but
+ * the buffers must not otherwise overlap.
+ * p_decrypt_start_key is as for khazad_otfks_decrypt_const(), and is left
+ * unchanged.
+ * As for khazad_otfks_encrypt_blocks(), each round key is calculated once per
+ * group of up to 64 blocks.
+ */
+void khazad_otfks_decrypt_blocks(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const uint8_t p_decrypt_start_key[KHAZAD_KEY_SIZE])
+{
+    uint_fast8_t    round;
+    uint8_t         key[KHAZAD_KEY_SIZE];
+    uint8_t       * p_key_schedule;
+    uint8_t       * p_key_schedule_m1;
+    uint8_t       * p_key_schedule_temp;
+    uint8_t         key_temp[KHAZAD_BLOCK_SIZE];
+    uint8_t       * p_block;
+    size_t          group_blocks;
+    size_t          i;
+
+    if (p_dst != p_src)
+        memcpy(p_dst, p_src, num_blocks * KHAZAD_BLOCK_SIZE);
+    while (num_blocks)
+    {
+        group_blocks = (num_blocks < KHAZAD_OTFKS_GROUP_BLOCKS) ? num_blocks : KHAZAD_OTFKS_GROUP_BLOCKS;
+        memcpy(key, p_decrypt_start_key, KHAZAD_KEY_SIZE);
+        p_key_schedule = key + KHAZAD_BLOCK_SIZE;
+        p_key_schedule_m1 = key;
+
+        for (i = 0, p_block = p_dst; i < group_blocks; ++i, p_block += KHAZAD_BLOCK_SIZE)
+        {
+            khazad_add_block(p_block, p_key_schedule_m1);
+            khazad_sbox_apply_block(p_block);
+        }
+        for (round = KHAZAD_NUM_ROUNDS; ; --round)
+        {
+            /* Do round function on all the blocks. */
+            for (i = 0, p_block = p_dst; i < group_blocks; ++i, p_block += KHAZAD_BLOCK_SIZE)
+                decrypt_round_func(p_block, p_key_schedule);
+
+            /* Get round r-1 key schedule and apply round function. */
+            memcpy(key_temp, p_key_schedule, KHAZAD_BLOCK_SIZE);
+            key_schedule_round_func(key_temp, round);
+            /* Add round r key schedule, overwriting it. This becomes round r-2 key schedule. */
+            khazad_add_block(p_key_schedule_m1, key_temp);
+
+            if (round <= 2)
+                break;
+
+            /* Swap key schedule pointers. */
+            p_key_schedule_temp = p_key_schedule_m1;
+            p_key_schedule_m1 = p_key_schedule;
+            p_key_schedule = p_key_schedule_temp;
+        }
+        for (i = 0, p_block = p_dst; i < group_blocks; ++i, p_block += KHAZAD_BLOCK_SIZE)
+            khazad_add_block(p_block, p_key_schedule_m1);
+
+        p_dst += group_blocks * KHAZAD_BLOCK_SIZE;
+        num_blocks -= group_blocks;
+    }
+}
+
 void _khazad_sbox_apply_block_for_test(uint8_t p_block[KHAZAD_BLOCK_SIZE])
 {
     khazad_sbox_apply_block(p_block);
 }
 
+#endif /* KHAZAD_WORD_CORE */
+
 /*****************************************************************************
  * Local functions
  ****************************************************************************/
 
+#ifdef KHAZAD_WORD_CORE
+
+/* Do a number of rounds of on-the-fly key schedule calculation, for round
+ * numbers 'start' through 'stop' inclusive. */
+static void khazad_otfks_calc_key(uint8_t p_key[KHAZAD_KEY_SIZE], uint_fast8_t start, uint_fast8_t stop)
+{
+    uint_fast8_t    round;
+    uint64_t        key_m2 = khazad_load_word(p_key);
+    uint64_t        key_m1 = khazad_load_word(p_key + KHAZAD_BLOCK_SIZE);
+    uint64_t        key;
+
+    for (round = start; round <= stop; ++round)
+    {
+        key = key_schedule_round_word(key_m1, key_m2, round);
+        key_m2 = key_m1;
+        key_m1 = key;
+    }
+
+    /* The byte-oriented implementation alternates the halves of the buffer
+     * that it writes, starting with the first half. Match its layout. */
+    if ((stop - start) & 1u)
+    {
+        khazad_store_word(p_key, key_m2);
+        khazad_store_word(p_key + KHAZAD_BLOCK_SIZE, key_m1);
+    }
+    else
+    {
+        khazad_store_word(p_key, key_m1);
+        khazad_store_word(p_key + KHAZAD_BLOCK_SIZE, key_m2);
+    }
+}
+
+/* Do a number of rounds of on-the-fly key schedule calculation in reverse,
+ * as for decryption, for round numbers 'start' down to 'stop' inclusive. */
+static void khazad_otfks_calc_key_reverse(uint8_t p_key[KHAZAD_KEY_SIZE], uint_fast8_t start, uint_fast8_t stop)
+{
+    uint_fast8_t    round;
+    uint64_t        key_p2 = khazad_load_word(p_key);
+    uint64_t        key_p1 = khazad_load_word(p_key + KHAZAD_BLOCK_SIZE);
+    uint64_t        key;
+
+    for (round = start; round >= stop; --round)
+    {
+        key = key_schedule_round_word(key_p1, key_p2, round);
+        key_p2 = key_p1;
+        key_p1 = key;
+    }
+
+    /* Match the layout of the byte-oriented implementation, as for
+     * khazad_otfks_calc_key(). */
+    if ((start - stop) & 1u)
+    {
+        khazad_store_word(p_key, key_p2);
+        khazad_store_word(p_key + KHAZAD_BLOCK_SIZE, key_p1);
+    }
+    else
+    {
+        khazad_store_word(p_key, key_p1);
+        khazad_store_word(p_key + KHAZAD_BLOCK_SIZE, key_p2);
+    }
+}
+
+#else /* KHAZAD_WORD_CORE */
+
 /* Do a number of rounds of on-the-fly key schedule calculation, for round
  * numbers 'start' through 'stop' inclusive. */
 static void khazad_otfks_calc_key(uint8_t p_key[KHAZAD_KEY_SIZE], uint_fast8_t start, uint_fast8_t stop)
@@ -430,6 +2028,36 @@ static void khazad_otfks_calc_key(uint8_t p_key[KHAZAD_KEY_SIZE], uint_fast8_t s
     }
 }
 
+/* Do a number of rounds of on-the-fly key schedule calculation in reverse,
+ * as for decryption, for round numbers 'start' down to 'stop' inclusive. */
+static void khazad_otfks_calc_key_reverse(uint8_t p_key[KHAZAD_KEY_SIZE], uint_fast8_t start, uint_fast8_t stop)
+{
+    uint_fast8_t    round;
+    uint8_t       * p_key_schedule = p_key + KHAZAD_BLOCK_SIZE;
+    uint8_t       * p_key_schedule_m1 = p_key;
+    uint8_t       * p_key_schedule_temp;
+    uint8_t         key_temp[KHAZAD_BLOCK_SIZE];
+
+    for (round = start; ; --round)
+    {
+        /* Get round r-1 key schedule and apply round function. */
+        memcpy(key_temp, p_key_schedule, KHAZAD_BLOCK_SIZE);
+        key_schedule_round_func(key_temp, round);
+        /* Add round r key schedule, overwriting it. This becomes round r-2 key schedule. */
+        khazad_add_block(p_key_schedule_m1, key_temp);
+
+        if (round <= stop)
+            break;
+
+        /* Swap key schedule pointers. */
+        p_key_schedule_temp = p_key_schedule_m1;
+        p_key_schedule_m1 = p_key_schedule;
+        p_key_schedule = p_key_schedule_temp;
+    }
+}
+
+#endif /* KHAZAD_WORD_CORE */
+
 #ifdef ENABLE_SBOX_SMALL
 
 #if 1
@@ -568,6 +2196,8 @@ static uint8_t khazad_sbox(uint8_t input)
 
 #endif /* ENABLE_SBOX_SMALL */
 
+#ifndef KHAZAD_WORD_CORE
+
 static void khazad_sbox_apply_block(uint8_t p_block[KHAZAD_BLOCK_SIZE])
 {
     uint_fast8_t    i;
@@ -600,142 +2230,80 @@ static void khazad_sbox_add_round_const(uint8_t p_block[KHAZAD_BLOCK_SIZE], uint
 
 #endif /* ENABLE_SBOX_SMALL */
 
-/*
- * 1  0001
- * 3  0011
- * 4  0100
- * 5  0101
- * 6  0110
- * 8  1000
- * B  1011
- * 7  0111
- *
- * # 1
- * output 0
- * save mul1
- *
- * # 4
- * shift
- * save mul2
- * shift
- * save mul4
- * output 2
- *
- * # 6
- * xor mul2
- * output 4
- *
- * # 7
- * xor mul1
- * output 7
- *
- * # 5
- * get mul4
- * xor mul1
- * output 3
- *
- * # 8
- * get mul4
- * shift
- * output 5
- * save mul8
- *
- * # 3
- * get mul2
- * xor mul1
- * output 1
- *
- * # B
- * xor mul8
- * output 6
+/* Index of the pair sum x[i] + x[i ^ 3] in the 4-entry q3 array of
+ * khazad_matrix_imul(). The pairs are { 0, 3 }, { 1, 2 }, { 4, 7 }, { 5, 6 }. */
+static inline uint_fast8_t khazad_pair3_index(uint_fast8_t i)
+{
+    return ((i >> 1u) & 2u) | ((i ^ (i >> 1u)) & 1u);
+}
+
+/* Diffusion layer, in-place. The dyadic matrix row h = (1, 3, 4, 5, 6, 8, B, 7)
+ * is split into bit planes of the coefficients,
+ *     y = z0 + 2 * (z1 + 2 * (z2 + 2 * z3))
+ * where z_b[i] is the sum of x[i ^ k] over the k where bit b of h[k] is set:
+ *     z0: k in { 0, 1, 3, 6, 7 }
+ *     z1: k in { 1, 4, 6, 7 }
+ *     z2: k in { 2, 3, 4, 7 }
+ *     z3: k in { 5, 6 }
+ * Sums over pairs of inputs are shared between outputs:
+ *     q1[i] = x[i] + x[i ^ 1]
+ *     q3[i] = x[i] + x[i ^ 3]
+ *     r[i] = x[i ^ 1] + q1[i ^ 6]
+ *     z0[i] = q3[i] + r[i]
+ *     z1[i] = x[i ^ 4] + r[i]
+ *     z2[i] = q1[i ^ 2] + q3[i ^ 4]
+ *     z3[i] = q3[i ^ 5]
+ * q1, q3 and 2 * q3 only have 4 distinct values each, so this needs 20
+ * doublings and 64 XORs, rather than 24 and 104 for a row-by-row sum.
+ * Output i only needs inputs i ^ 1 and i ^ 4 besides the pair sums, so the
+ * outputs are done in two groups of 4, { 0, 1, 4, 5 } then { 2, 3, 6, 7 },
+ * each group's inputs being read before its outputs are written.
  */
-static void khazad_matrix_mul(uint8_t p_output[KHAZAD_BLOCK_SIZE], const uint8_t p_input[KHAZAD_BLOCK_SIZE])
+static void khazad_matrix_imul(uint8_t p_block[KHAZAD_BLOCK_SIZE])
 {
+    uint8_t         q1[KHAZAD_BLOCK_SIZE / 2u];
+    uint8_t         q3[KHAZAD_BLOCK_SIZE / 2u];
+    uint8_t         q3_mul2[KHAZAD_BLOCK_SIZE / 2u];
+    uint8_t         x[4u];
+    uint8_t         r;
+    uint8_t         w;
+    uint_fast8_t    group;
+    uint_fast8_t    j;
     uint_fast8_t    i;
-    uint8_t         val1;
-    uint8_t         val2;
-    uint8_t         val4;
-    uint8_t         val8;
-
-    memset(p_output, 0, KHAZAD_BLOCK_SIZE);
 
-    for (i = 0; i < KHAZAD_BLOCK_SIZE; ++i)
+    for (j = 0; j < KHAZAD_BLOCK_SIZE / 2u; ++j)
     {
-        /* # 1
-         * save mul1
-         * output 0
-         */
-        val1 = p_input[i];
-        p_output[i] ^= val1;
-
-        /* # 4
-         * shift
-         * save mul2
-         * shift
-         * save mul4
-         * output 2
-         */
-        val2 = khazad_mul2(val1);
-        val4 = khazad_mul2(val2);
-        p_output[i ^ 2] ^= val4;
+        /* Pair { 2j, 2j + 1 } */
+        q1[j] = p_block[2u * j] ^ p_block[2u * j + 1u];
+        /* Pair { i, i ^ 3 } with i = 0, 1, 4, 5 */
+        i = (j & 1u) | ((j & 2u) << 1u);
+        q3[j] = p_block[i] ^ p_block[i ^ 3u];
+        q3_mul2[j] = khazad_mul2(q3[j]);
+    }
 
+    for (group = 0; group < 4u; group += 2u)
+    {
+        /* x[j] is input i = group ^ (j & 1) ^ ((j & 2) << 1), so that inputs
+         * i ^ 1 and i ^ 4 are x[j ^ 1] and x[j ^ 2]. */
+        for (j = 0; j < 4u; ++j)
         {
-            uint8_t val6;
-
-            /* # 6
-             * xor mul2
-             * output 4
-             */
-            val6 = val4 ^ val2;
-            p_output[i ^ 4] ^= val6;
-
-            /* # 7
-             * xor mul1
-             * output 7
-             */
-            p_output[i ^ 7] ^= val6 ^ val1;
+            x[j] = p_block[group ^ (j & 1u) ^ ((j & 2u) << 1u)];
         }
+        for (j = 0; j < 4u; ++j)
+        {
+            i = group ^ (j & 1u) ^ ((j & 2u) << 1u);
 
-        /* # 5
-         * get mul4
-         * xor mul1
-         * output 3
-         */
-        p_output[i ^ 3] ^= val4 ^ val1;
-
-        /* # 8
-         * get mul4
-         * shift
-         * save mul8
-         * output 5
-         */
-        val8 = khazad_mul2(val4);
-        p_output[i ^ 5] ^= val8;
+            /* w = z2 + 2 * z3 */
+            w = q1[(i ^ 2u) >> 1u] ^ q3[khazad_pair3_index(i ^ 4u)] ^ q3_mul2[khazad_pair3_index(i ^ 5u)];
 
-        {
-            uint8_t val3;
-
-            /* # 3
-             * get mul2
-             * xor mul1
-             * output 1
-             */
-            val3 = val2 ^ val1;
-            p_output[i ^ 1] ^= val3;
-
-            /* # B
-             * xor mul8
-             * output 6
-             */
-            p_output[i ^ 6] ^= val8 ^ val3;
+            /* w = z1 + 2 * w */
+            r = x[j ^ 1u] ^ q1[(i ^ 6u) >> 1u];
+            w = x[j ^ 2u] ^ r ^ khazad_mul2(w);
+
+            /* y = z0 + 2 * w */
+            p_block[i] = q3[khazad_pair3_index(i)] ^ r ^ khazad_mul2(w);
         }
     }
 }
 
-static void khazad_matrix_imul(uint8_t p_block[KHAZAD_BLOCK_SIZE])
-{
-    uint8_t     temp_output[KHAZAD_BLOCK_SIZE];
-
-    khazad_matrix_mul(temp_output, p_block);
-    memcpy(p_block, temp_output, KHAZAD_BLOCK_SIZE);
-}
+#endif /* KHAZAD_WORD_CORE */
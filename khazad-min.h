@@ -32,6 +32,7 @@
  * Includes
  ****************************************************************************/
 
+#include <stddef.h>
 #include <stdint.h>
 
 /*****************************************************************************
@@ -44,6 +45,44 @@
 #define KHAZAD_KEY_SIZE             16u
 #define KHAZAD_KEY_SCHEDULE_SIZE    (KHAZAD_BLOCK_SIZE * (KHAZAD_NUM_ROUNDS + 1u))
 
+#define KHAZAD_CACHE_LINE_SIZE      64u
+
+/* Flag in khazad_otfks_session_t: the key state is the decryption start key
+ * state, rather than the encryption start key state. */
+#define KHAZAD_OTFKS_SESSION_DECRYPT_START  0x01u
+
+/*****************************************************************************
+ * Types
+ ****************************************************************************/
+
+/* A block with its own key schedule, for khazad_crypt_keyed_blocks() and
+ * khazad_decrypt_keyed_blocks(). */
+typedef struct
+{
+    uint8_t       * p_block;
+    const uint8_t * p_key_schedule;
+} khazad_keyed_block_t;
+
+/* A block and the id of its key, for khazad_crypt_jobs() and related
+ * functions. The key id indexes the caller's array of keys or key
+ * schedules. */
+typedef struct
+{
+    uint32_t    key_id;
+    uint8_t     block[KHAZAD_BLOCK_SIZE];
+} khazad_job_t;
+
+/* On-the-fly key schedule session, small enough to keep on the stack. The
+ * members are stable: key_state is the start key state for
+ * khazad_otfks_encrypt(), or for khazad_otfks_decrypt() if flags includes
+ * KHAZAD_OTFKS_SESSION_DECRYPT_START.
+ */
+typedef struct
+{
+    uint8_t     key_state[KHAZAD_KEY_SIZE];
+    unsigned    flags;
+} khazad_otfks_session_t;
+
 /*****************************************************************************
  * Inline functions
  ****************************************************************************/
@@ -80,6 +119,23 @@ void khazad_crypt(uint8_t p_block[KHAZAD_BLOCK_SIZE], const uint8_t p_key_schedu
  */
 void khazad_decrypt(uint8_t p_block[KHAZAD_BLOCK_SIZE], const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE]);
 
+/* Khazad encryption of one block, iterated num_iterations times: the block is
+ * encrypted, then the result encrypted again, and so on.
+ * p_block points to an 8-byte block, encrypted in-place.
+ * p_key_schedule is as for khazad_crypt(). The round keys are loaded once, and
+ * the block and round keys are kept in local variables across iterations,
+ * rather than loaded and stored again by each call of khazad_crypt(). This
+ * suits key stretching, and the iterated test vectors.
+ */
+void khazad_crypt_iterate(uint8_t p_block[KHAZAD_BLOCK_SIZE], const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE], size_t num_iterations);
+
+/* Khazad decryption of one block, iterated num_iterations times, reversing
+ * khazad_crypt_iterate().
+ * p_key_schedule is as for khazad_decrypt(), calculated with
+ * khazad_key_schedule(). Otherwise as for khazad_crypt_iterate().
+ */
+void khazad_decrypt_iterate(uint8_t p_block[KHAZAD_BLOCK_SIZE], const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE], size_t num_iterations);
+
 /* Calculate full key schedule for Khazad encryption (or decryption).
  * p_key_schedule points to a 72-byte buffer of data to store the key schedule.
  * If the key schedule is used with khazad_crypt(), then encryption is done.
@@ -87,6 +143,28 @@ void khazad_decrypt(uint8_t p_block[KHAZAD_BLOCK_SIZE], const uint8_t p_key_sche
  */
 void khazad_key_schedule(uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE], const uint8_t p_key[KHAZAD_KEY_SIZE]);
 
+/* Calculate the full key schedule for Khazad encryption from the encryption
+ * start key state for on-the-fly key schedule calculation, as from
+ * khazad_otfks_encrypt_start_key(), instead of from the Khazad key.
+ * p_key_schedule points to a 72-byte buffer of data to store the key schedule,
+ * which is the same as from khazad_key_schedule() for the original key. The
+ * start key state is the first 16 bytes of it, so only the remaining rounds
+ * are calculated.
+ */
+void khazad_key_schedule_from_otfks_start_key(uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE], const uint8_t p_encrypt_start_key[KHAZAD_KEY_SIZE]);
+
+/* Khazad encryption of one block, calculating the full key schedule at the
+ * same time.
+ * p_block points to an 8-byte block of plain data, encrypted in-place.
+ * p_key is the 16-byte Khazad key. Its key schedule, as from
+ * khazad_key_schedule(), is written to p_key_schedule as each round key is
+ * calculated, ready for the blocks that follow. For the first block with a
+ * new key, this is quicker than khazad_key_schedule() then khazad_crypt(),
+ * since the round keys are used as they are calculated, and the key schedule
+ * and block rounds can overlap.
+ */
+void khazad_crypt_and_expand(uint8_t p_block[KHAZAD_BLOCK_SIZE], uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE], const uint8_t p_key[KHAZAD_KEY_SIZE]);
+
 /* Calculate full key schedule for Khazad decryption using the common crypt
  * function khazad_crypt().
  * p_key_schedule points to a 72-byte buffer of data to store the key schedule.
@@ -94,6 +172,108 @@ void khazad_key_schedule(uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE], const
  */
 void khazad_decrypt_key_schedule(uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE], const uint8_t p_key[KHAZAD_KEY_SIZE]);
 
+/* Calculate the key schedule for Khazad decryption using the common crypt
+ * function khazad_crypt(), from an already calculated encryption key schedule,
+ * without repeating the key schedule rounds.
+ * p_encrypt_key_schedule points to a key schedule calculated with
+ * khazad_key_schedule(), and the decryption key schedule is stored in
+ * p_key_schedule. The two may be the same buffer, but must not otherwise
+ * overlap.
+ * The conversion is its own inverse, so it also converts a decryption key
+ * schedule back to an encryption key schedule.
+ */
+void khazad_decrypt_key_schedule_from_encrypt(uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE], const uint8_t p_encrypt_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE]);
+
+/* Convert an encryption key schedule, calculated with khazad_key_schedule(),
+ * to a decryption key schedule for khazad_crypt(), in-place.
+ * This is the same as khazad_decrypt_key_schedule_from_encrypt() with the
+ * same buffer for both.
+ */
+void khazad_decrypt_key_schedule_in_place(uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE]);
+
+/* Calculate the full key schedules for Khazad encryption (or decryption) of
+ * several keys.
+ * p_keys points to num_keys 16-byte keys, stored contiguously, and
+ * p_key_schedules to a buffer for num_keys 72-byte key schedules, in the same
+ * format as from khazad_key_schedule().
+ * The word cores process up to 4 keys together, so their rounds overlap,
+ * which is faster than separate calls of khazad_key_schedule() when there are
+ * many keys to set up; the byte core calculates one key schedule at a time.
+ * With the x86 SIMD kernels, the kernel selected at run time is used instead,
+ * with several keys per register.
+ */
+void khazad_key_schedule_multi(uint8_t * p_key_schedules, const uint8_t * p_keys, size_t num_keys);
+
+/* Khazad encryption and decryption of multiple blocks, each with its own key
+ * schedule.
+ * p_blocks points to an array of num_blocks entries, each giving a block to
+ * encrypt/decrypt in-place and the key schedule to use for it, as for
+ * khazad_crypt(). The blocks must not overlap, but may share key schedules.
+ * The word cores process up to 4 blocks with different keys together, so
+ * their rounds overlap, which is faster than separate calls of khazad_crypt()
+ * when there are many blocks with few per key; the byte core processes one
+ * block at a time. With the x86 SIMD kernels, the kernel selected at run time
+ * is used instead, with several blocks per register.
+ */
+void khazad_crypt_keyed_blocks(const khazad_keyed_block_t * p_blocks, size_t num_blocks);
+
+/* Khazad decryption of multiple blocks, each with its own key schedule.
+ * p_blocks is as for khazad_crypt_keyed_blocks(), but with key schedules as
+ * for khazad_decrypt(), calculated with khazad_key_schedule().
+ */
+void khazad_decrypt_keyed_blocks(const khazad_keyed_block_t * p_blocks, size_t num_blocks);
+
+/* Khazad encryption (or decryption, with decryption key schedules) of many
+ * blocks with mixed keys.
+ * p_jobs points to num_jobs jobs. Each job's block is encrypted in-place,
+ * with the key schedule p_key_schedules + key_id * KHAZAD_KEY_SCHEDULE_SIZE.
+ * The jobs are grouped by key, a chunk at a time, and each group is processed
+ * by khazad_crypt_blocks(), so this suits many blocks per key in no
+ * particular order. Each key schedule is prefetched and loaded once per
+ * group.
+ */
+void khazad_crypt_jobs(khazad_job_t * p_jobs, size_t num_jobs, const uint8_t * p_key_schedules);
+
+/* Khazad decryption of many blocks with mixed keys.
+ * As for khazad_crypt_jobs(), but with key schedules as for khazad_decrypt(),
+ * calculated with khazad_key_schedule().
+ */
+void khazad_decrypt_jobs(khazad_job_t * p_jobs, size_t num_jobs, const uint8_t * p_key_schedules);
+
+/* Khazad encryption of many blocks with mixed keys, given the keys rather
+ * than their key schedules.
+ * p_jobs points to num_jobs jobs. Each job's block is encrypted in-place,
+ * with the 16-byte key at p_keys + key_id * KHAZAD_KEY_SIZE. Each key's
+ * schedule is calculated once per group, with khazad_key_schedule_multi().
+ */
+void khazad_crypt_jobs_with_keys(khazad_job_t * p_jobs, size_t num_jobs, const uint8_t * p_keys);
+
+/* Khazad decryption of many blocks with mixed keys, given the keys rather
+ * than their key schedules. Otherwise as for khazad_crypt_jobs_with_keys().
+ */
+void khazad_decrypt_jobs_with_keys(khazad_job_t * p_jobs, size_t num_jobs, const uint8_t * p_keys);
+
+/* Khazad encryption and decryption of multiple blocks.
+ * p_src points to num_blocks 8-byte blocks, stored contiguously, and the
+ * result is written to p_dst. p_dst may equal p_src, but the buffers must not
+ * otherwise overlap.
+ * p_key_schedule is as for khazad_crypt().
+ * The word cores (T-table and SWAR) process up to 4 independent blocks
+ * together, so their rounds overlap; the byte core processes one block at a
+ * time. With the x86 SIMD kernels, the kernel selected at run time (see
+ * khazad_kernel_name()) is used instead, with several blocks per register.
+ */
+void khazad_crypt_blocks(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE]);
+
+/* Khazad decryption of multiple blocks.
+ * p_src points to num_blocks 8-byte blocks of encrypted data, stored
+ * contiguously, and the result is written to p_dst. p_dst may equal p_src, but
+ * the buffers must not otherwise overlap.
+ * p_key_schedule is as for khazad_decrypt(), calculated with
+ * khazad_key_schedule().
+ */
+void khazad_decrypt_blocks(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE]);
+
 
 /* Khazad encryption with on-the-fly key schedule calculation.
  *
@@ -119,6 +299,49 @@ void khazad_otfks_encrypt(uint8_t p_block[KHAZAD_BLOCK_SIZE], uint8_t p_encrypt_
  */
 void khazad_otfks_decrypt(uint8_t p_block[KHAZAD_BLOCK_SIZE], uint8_t p_decrypt_start_key[KHAZAD_KEY_SIZE]);
 
+/* Khazad encryption with on-the-fly key schedule calculation, as for
+ * khazad_otfks_encrypt(), but leaving the start key state unchanged.
+ *
+ * The key schedule is calculated in local variables rather than in the
+ * p_encrypt_start_key buffer, so it needn't be restored before the next
+ * block, and one start key state can be used by several threads at once.
+ */
+void khazad_otfks_encrypt_const(uint8_t p_block[KHAZAD_BLOCK_SIZE], const uint8_t p_encrypt_start_key[KHAZAD_KEY_SIZE]);
+
+/* Khazad decryption with on-the-fly key schedule calculation, as for
+ * khazad_otfks_decrypt(), but leaving the start key state unchanged.
+ *
+ * The key schedule is calculated in local variables rather than in the
+ * p_decrypt_start_key buffer, so it needn't be restored before the next
+ * block, and one start key state can be used by several threads at once.
+ */
+void khazad_otfks_decrypt_const(uint8_t p_block[KHAZAD_BLOCK_SIZE], const uint8_t p_decrypt_start_key[KHAZAD_KEY_SIZE]);
+
+/* Khazad encryption of multiple blocks with on-the-fly key schedule
+ * calculation.
+ * p_src points to num_blocks 8-byte blocks of plain data, stored contiguously,
+ * and the result is written to p_dst. p_dst may equal p_src, but the buffers
+ * must not otherwise overlap.
+ * p_encrypt_start_key is as for khazad_otfks_encrypt_const(), and is left
+ * unchanged.
+ * Each round key is calculated once, and applied to a group of up to 64
+ * blocks before the next, so the blocks share the key schedule calculation,
+ * which still only needs the 16-byte key state.
+ */
+void khazad_otfks_encrypt_blocks(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const uint8_t p_encrypt_start_key[KHAZAD_KEY_SIZE]);
+
+/* Khazad decryption of multiple blocks with on-the-fly key schedule
+ * calculation.
+ * p_src points to num_blocks 8-byte blocks of encrypted data, stored
+ * contiguously, and the result is written to p_dst. p_dst may equal p_src, but
+ * the buffers must not otherwise overlap.
+ * p_decrypt_start_key is as for khazad_otfks_decrypt_const(), and is left
+ * unchanged.
+ * As for khazad_otfks_encrypt_blocks(), each round key is calculated once per
+ * group of up to 64 blocks.
+ */
+void khazad_otfks_decrypt_blocks(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const uint8_t p_decrypt_start_key[KHAZAD_KEY_SIZE]);
+
 /* Calculate the starting key state needed for encryption with on-the-fly key
  * schedule calculation. The starting encryption key state is the first 16
  * bytes of the Khazad key schedule, which is not the Khazad key itself but two
@@ -144,5 +367,65 @@ void khazad_otfks_decrypt_start_key(uint8_t p_key[KHAZAD_KEY_SIZE]);
  */
 void khazad_otfks_decrypt_from_encrypt_start_key(uint8_t p_key[KHAZAD_KEY_SIZE]);
 
+/* This calculates the encryption start key from the decryption start key,
+ * the reverse of khazad_otfks_decrypt_from_encrypt_start_key().
+ */
+void khazad_otfks_encrypt_from_decrypt_start_key(uint8_t p_key[KHAZAD_KEY_SIZE]);
+
+/* Initialise an on-the-fly key schedule session for the Khazad key p_key.
+ */
+void khazad_otfks_session_init(khazad_otfks_session_t * p_session, const uint8_t p_key[KHAZAD_KEY_SIZE]);
+
+/* Clear an on-the-fly key schedule session, so no key material is left in
+ * memory. It must be initialised again before further use.
+ */
+void khazad_otfks_session_wipe(khazad_otfks_session_t * p_session);
+
+/* Khazad encryption of the block p_block, in-place, with an on-the-fly key
+ * schedule session.
+ * The key state is left at the decryption end of the key schedule, so a
+ * following khazad_otfks_session_decrypt() starts straight away. After a
+ * decryption, it starts straight away too; only after another encryption
+ * must the key state first be taken back through the key schedule.
+ */
+void khazad_otfks_session_encrypt(khazad_otfks_session_t * p_session, uint8_t p_block[KHAZAD_BLOCK_SIZE]);
+
+/* Khazad decryption of the block p_block, in-place, with an on-the-fly key
+ * schedule session. As for khazad_otfks_session_encrypt(), in the other
+ * direction.
+ */
+void khazad_otfks_session_decrypt(khazad_otfks_session_t * p_session, uint8_t p_block[KHAZAD_BLOCK_SIZE]);
+
+/* Get the name of the kernel used by khazad_crypt_blocks(),
+ * khazad_decrypt_blocks(), the keyed block functions and
+ * khazad_key_schedule_multi(): "scalar", "ssse3", "avx2", "avx2-gather" or
+ * "avx512".
+ * On x86, the kernel is chosen at load time, according to the CPU's
+ * features. The KHAZAD_KERNEL environment variable can be set to one of these
+ * names to override it, if the CPU supports that kernel.
+ */
+const char * khazad_kernel_name(void);
+
+/* Bitsliced Khazad encryption (or decryption) of multiple blocks.
+ *
+ * p_blocks points to num_blocks 8-byte blocks, stored contiguously. They are
+ * encrypted/decrypted in-place.
+ * p_key_schedule is as for khazad_crypt().
+ * Blocks are processed in groups of 64 (or 128, 256 or 512 if the library is
+ * built with KHAZAD_BITSLICE_LANES set to 2, 4 or 8), so it is most efficient
+ * when num_blocks is a multiple of that. There are no table look-ups, so the
+ * timing doesn't depend on the key or data.
+ */
+void khazad_bitslice_crypt(uint8_t * p_blocks, size_t num_blocks, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE]);
+
+/* Bitsliced Khazad decryption of multiple blocks.
+ *
+ * p_blocks points to num_blocks 8-byte blocks, stored contiguously. They are
+ * decrypted in-place.
+ * p_key_schedule is as for khazad_decrypt(), calculated with
+ * khazad_key_schedule().
+ */
+void khazad_bitslice_decrypt(uint8_t * p_blocks, size_t num_blocks, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE]);
+
 
 #endif /* !defined(KHAZAD_H) */
@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+"""
+Generate the 64-bit T-tables for the Khazad table-driven round function.
+
+Table j, entry x, holds column j of the Khazad diffusion matrix H multiplied
+by S[x]. Output byte i of the block is stored in bits 8*i to 8*i+7 of the
+64-bit word. Since H is dyadic, H[i][j] = h[i ^ j], table j is a byte
+permutation of table 0.
+
+Usage:
+    python3 gen-t-table.py > khazad-min-t-table.h
+"""
+
+SBOX_SMALL_TABLE = (
+    0x39, 0xFE, 0xE5, 0x06, 0x5A, 0x42, 0xB3, 0xCC, 0xDF, 0xA0, 0x94, 0x6D, 0x77, 0x8B, 0x21, 0x18
+)
+
+# First row of the diffusion matrix H.
+H_ROW = (0x1, 0x3, 0x4, 0x5, 0x6, 0x8, 0xB, 0x7)
+
+BLOCK_SIZE = 8
+NUM_ROUNDS = 8
+REDUCE_POLY = 0x11D
+
+
+def p_box(nibble):
+    return SBOX_SMALL_TABLE[nibble] >> 4
+
+
+def q_box(nibble):
+    return SBOX_SMALL_TABLE[nibble] & 0xF
+
+
+def mix(hi, lo):
+    return (hi & 0xC) | (lo >> 2), ((hi << 2) & 0xC) | (lo & 3)
+
+
+def sbox(x):
+    hi, lo = x >> 4, x & 0xF
+    hi, lo = p_box(hi), q_box(lo)
+    hi, lo = mix(hi, lo)
+    hi, lo = q_box(hi), p_box(lo)
+    hi, lo = mix(hi, lo)
+    hi, lo = p_box(hi), q_box(lo)
+    return (hi << 4) | lo
+
+
+def gf_mul(a, b):
+    result = 0
+    while b:
+        if b & 1:
+            result ^= a
+        a <<= 1
+        if a & 0x100:
+            a ^= REDUCE_POLY
+        b >>= 1
+    return result
+
+
+def t_entry(table, x):
+    s = sbox(x)
+    word = 0
+    for i in range(BLOCK_SIZE):
+        word |= gf_mul(H_ROW[i ^ table], s) << (8 * i)
+    return word
+
+
+def bytes_to_word(data):
+    word = 0
+    for i, b in enumerate(data):
+        word |= b << (8 * i)
+    return word
+
+
+def print_words(words, indent):
+    for i in range(0, len(words), 4):
+        print(indent + ", ".join("0x{:016X}u".format(w) for w in words[i:i + 4]) + ",")
+
+
+def main():
+    print("/* Generated by Python gen-t-table.py */")
+    print()
+    print("#ifndef KHAZAD_T_TABLE_LINKAGE")
+    print("#define KHAZAD_T_TABLE_LINKAGE  static")
+    print("#endif")
+    print()
+    print("KHAZAD_T_TABLE_LINKAGE const uint64_t khazad_t_table[KHAZAD_T_TABLE_COUNT][256u] =")
+    print("{")
+    for table in range(BLOCK_SIZE):
+        if table == 1:
+            print("#if KHAZAD_T_TABLE_COUNT > 1u")
+        print("    {")
+        print_words([t_entry(table, x) for x in range(256)], "        ")
+        print("    },")
+    print("#endif")
+    print("};")
+    print()
+    print("static const uint64_t khazad_round_const[KHAZAD_NUM_ROUNDS + 1u] =")
+    print("{")
+    print_words([bytes_to_word([sbox(r * BLOCK_SIZE + i) for i in range(BLOCK_SIZE)])
+                 for r in range(NUM_ROUNDS + 1)], "    ")
+    print("};")
+
+
+if __name__ == "__main__":
+    main()
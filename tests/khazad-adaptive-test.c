@@ -0,0 +1,154 @@
+/*****************************************************************************
+ * khazad-adaptive-test.c
+ *
+ * Test adaptive key contexts against the functions that take a key schedule,
+ * before and after they switch to the full key schedule.
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Includes
+ ****************************************************************************/
+
+#include "khazad-min.h"
+#include "khazad-min-adaptive.h"
+#include "khazad-test-fixtures.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/*****************************************************************************
+ * Defines
+ ****************************************************************************/
+
+#define NUM_TEST_KEYS       20u
+#define MAX_TEST_BLOCKS     40u
+#define TEST_THRESHOLD      10u
+
+/*****************************************************************************
+ * Functions
+ ****************************************************************************/
+
+/* Encrypt and decrypt num_blocks blocks with an adaptive key context, and
+ * check them against the key schedule. */
+static int test_blocks(khazad_adaptive_t * p_adaptive, const uint8_t * p_key_schedule, size_t num_blocks, size_t seed)
+{
+    uint8_t     plain_blocks[MAX_TEST_BLOCKS * KHAZAD_BLOCK_SIZE];
+    uint8_t     expected_blocks[MAX_TEST_BLOCKS * KHAZAD_BLOCK_SIZE];
+    uint8_t     crypt_blocks[MAX_TEST_BLOCKS * KHAZAD_BLOCK_SIZE];
+    size_t      size = num_blocks * KHAZAD_BLOCK_SIZE;
+
+    fill_test_blocks(plain_blocks, num_blocks, (uint8_t)seed);
+    khazad_crypt_blocks(expected_blocks, plain_blocks, num_blocks, p_key_schedule);
+
+    khazad_adaptive_crypt_blocks(p_adaptive, crypt_blocks, plain_blocks, num_blocks);
+    if (memcmp(crypt_blocks, expected_blocks, size) != 0)
+    {
+        printf("adaptive encrypt error, %zu blocks\n", num_blocks);
+        return 1;
+    }
+    khazad_adaptive_decrypt_blocks(p_adaptive, crypt_blocks, crypt_blocks, num_blocks);
+    if (memcmp(crypt_blocks, plain_blocks, size) != 0)
+    {
+        printf("adaptive decrypt error, %zu blocks\n", num_blocks);
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    khazad_adaptive_t * p_adaptive;
+    uint8_t             key[KHAZAD_KEY_SIZE];
+    uint8_t             key_schedule[KHAZAD_KEY_SCHEDULE_SIZE];
+    uint32_t            threshold;
+    size_t              processed;
+    size_t              num_blocks;
+    size_t              i;
+    size_t              j;
+
+    (void)argc;
+    (void)argv;
+
+    threshold = khazad_adaptive_threshold();
+    printf("adaptive: calibrated threshold %u blocks\n", (unsigned)threshold);
+    if (threshold < 1u || threshold > 4096u)
+    {
+        printf("adaptive threshold error\n");
+        return 1;
+    }
+
+    /* Each key processes a different run of call sizes, and switches to the
+     * full key schedule in the call that takes it to the threshold. Each call
+     * encrypts then decrypts, so counts 2 * num_blocks. */
+    khazad_adaptive_set_threshold(TEST_THRESHOLD);
+    for (i = 0; i < NUM_TEST_KEYS; ++i)
+    {
+        for (j = 0; j < KHAZAD_KEY_SIZE; ++j)
+        {
+            key[j] = (uint8_t)(j * 0x3Bu + i * 0x11u);
+        }
+        khazad_key_schedule(key_schedule, key);
+        p_adaptive = khazad_adaptive_create(key);
+        if (p_adaptive == NULL)
+        {
+            printf("adaptive create error\n");
+            return 1;
+        }
+        processed = 0;
+        for (j = 0; j < 6u; ++j)
+        {
+            num_blocks = (i + j * 3u) % 5u;
+            if (test_blocks(p_adaptive, key_schedule, num_blocks, i + j))
+                return 1;
+            processed += 2u * num_blocks;
+            if (!khazad_adaptive_is_expanded(p_adaptive) != (processed < TEST_THRESHOLD))
+            {
+                printf("adaptive switch error, key %zu, %zu blocks\n", i, processed);
+                return 1;
+            }
+        }
+        khazad_adaptive_destroy(p_adaptive);
+    }
+
+    /* A threshold of 1 switches on the first block; a large one on none. */
+    khazad_adaptive_set_threshold(1u);
+    p_adaptive = khazad_adaptive_create(key);
+    if (p_adaptive == NULL)
+    {
+        printf("adaptive create error\n");
+        return 1;
+    }
+    if (khazad_adaptive_is_expanded(p_adaptive) || test_blocks(p_adaptive, key_schedule, 1u, 0)
+        || !khazad_adaptive_is_expanded(p_adaptive))
+    {
+        printf("adaptive threshold 1 error\n");
+        return 1;
+    }
+    khazad_adaptive_set_threshold(4096u);
+    khazad_adaptive_rekey(p_adaptive, key);
+    if (test_blocks(p_adaptive, key_schedule, MAX_TEST_BLOCKS, 0) || khazad_adaptive_is_expanded(p_adaptive))
+    {
+        printf("adaptive threshold 4096 error\n");
+        return 1;
+    }
+
+    /* The threshold for a context is fixed when it is created or rekeyed. */
+    khazad_adaptive_set_threshold(1u);
+    if (test_blocks(p_adaptive, key_schedule, 1u, 0) || khazad_adaptive_is_expanded(p_adaptive))
+    {
+        printf("adaptive threshold change error\n");
+        return 1;
+    }
+    khazad_adaptive_destroy(p_adaptive);
+
+    /* Calibrate again. */
+    khazad_adaptive_set_threshold(0);
+    threshold = khazad_adaptive_threshold();
+    if (threshold < 1u || threshold > 4096u)
+    {
+        printf("adaptive recalibrated threshold error\n");
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,342 @@
+/*****************************************************************************
+ * khazad-bench.c
+ *
+ * Microbenchmark of Khazad key setup and block encryption/decryption.
+ *
+ * Key setup and block operations are timed separately, so key-agile
+ * workloads (a different key for almost every block) can be judged as well as
+ * bulk workloads. On x86 the time is reported in TSC cycles, otherwise in
+ * nanoseconds. Each figure is the best of several runs.
+ *
+ * This is built by "make check", but not run as a test.
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Includes
+ ****************************************************************************/
+
+#include "khazad-min.h"
+#include "khazad-min-adaptive.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_CYCLES            1
+#endif
+
+/*****************************************************************************
+ * Defines
+ ****************************************************************************/
+
+#define BENCH_RUNS              20u
+#define BENCH_ITERATIONS        1000u
+#define BENCH_BATCH_ITERATIONS  10u
+#define BENCH_BLOCKS            1024u
+#define BENCH_KEYS              256u
+#define BENCH_ADAPTIVE_BLOCKS   16u
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+
+static uint8_t key[KHAZAD_KEY_SIZE];
+static uint8_t key_schedule[KHAZAD_KEY_SCHEDULE_SIZE];
+static uint8_t start_key[KHAZAD_KEY_SIZE];
+static uint8_t decrypt_start_key[KHAZAD_KEY_SIZE];
+static khazad_otfks_session_t otfks_session;
+static uint8_t blocks[BENCH_BLOCKS * KHAZAD_BLOCK_SIZE];
+static uint8_t keys[BENCH_KEYS * KHAZAD_KEY_SIZE];
+static uint8_t key_schedules[BENCH_KEYS * KHAZAD_KEY_SCHEDULE_SIZE];
+static khazad_keyed_block_t keyed_blocks[BENCH_KEYS];
+static khazad_job_t jobs[BENCH_BLOCKS];
+static khazad_adaptive_t * p_adaptive;
+
+/*****************************************************************************
+ * Local functions
+ ****************************************************************************/
+
+static uint64_t bench_now(void)
+{
+#ifdef BENCH_CYCLES
+    return __rdtsc();
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+/* Run p_func the given number of times per run, and return the best time per
+ * call, divided by divisor. */
+static double bench_run(void (*p_func)(void), unsigned iterations, unsigned divisor)
+{
+    uint64_t    start;
+    uint64_t    elapsed;
+    uint64_t    best = UINT64_MAX;
+    unsigned    run;
+    unsigned    i;
+
+    for (run = 0; run < BENCH_RUNS; ++run)
+    {
+        start = bench_now();
+        for (i = 0; i < iterations; ++i)
+        {
+            p_func();
+        }
+        elapsed = bench_now() - start;
+        if (elapsed < best)
+            best = elapsed;
+    }
+    return (double)best / ((double)iterations * divisor);
+}
+
+static void bench_key_schedule(void)
+{
+    khazad_key_schedule(key_schedule, key);
+    /* Feed the result back, so the calls can't be overlapped or removed. */
+    key[0] ^= key_schedule[KHAZAD_KEY_SCHEDULE_SIZE - 1u];
+}
+
+static void bench_decrypt_key_schedule(void)
+{
+    khazad_decrypt_key_schedule(key_schedule, key);
+    key[0] ^= key_schedule[KHAZAD_KEY_SCHEDULE_SIZE - 1u];
+}
+
+static void bench_key_schedule_multi(void)
+{
+    khazad_key_schedule_multi(key_schedules, keys, BENCH_KEYS);
+}
+
+static void bench_decrypt_key_schedule_from_encrypt(void)
+{
+    khazad_decrypt_key_schedule_from_encrypt(key_schedule, key_schedule);
+}
+
+static void bench_otfks_encrypt_start_key(void)
+{
+    memcpy(start_key, key, KHAZAD_KEY_SIZE);
+    khazad_otfks_encrypt_start_key(start_key);
+    key[0] ^= start_key[KHAZAD_KEY_SIZE - 1u];
+}
+
+static void bench_key_schedule_from_otfks_start_key(void)
+{
+    khazad_key_schedule_from_otfks_start_key(key_schedule, start_key);
+    start_key[0] ^= key_schedule[KHAZAD_KEY_SCHEDULE_SIZE - 1u];
+}
+
+static void bench_crypt(void)
+{
+    khazad_crypt(blocks, key_schedule);
+}
+
+static void bench_decrypt(void)
+{
+    khazad_decrypt(blocks, key_schedule);
+}
+
+static void bench_crypt_iterate(void)
+{
+    khazad_crypt_iterate(blocks, key_schedule, BENCH_BLOCKS);
+}
+
+static void bench_decrypt_iterate(void)
+{
+    khazad_decrypt_iterate(blocks, key_schedule, BENCH_BLOCKS);
+}
+
+static void bench_otfks_encrypt(void)
+{
+    uint8_t     key_work[KHAZAD_KEY_SIZE];
+
+    memcpy(key_work, start_key, KHAZAD_KEY_SIZE);
+    khazad_otfks_encrypt(blocks, key_work);
+}
+
+static void bench_otfks_encrypt_const(void)
+{
+    khazad_otfks_encrypt_const(blocks, start_key);
+}
+
+static void bench_otfks_encrypt_decrypt_const(void)
+{
+    khazad_otfks_encrypt_const(blocks, start_key);
+    khazad_otfks_decrypt_const(blocks, decrypt_start_key);
+}
+
+static void bench_otfks_session(void)
+{
+    khazad_otfks_session_encrypt(&otfks_session, blocks);
+    khazad_otfks_session_decrypt(&otfks_session, blocks);
+}
+
+static void bench_otfks_encrypt_blocks(void)
+{
+    khazad_otfks_encrypt_blocks(blocks, blocks, BENCH_BLOCKS, start_key);
+}
+
+static void bench_otfks_decrypt_blocks(void)
+{
+    khazad_otfks_decrypt_blocks(blocks, blocks, BENCH_BLOCKS, start_key);
+}
+
+static void bench_crypt_blocks(void)
+{
+    khazad_crypt_blocks(blocks, blocks, BENCH_BLOCKS, key_schedule);
+}
+
+static void bench_decrypt_blocks(void)
+{
+    khazad_decrypt_blocks(blocks, blocks, BENCH_BLOCKS, key_schedule);
+}
+
+static void bench_decrypt_each_key(void)
+{
+    size_t  i;
+
+    for (i = 0; i < BENCH_KEYS; ++i)
+    {
+        khazad_decrypt(keyed_blocks[i].p_block, keyed_blocks[i].p_key_schedule);
+    }
+}
+
+static void bench_decrypt_keyed_blocks(void)
+{
+    khazad_decrypt_keyed_blocks(keyed_blocks, BENCH_KEYS);
+}
+
+static void bench_crypt_each_job(void)
+{
+    size_t  i;
+
+    for (i = 0; i < BENCH_BLOCKS; ++i)
+    {
+        khazad_crypt(jobs[i].block, &key_schedules[jobs[i].key_id * KHAZAD_KEY_SCHEDULE_SIZE]);
+    }
+}
+
+static void bench_crypt_jobs(void)
+{
+    khazad_crypt_jobs(jobs, BENCH_BLOCKS, key_schedules);
+}
+
+static void bench_key_and_crypt(void)
+{
+    khazad_key_schedule(key_schedule, key);
+    khazad_crypt(blocks, key_schedule);
+    key[0] ^= blocks[0];
+}
+
+static void bench_crypt_and_expand(void)
+{
+    khazad_crypt_and_expand(blocks, key_schedule, key);
+    key[0] ^= blocks[0];
+}
+
+static void bench_adaptive_one_block(void)
+{
+    khazad_adaptive_rekey(p_adaptive, key);
+    khazad_adaptive_crypt_blocks(p_adaptive, blocks, blocks, 1u);
+    key[0] ^= blocks[0];
+}
+
+static void bench_adaptive_blocks(void)
+{
+    khazad_adaptive_rekey(p_adaptive, key);
+    khazad_adaptive_crypt_blocks(p_adaptive, blocks, blocks, BENCH_ADAPTIVE_BLOCKS);
+    key[0] ^= blocks[0];
+}
+
+static void bench_key_and_crypt_blocks(void)
+{
+    khazad_key_schedule(key_schedule, key);
+    khazad_crypt_blocks(blocks, blocks, BENCH_ADAPTIVE_BLOCKS, key_schedule);
+    key[0] ^= blocks[0];
+}
+
+/*****************************************************************************
+ * Functions
+ ****************************************************************************/
+
+int main(int argc, char **argv)
+{
+    size_t          i;
+#ifdef BENCH_CYCLES
+    const char    * p_unit = "cycles";
+#else
+    const char    * p_unit = "ns";
+#endif
+
+    (void)argc;
+    (void)argv;
+
+    memset(key, 0x5Au, sizeof(key));
+    memset(blocks, 0xA5u, sizeof(blocks));
+    for (i = 0; i < sizeof(keys); ++i)
+    {
+        keys[i] = (uint8_t)(i * 0x3Bu ^ (i >> 4u));
+    }
+    khazad_key_schedule(key_schedule, key);
+
+    printf("kernel: %s\n", khazad_kernel_name());
+    printf("key setup (%s per key):\n", p_unit);
+    printf("  khazad_key_schedule                     %8.1f\n", bench_run(bench_key_schedule, BENCH_ITERATIONS, 1u));
+    printf("  khazad_key_schedule_multi               %8.1f\n", bench_run(bench_key_schedule_multi, BENCH_BATCH_ITERATIONS, BENCH_KEYS));
+    printf("  khazad_decrypt_key_schedule             %8.1f\n", bench_run(bench_decrypt_key_schedule, BENCH_ITERATIONS, 1u));
+    printf("  khazad_decrypt_key_schedule_from_encrypt%8.1f\n", bench_run(bench_decrypt_key_schedule_from_encrypt, BENCH_ITERATIONS, 1u));
+    printf("  khazad_otfks_encrypt_start_key          %8.1f\n", bench_run(bench_otfks_encrypt_start_key, BENCH_ITERATIONS, 1u));
+    printf("  khazad_key_schedule_from_otfks_start_key%8.1f\n", bench_run(bench_key_schedule_from_otfks_start_key, BENCH_ITERATIONS, 1u));
+    khazad_key_schedule(key_schedule, key);
+    printf("blocks (%s per block):\n", p_unit);
+    printf("  khazad_crypt                            %8.1f\n", bench_run(bench_crypt, BENCH_ITERATIONS, 1u));
+    printf("  khazad_decrypt                          %8.1f\n", bench_run(bench_decrypt, BENCH_ITERATIONS, 1u));
+    printf("  khazad_crypt_iterate                    %8.1f\n", bench_run(bench_crypt_iterate, BENCH_BATCH_ITERATIONS, BENCH_BLOCKS));
+    printf("  khazad_decrypt_iterate                  %8.1f\n", bench_run(bench_decrypt_iterate, BENCH_BATCH_ITERATIONS, BENCH_BLOCKS));
+    printf("  khazad_otfks_encrypt, with key copy     %8.1f\n", bench_run(bench_otfks_encrypt, BENCH_ITERATIONS, 1u));
+    printf("  khazad_otfks_encrypt_const              %8.1f\n", bench_run(bench_otfks_encrypt_const, BENCH_ITERATIONS, 1u));
+    memcpy(decrypt_start_key, start_key, KHAZAD_KEY_SIZE);
+    khazad_otfks_decrypt_from_encrypt_start_key(decrypt_start_key);
+    khazad_otfks_session_init(&otfks_session, key);
+    printf("  otfks encrypt + decrypt, const          %8.1f\n", bench_run(bench_otfks_encrypt_decrypt_const, BENCH_ITERATIONS, 2u));
+    printf("  otfks encrypt + decrypt, session        %8.1f\n", bench_run(bench_otfks_session, BENCH_ITERATIONS, 2u));
+    printf("  khazad_otfks_encrypt_blocks             %8.1f\n", bench_run(bench_otfks_encrypt_blocks, BENCH_BATCH_ITERATIONS, BENCH_BLOCKS));
+    printf("  khazad_otfks_decrypt_blocks             %8.1f\n", bench_run(bench_otfks_decrypt_blocks, BENCH_BATCH_ITERATIONS, BENCH_BLOCKS));
+    printf("  khazad_crypt_blocks                     %8.1f\n", bench_run(bench_crypt_blocks, BENCH_BATCH_ITERATIONS, BENCH_BLOCKS));
+    printf("  khazad_decrypt_blocks                   %8.1f\n", bench_run(bench_decrypt_blocks, BENCH_BATCH_ITERATIONS, BENCH_BLOCKS));
+    khazad_key_schedule_multi(key_schedules, keys, BENCH_KEYS);
+    for (i = 0; i < BENCH_KEYS; ++i)
+    {
+        keyed_blocks[i].p_block = &blocks[i * KHAZAD_BLOCK_SIZE];
+        keyed_blocks[i].p_key_schedule = &key_schedules[i * KHAZAD_KEY_SCHEDULE_SIZE];
+    }
+    for (i = 0; i < BENCH_BLOCKS; ++i)
+    {
+        jobs[i].key_id = (uint32_t)((i * 2654435761u) % BENCH_KEYS);
+    }
+    printf("mixed keys, %u blocks per key (%s per block):\n", BENCH_BLOCKS / BENCH_KEYS, p_unit);
+    printf("  khazad_crypt, key per job               %8.1f\n", bench_run(bench_crypt_each_job, BENCH_BATCH_ITERATIONS, BENCH_BLOCKS));
+    printf("  khazad_crypt_jobs                       %8.1f\n", bench_run(bench_crypt_jobs, BENCH_BATCH_ITERATIONS, BENCH_BLOCKS));
+    printf("key-agile (%s per key and block):\n", p_unit);
+    printf("  khazad_decrypt, key per block           %8.1f\n", bench_run(bench_decrypt_each_key, BENCH_BATCH_ITERATIONS, BENCH_KEYS));
+    printf("  khazad_decrypt_keyed_blocks             %8.1f\n", bench_run(bench_decrypt_keyed_blocks, BENCH_BATCH_ITERATIONS, BENCH_KEYS));
+    printf("  key schedule + khazad_crypt             %8.1f\n", bench_run(bench_key_and_crypt, BENCH_ITERATIONS, 1u));
+    printf("  khazad_crypt_and_expand                 %8.1f\n", bench_run(bench_crypt_and_expand, BENCH_ITERATIONS, 1u));
+    p_adaptive = khazad_adaptive_create(key);
+    if (p_adaptive == NULL)
+    {
+        printf("out of memory\n");
+        return 1;
+    }
+    printf("  khazad_adaptive_crypt_blocks            %8.1f\n", bench_run(bench_adaptive_one_block, BENCH_ITERATIONS, 1u));
+    printf("adaptive, threshold %u, %u blocks per key (%s per block):\n", (unsigned)khazad_adaptive_threshold(),
+           BENCH_ADAPTIVE_BLOCKS, p_unit);
+    printf("  khazad_adaptive_crypt_blocks            %8.1f\n", bench_run(bench_adaptive_blocks, BENCH_ITERATIONS, BENCH_ADAPTIVE_BLOCKS));
+    printf("  key schedule + khazad_crypt_blocks      %8.1f\n", bench_run(bench_key_and_crypt_blocks, BENCH_ITERATIONS, BENCH_ADAPTIVE_BLOCKS));
+    khazad_adaptive_destroy(p_adaptive);
+    return 0;
+}
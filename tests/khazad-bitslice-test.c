@@ -0,0 +1,86 @@
+/*****************************************************************************
+ * khazad-bitslice-test.c
+ *
+ * Test bitsliced Khazad encryption and decryption against the regular
+ * single-block functions.
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Includes
+ ****************************************************************************/
+
+#include "khazad-min.h"
+#include "khazad-print-block.h"
+
+#include <string.h>
+
+/*****************************************************************************
+ * Defines
+ ****************************************************************************/
+
+/* Not a multiple of any group size, to test the partial group at the end. */
+#define NUM_TEST_BLOCKS     1100u
+
+/*****************************************************************************
+ * Functions
+ ****************************************************************************/
+
+int main(int argc, char **argv)
+{
+    size_t  i;
+    uint8_t key[KHAZAD_KEY_SIZE];
+    uint8_t encrypt_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE];
+    uint8_t decrypt_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE];
+    uint8_t plain_blocks[NUM_TEST_BLOCKS * KHAZAD_BLOCK_SIZE];
+    uint8_t expected_blocks[NUM_TEST_BLOCKS * KHAZAD_BLOCK_SIZE];
+    uint8_t crypt_blocks[NUM_TEST_BLOCKS * KHAZAD_BLOCK_SIZE];
+
+    (void)argc;
+    (void)argv;
+
+    for (i = 0; i < KHAZAD_KEY_SIZE; ++i)
+    {
+        key[i] = (uint8_t)(i * 0x3Bu + 0x11u);
+    }
+    for (i = 0; i < sizeof(plain_blocks); ++i)
+    {
+        plain_blocks[i] = (uint8_t)(i * 0x9Du ^ (i >> 8u));
+    }
+    khazad_key_schedule(encrypt_key_schedule, key);
+    khazad_decrypt_key_schedule(decrypt_key_schedule, key);
+
+    /* Encrypt */
+    memcpy(expected_blocks, plain_blocks, sizeof(plain_blocks));
+    for (i = 0; i < NUM_TEST_BLOCKS; ++i)
+    {
+        khazad_crypt(&expected_blocks[i * KHAZAD_BLOCK_SIZE], encrypt_key_schedule);
+    }
+    memcpy(crypt_blocks, plain_blocks, sizeof(plain_blocks));
+    khazad_bitslice_crypt(crypt_blocks, NUM_TEST_BLOCKS, encrypt_key_schedule);
+    printf("bitslice crypt: ");
+    print_block_hex(crypt_blocks, KHAZAD_BLOCK_SIZE);
+    if (memcmp(crypt_blocks, expected_blocks, sizeof(crypt_blocks)) != 0)
+    {
+        printf("bitslice encrypt error\n");
+        return 1;
+    }
+
+    /* Decrypt with the encryption key schedule */
+    khazad_bitslice_decrypt(crypt_blocks, NUM_TEST_BLOCKS, encrypt_key_schedule);
+    if (memcmp(crypt_blocks, plain_blocks, sizeof(crypt_blocks)) != 0)
+    {
+        printf("bitslice decrypt error\n");
+        return 1;
+    }
+
+    /* Decrypt with the decryption key schedule */
+    memcpy(crypt_blocks, expected_blocks, sizeof(expected_blocks));
+    khazad_bitslice_crypt(crypt_blocks, NUM_TEST_BLOCKS, decrypt_key_schedule);
+    if (memcmp(crypt_blocks, plain_blocks, sizeof(crypt_blocks)) != 0)
+    {
+        printf("bitslice decrypt key schedule error\n");
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,281 @@
+/*****************************************************************************
+ * khazad-cache-test.c
+ *
+ * Test the Khazad key schedule cache: hits and misses, eviction, key rotation
+ * and removal, then concurrent use from several threads.
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Includes
+ ****************************************************************************/
+
+#include "khazad-min.h"
+#include "khazad-min-cache.h"
+#include "khazad-test-fixtures.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+/*****************************************************************************
+ * Defines
+ ****************************************************************************/
+
+#define NUM_TEST_KEYS       1000u
+#define NUM_THREADS         4u
+#define NUM_THREAD_LOOKUPS  50000u
+
+/* Room for about 100 entries. */
+#define TEST_CACHE_MEMORY   (100u * 150u)
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+
+static uint8_t keys[NUM_TEST_KEYS * KHAZAD_KEY_SIZE];
+static uint8_t key_schedules[NUM_TEST_KEYS * KHAZAD_KEY_SCHEDULE_SIZE];
+
+/*****************************************************************************
+ * Functions
+ ****************************************************************************/
+
+static const uint8_t * test_key(size_t i)
+{
+    return &keys[i * KHAZAD_KEY_SIZE];
+}
+
+static const uint8_t * test_key_schedule(size_t i)
+{
+    return &key_schedules[i * KHAZAD_KEY_SCHEDULE_SIZE];
+}
+
+static int test_get(khazad_cache_t * p_cache, uint64_t id, size_t key_index)
+{
+    khazad_cache_guard_t    guard;
+    const uint8_t         * p_key_schedule;
+
+    p_key_schedule = khazad_cache_get(p_cache, id, test_key(key_index), &guard);
+    if (p_key_schedule == NULL || memcmp(p_key_schedule, test_key_schedule(key_index), KHAZAD_KEY_SCHEDULE_SIZE) != 0)
+    {
+        printf("cache get error, id %llu\n", (unsigned long long)id);
+        return 1;
+    }
+    khazad_cache_release(&guard);
+    return 0;
+}
+
+static int test_cache_single(void)
+{
+    khazad_cache_t        * p_cache;
+    khazad_cache_stats_t    stats;
+    khazad_cache_guard_t    guard;
+    khazad_cache_guard_t    old_guard;
+    const uint8_t         * p_old_key_schedule;
+    uint8_t                 old_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE];
+    size_t                  capacity;
+    size_t                  i;
+
+    if (khazad_cache_create(1u, 1u) != NULL)
+    {
+        printf("cache create error, too small\n");
+        return 1;
+    }
+    p_cache = khazad_cache_create(TEST_CACHE_MEMORY, 1u);
+    if (p_cache == NULL)
+    {
+        printf("cache create error\n");
+        return 1;
+    }
+    khazad_cache_get_stats(p_cache, &stats);
+    capacity = stats.capacity;
+    printf("cache capacity: %zu\n", capacity);
+    if (capacity == 0 || capacity + 10u > NUM_TEST_KEYS)
+    {
+        printf("cache capacity error\n");
+        return 1;
+    }
+
+    /* Fill the cache, then look everything up again. */
+    for (i = 0; i < capacity; ++i)
+    {
+        if (test_get(p_cache, i, i))
+            return 1;
+    }
+    for (i = 0; i < capacity; ++i)
+    {
+        if (test_get(p_cache, i, i))
+            return 1;
+    }
+    khazad_cache_get_stats(p_cache, &stats);
+    if (stats.misses != capacity || stats.hits != capacity || stats.insertions != capacity
+        || stats.num_entries != capacity || stats.evictions != 0)
+    {
+        printf("cache fill stats error\n");
+        return 1;
+    }
+
+    /* Overfill it. */
+    for (i = capacity; i < capacity + 10u; ++i)
+    {
+        if (test_get(p_cache, i, i))
+            return 1;
+    }
+    khazad_cache_get_stats(p_cache, &stats);
+    if (stats.evictions != 10u || stats.num_entries != capacity)
+    {
+        printf("cache eviction stats error\n");
+        return 1;
+    }
+
+    /* Rotate the key for an id, while its old key schedule is held. */
+    i = capacity + 9u;
+    p_old_key_schedule = khazad_cache_lookup(p_cache, i, &old_guard);
+    if (p_old_key_schedule == NULL)
+    {
+        printf("cache lookup error\n");
+        return 1;
+    }
+    memcpy(old_key_schedule, p_old_key_schedule, KHAZAD_KEY_SCHEDULE_SIZE);
+    if (test_get(p_cache, i, 0))
+        return 1;
+    khazad_cache_get_stats(p_cache, &stats);
+    if (stats.replacements != 1u || stats.num_retired == 0)
+    {
+        printf("cache replacement stats error\n");
+        return 1;
+    }
+    khazad_cache_reclaim(p_cache);
+    if (memcmp(p_old_key_schedule, old_key_schedule, KHAZAD_KEY_SCHEDULE_SIZE) != 0)
+    {
+        printf("cache old key schedule error\n");
+        return 1;
+    }
+    khazad_cache_release(&old_guard);
+
+    /* Remove it. */
+    khazad_cache_remove(p_cache, i);
+    if (khazad_cache_lookup(p_cache, i, &guard) != NULL)
+    {
+        printf("cache remove error\n");
+        return 1;
+    }
+    khazad_cache_reclaim(p_cache);
+    khazad_cache_get_stats(p_cache, &stats);
+    if (stats.num_entries != capacity - 1u || stats.num_retired != 0)
+    {
+        printf("cache remove stats error\n");
+        return 1;
+    }
+
+    /* Keys as ids. */
+    for (i = 0; i < 2u; ++i)
+    {
+        if (khazad_cache_get_by_key(p_cache, test_key(7u), &guard) == NULL)
+        {
+            printf("cache get by key error\n");
+            return 1;
+        }
+        if (memcmp(khazad_cache_get_by_key(p_cache, test_key(7u), &old_guard), test_key_schedule(7u), KHAZAD_KEY_SCHEDULE_SIZE) != 0)
+        {
+            printf("cache get by key error\n");
+            return 1;
+        }
+        khazad_cache_release(&old_guard);
+        khazad_cache_release(&guard);
+    }
+
+    khazad_cache_destroy(p_cache);
+    return 0;
+}
+
+static void * test_thread(void * p_arg)
+{
+    khazad_cache_t        * p_cache = (khazad_cache_t *)p_arg;
+    khazad_cache_guard_t    guard;
+    const uint8_t         * p_key_schedule;
+    uint32_t                state = (uint32_t)(uintptr_t)&guard;
+    size_t                  key_index;
+    size_t                  i;
+
+    for (i = 0; i < NUM_THREAD_LOOKUPS; ++i)
+    {
+        state = state * 1103515245u + 12345u;
+        /* Skewed towards low key indices, so some keys are hot. */
+        key_index = ((state >> 8u) % NUM_TEST_KEYS) >> ((state >> 4u) & 3u);
+        if ((state & 0xFu) == 0)
+        {
+            khazad_cache_remove(p_cache, key_index);
+            continue;
+        }
+        p_key_schedule = khazad_cache_get(p_cache, key_index, test_key(key_index), &guard);
+        if (p_key_schedule == NULL || memcmp(p_key_schedule, test_key_schedule(key_index), KHAZAD_KEY_SCHEDULE_SIZE) != 0)
+            return p_arg;
+        khazad_cache_release(&guard);
+    }
+    return NULL;
+}
+
+static int test_cache_threads(void)
+{
+    khazad_cache_t        * p_cache;
+    khazad_cache_stats_t    stats;
+    pthread_t               threads[NUM_THREADS];
+    void                  * p_result;
+    int                     result = 0;
+    size_t                  i;
+
+    p_cache = khazad_cache_create(TEST_CACHE_MEMORY * 2u, 4u);
+    if (p_cache == NULL)
+    {
+        printf("cache create error\n");
+        return 1;
+    }
+    for (i = 0; i < NUM_THREADS; ++i)
+    {
+        if (pthread_create(&threads[i], NULL, test_thread, p_cache) != 0)
+        {
+            printf("thread create error\n");
+            return 1;
+        }
+    }
+    for (i = 0; i < NUM_THREADS; ++i)
+    {
+        pthread_join(threads[i], &p_result);
+        if (p_result != NULL)
+            result = 1;
+    }
+    if (result)
+    {
+        printf("cache threads key schedule error\n");
+        return 1;
+    }
+
+    khazad_cache_reclaim(p_cache);
+    khazad_cache_get_stats(p_cache, &stats);
+    printf("cache threads: %llu hits, %llu misses, %llu evictions\n",
+           (unsigned long long)stats.hits, (unsigned long long)stats.misses, (unsigned long long)stats.evictions);
+    if (stats.hits + stats.misses == 0 || stats.hits + stats.misses > NUM_THREADS * NUM_THREAD_LOOKUPS
+        || stats.num_entries > stats.capacity || stats.num_retired != 0)
+    {
+        printf("cache threads stats error\n");
+        return 1;
+    }
+    khazad_cache_destroy(p_cache);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+
+    fill_test_keys(keys, NUM_TEST_KEYS);
+    khazad_key_schedule_multi(key_schedules, keys, NUM_TEST_KEYS);
+
+    if (test_cache_single())
+        return 1;
+    if (test_cache_threads())
+        return 1;
+
+    return 0;
+}
@@ -0,0 +1,112 @@
+/*****************************************************************************
+ * khazad-ctx-test.c
+ *
+ * Test Khazad key contexts against the functions that take a key schedule.
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Includes
+ ****************************************************************************/
+
+#include "khazad-min.h"
+#include "khazad-min-ctx.h"
+#include "khazad-print-block.h"
+
+#include <string.h>
+
+/*****************************************************************************
+ * Defines
+ ****************************************************************************/
+
+#define NUM_TEST_BLOCKS     37u
+
+/*****************************************************************************
+ * Functions
+ ****************************************************************************/
+
+static int test_ctx(const uint8_t * p_plain_blocks, const uint8_t * p_expected_blocks, const uint8_t p_key[KHAZAD_KEY_SIZE], unsigned flags)
+{
+    khazad_ctx_t  * p_ctx;
+    uint8_t         crypt_blocks[NUM_TEST_BLOCKS * KHAZAD_BLOCK_SIZE];
+
+    p_ctx = khazad_ctx_create(p_key, flags);
+    if (p_ctx == NULL)
+    {
+        printf("ctx create error\n");
+        return 1;
+    }
+    if (((uintptr_t)p_ctx % KHAZAD_CACHE_LINE_SIZE) != 0)
+    {
+        printf("ctx alignment error\n");
+        khazad_ctx_destroy(p_ctx);
+        return 1;
+    }
+
+    khazad_ctx_crypt_blocks(crypt_blocks, p_plain_blocks, NUM_TEST_BLOCKS, p_ctx);
+    printf("ctx crypt: ");
+    print_block_hex(crypt_blocks, KHAZAD_BLOCK_SIZE);
+    if (memcmp(crypt_blocks, p_expected_blocks, sizeof(crypt_blocks)) != 0)
+    {
+        printf("ctx encrypt error, flags %u\n", flags);
+        khazad_ctx_destroy(p_ctx);
+        return 1;
+    }
+    khazad_ctx_decrypt_blocks(crypt_blocks, crypt_blocks, NUM_TEST_BLOCKS, p_ctx);
+    if (memcmp(crypt_blocks, p_plain_blocks, sizeof(crypt_blocks)) != 0)
+    {
+        printf("ctx decrypt error, flags %u\n", flags);
+        khazad_ctx_destroy(p_ctx);
+        return 1;
+    }
+
+    /* Rekey to a different key, then back */
+    khazad_ctx_rekey(p_ctx, p_plain_blocks);
+    khazad_ctx_crypt_blocks(crypt_blocks, p_plain_blocks, NUM_TEST_BLOCKS, p_ctx);
+    if (memcmp(crypt_blocks, p_expected_blocks, sizeof(crypt_blocks)) == 0)
+    {
+        printf("ctx rekey error, flags %u\n", flags);
+        khazad_ctx_destroy(p_ctx);
+        return 1;
+    }
+    khazad_ctx_rekey(p_ctx, p_key);
+    khazad_ctx_decrypt_blocks(crypt_blocks, p_expected_blocks, NUM_TEST_BLOCKS, p_ctx);
+    if (memcmp(crypt_blocks, p_plain_blocks, sizeof(crypt_blocks)) != 0)
+    {
+        printf("ctx rekey decrypt error, flags %u\n", flags);
+        khazad_ctx_destroy(p_ctx);
+        return 1;
+    }
+
+    khazad_ctx_destroy(p_ctx);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    size_t  i;
+    uint8_t key[KHAZAD_KEY_SIZE];
+    uint8_t key_schedule[KHAZAD_KEY_SCHEDULE_SIZE];
+    uint8_t plain_blocks[NUM_TEST_BLOCKS * KHAZAD_BLOCK_SIZE];
+    uint8_t expected_blocks[NUM_TEST_BLOCKS * KHAZAD_BLOCK_SIZE];
+
+    (void)argc;
+    (void)argv;
+
+    for (i = 0; i < KHAZAD_KEY_SIZE; ++i)
+    {
+        key[i] = (uint8_t)(i * 0x3Bu + 0x11u);
+    }
+    for (i = 0; i < sizeof(plain_blocks); ++i)
+    {
+        plain_blocks[i] = (uint8_t)(i * 0x9Du ^ (i >> 8u));
+    }
+    khazad_key_schedule(key_schedule, key);
+    khazad_crypt_blocks(expected_blocks, plain_blocks, NUM_TEST_BLOCKS, key_schedule);
+
+    if (test_ctx(plain_blocks, expected_blocks, key, 0))
+        return 1;
+    if (test_ctx(plain_blocks, expected_blocks, key, KHAZAD_CTX_DECRYPT_KEYS))
+        return 1;
+
+    return 0;
+}
@@ -0,0 +1,158 @@
+/*****************************************************************************
+ * khazad-jobs-test.c
+ *
+ * Test Khazad key-grouped jobs against the regular single-block functions.
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Includes
+ ****************************************************************************/
+
+#include "khazad-min.h"
+#include "khazad-print-block.h"
+#include "khazad-test-fixtures.h"
+
+#include <string.h>
+#include <stdbool.h>
+
+/*****************************************************************************
+ * Defines
+ ****************************************************************************/
+
+/* More than one chunk, and not a multiple of the chunk size. */
+#define NUM_TEST_JOBS       2500u
+
+/* Key ids need more than 16 bits, to test every radix sort pass. */
+#define NUM_TEST_KEYS       70000u
+
+/* Key schedules are only calculated for the first keys. */
+#define NUM_TEST_SCHEDULES  100u
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+
+static uint8_t keys[NUM_TEST_KEYS * KHAZAD_KEY_SIZE];
+static uint8_t encrypt_key_schedules[NUM_TEST_SCHEDULES * KHAZAD_KEY_SCHEDULE_SIZE];
+static uint8_t decrypt_key_schedules[NUM_TEST_SCHEDULES * KHAZAD_KEY_SCHEDULE_SIZE];
+static khazad_job_t jobs[NUM_TEST_JOBS];
+static khazad_job_t plain_jobs[NUM_TEST_JOBS];
+static khazad_job_t expected_jobs[NUM_TEST_JOBS];
+
+/*****************************************************************************
+ * Local functions
+ ****************************************************************************/
+
+static void make_jobs(uint32_t num_keys)
+{
+    uint8_t     key_schedule[KHAZAD_KEY_SCHEDULE_SIZE];
+    size_t      i;
+    size_t      j;
+
+    for (i = 0; i < NUM_TEST_JOBS; ++i)
+    {
+        /* A few keys with many jobs, and the rest scattered. */
+        if (i % 4u)
+            plain_jobs[i].key_id = (uint32_t)(i % 3u);
+        else
+            plain_jobs[i].key_id = (uint32_t)((i * 2654435761u) % num_keys);
+        for (j = 0; j < KHAZAD_BLOCK_SIZE; ++j)
+        {
+            plain_jobs[i].block[j] = (uint8_t)(i * 0x9Du ^ j * 0x31u ^ (i >> 8u));
+        }
+        expected_jobs[i] = plain_jobs[i];
+        khazad_key_schedule(key_schedule, &keys[plain_jobs[i].key_id * KHAZAD_KEY_SIZE]);
+        khazad_crypt(expected_jobs[i].block, key_schedule);
+    }
+}
+
+static bool jobs_equal(const khazad_job_t * p_jobs_1, const khazad_job_t * p_jobs_2)
+{
+    size_t      i;
+
+    for (i = 0; i < NUM_TEST_JOBS; ++i)
+    {
+        if (p_jobs_1[i].key_id != p_jobs_2[i].key_id ||
+            memcmp(p_jobs_1[i].block, p_jobs_2[i].block, KHAZAD_BLOCK_SIZE) != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*****************************************************************************
+ * Functions
+ ****************************************************************************/
+
+int main(int argc, char **argv)
+{
+    size_t  i;
+
+    (void)argc;
+    (void)argv;
+
+    fill_test_keys(keys, NUM_TEST_KEYS);
+    khazad_key_schedule_multi(encrypt_key_schedules, keys, NUM_TEST_SCHEDULES);
+    for (i = 0; i < NUM_TEST_SCHEDULES; ++i)
+    {
+        khazad_decrypt_key_schedule_from_encrypt(&decrypt_key_schedules[i * KHAZAD_KEY_SCHEDULE_SIZE],
+                                                 &encrypt_key_schedules[i * KHAZAD_KEY_SCHEDULE_SIZE]);
+    }
+
+    /* Key schedules */
+    make_jobs(NUM_TEST_SCHEDULES);
+    memcpy(jobs, plain_jobs, sizeof(jobs));
+    khazad_crypt_jobs(jobs, NUM_TEST_JOBS, encrypt_key_schedules);
+    printf("jobs crypt: ");
+    print_block_hex(jobs[0].block, KHAZAD_BLOCK_SIZE);
+    if (!jobs_equal(jobs, expected_jobs))
+    {
+        printf("jobs encrypt error\n");
+        return 1;
+    }
+    khazad_decrypt_jobs(jobs, NUM_TEST_JOBS, encrypt_key_schedules);
+    if (!jobs_equal(jobs, plain_jobs))
+    {
+        printf("jobs decrypt error\n");
+        return 1;
+    }
+    memcpy(jobs, expected_jobs, sizeof(jobs));
+    khazad_crypt_jobs(jobs, NUM_TEST_JOBS, decrypt_key_schedules);
+    if (!jobs_equal(jobs, plain_jobs))
+    {
+        printf("jobs decrypt key schedule error\n");
+        return 1;
+    }
+
+    /* A few jobs at a time, which the dispatcher does in small chunks on the
+     * stack */
+    memcpy(jobs, plain_jobs, sizeof(jobs));
+    for (i = 0; i < NUM_TEST_JOBS; i += 20u)
+    {
+        khazad_crypt_jobs(&jobs[i], (NUM_TEST_JOBS - i < 20u) ? NUM_TEST_JOBS - i : 20u, encrypt_key_schedules);
+    }
+    if (!jobs_equal(jobs, expected_jobs))
+    {
+        printf("jobs small batch encrypt error\n");
+        return 1;
+    }
+
+    /* Keys */
+    make_jobs(NUM_TEST_KEYS);
+    memcpy(jobs, plain_jobs, sizeof(jobs));
+    khazad_crypt_jobs_with_keys(jobs, NUM_TEST_JOBS, keys);
+    if (!jobs_equal(jobs, expected_jobs))
+    {
+        printf("jobs with keys encrypt error\n");
+        return 1;
+    }
+    khazad_decrypt_jobs_with_keys(jobs, NUM_TEST_JOBS, keys);
+    if (!jobs_equal(jobs, plain_jobs))
+    {
+        printf("jobs with keys decrypt error\n");
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,315 @@
+/*****************************************************************************
+ * khazad-kernels-test.c
+ *
+ * Test the multi-block Khazad kernels against the regular single-block
+ * functions. Kernels that the CPU doesn't support are skipped.
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Includes
+ ****************************************************************************/
+
+#include "khazad-min.h"
+#include "khazad-min-internal.h"
+#include "khazad-print-block.h"
+
+#include <string.h>
+#include <stdbool.h>
+
+/*****************************************************************************
+ * Defines
+ ****************************************************************************/
+
+#ifndef dimof
+#define dimof(array)    (sizeof(array) / sizeof(array[0]))
+#endif
+
+#define MAX_TEST_BLOCKS     100u
+#define MAX_TEST_KEYS       MAX_TEST_BLOCKS
+
+/*****************************************************************************
+ * Types
+ ****************************************************************************/
+
+typedef void (*blocks_func_t)(uint8_t * p_dst, const uint8_t * p_src, size_t num_blocks, const uint8_t p_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE]);
+
+typedef void (*key_schedule_multi_func_t)(uint8_t * p_key_schedules, const uint8_t * p_keys, size_t num_keys);
+typedef void (*keyed_blocks_func_t)(const khazad_keyed_block_t * p_blocks, size_t num_blocks);
+
+typedef struct
+{
+    const char                * name;
+    bool                        (*is_supported)(void);
+    blocks_func_t               crypt_blocks;
+    blocks_func_t               decrypt_blocks;
+    key_schedule_multi_func_t   key_schedule_multi;
+    keyed_blocks_func_t         crypt_keyed_blocks;
+    keyed_blocks_func_t         decrypt_keyed_blocks;
+} kernel_test_t;
+
+/*****************************************************************************
+ * Local functions
+ ****************************************************************************/
+
+static bool cpu_has_any(void)
+{
+    return true;
+}
+
+#ifdef ENABLE_X86_KERNELS
+
+static bool cpu_has_ssse3(void)
+{
+    return __builtin_cpu_supports("ssse3");
+}
+
+static bool cpu_has_avx2(void)
+{
+    return __builtin_cpu_supports("avx2");
+}
+
+#endif /* ENABLE_X86_KERNELS */
+
+#ifdef ENABLE_X86_AVX512_KERNEL
+
+static bool cpu_has_avx512(void)
+{
+    return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")
+        && __builtin_cpu_supports("avx512vbmi") && __builtin_cpu_supports("gfni");
+}
+
+#endif /* ENABLE_X86_AVX512_KERNEL */
+
+static const kernel_test_t kernel_tests[] =
+{
+#ifdef ENABLE_X86_KERNELS
+    { "scalar", cpu_has_any,
+      khazad_scalar_crypt_blocks, khazad_scalar_decrypt_blocks,
+      khazad_scalar_key_schedule_multi,
+      khazad_scalar_crypt_keyed_blocks, khazad_scalar_decrypt_keyed_blocks },
+    { "dispatch", cpu_has_any,
+      khazad_crypt_blocks, khazad_decrypt_blocks,
+      khazad_key_schedule_multi,
+      khazad_crypt_keyed_blocks, khazad_decrypt_keyed_blocks },
+#else
+    { "scalar", cpu_has_any,
+      khazad_crypt_blocks, khazad_decrypt_blocks,
+      khazad_key_schedule_multi,
+      khazad_crypt_keyed_blocks, khazad_decrypt_keyed_blocks },
+#endif
+#ifdef ENABLE_X86_KERNELS
+    { "ssse3", cpu_has_ssse3,
+      khazad_ssse3_crypt_blocks, khazad_ssse3_decrypt_blocks,
+      khazad_ssse3_key_schedule_multi,
+      khazad_ssse3_crypt_keyed_blocks, khazad_ssse3_decrypt_keyed_blocks },
+    { "avx2", cpu_has_avx2,
+      khazad_avx2_crypt_blocks, khazad_avx2_decrypt_blocks,
+      khazad_avx2_key_schedule_multi,
+      khazad_avx2_crypt_keyed_blocks, khazad_avx2_decrypt_keyed_blocks },
+    { "avx2-gather", cpu_has_avx2,
+      khazad_avx2_gather_crypt_blocks, khazad_avx2_gather_decrypt_blocks,
+      khazad_avx2_key_schedule_multi,
+      khazad_avx2_crypt_keyed_blocks, khazad_avx2_decrypt_keyed_blocks },
+#endif
+#ifdef ENABLE_X86_AVX512_KERNEL
+    { "avx512", cpu_has_avx512,
+      khazad_avx512_crypt_blocks, khazad_avx512_decrypt_blocks,
+      khazad_avx512_key_schedule_multi,
+#if defined(__x86_64__)
+      khazad_avx512_crypt_keyed_blocks, khazad_avx512_decrypt_keyed_blocks },
+#else
+      khazad_avx2_crypt_keyed_blocks, khazad_avx2_decrypt_keyed_blocks },
+#endif
+#endif
+    { NULL, NULL, NULL, NULL, NULL, NULL, NULL }
+};
+
+static bool test_kernel(const kernel_test_t * p_kernel, size_t num_blocks)
+{
+    size_t  i;
+    uint8_t key[KHAZAD_KEY_SIZE];
+    uint8_t encrypt_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE];
+    uint8_t decrypt_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE];
+    uint8_t plain_blocks[MAX_TEST_BLOCKS * KHAZAD_BLOCK_SIZE];
+    uint8_t expected_blocks[MAX_TEST_BLOCKS * KHAZAD_BLOCK_SIZE];
+    uint8_t crypt_blocks[MAX_TEST_BLOCKS * KHAZAD_BLOCK_SIZE + KHAZAD_BLOCK_SIZE];
+    size_t  len = num_blocks * KHAZAD_BLOCK_SIZE;
+
+    for (i = 0; i < KHAZAD_KEY_SIZE; ++i)
+    {
+        key[i] = (uint8_t)(i * 0x4Du + num_blocks);
+    }
+    for (i = 0; i < len; ++i)
+    {
+        plain_blocks[i] = (uint8_t)(i * 0x9Du ^ (i >> 8u));
+    }
+    khazad_key_schedule(encrypt_key_schedule, key);
+    khazad_decrypt_key_schedule(decrypt_key_schedule, key);
+
+    memcpy(expected_blocks, plain_blocks, len);
+    for (i = 0; i < num_blocks; ++i)
+    {
+        khazad_crypt(&expected_blocks[i * KHAZAD_BLOCK_SIZE], encrypt_key_schedule);
+    }
+
+    /* Encrypt out-of-place, and check that nothing past the end is written. */
+    memset(crypt_blocks, 0xA5, sizeof(crypt_blocks));
+    p_kernel->crypt_blocks(crypt_blocks, plain_blocks, num_blocks, encrypt_key_schedule);
+    if (memcmp(crypt_blocks, expected_blocks, len) != 0 || crypt_blocks[len] != 0xA5)
+    {
+        printf("%s %u blocks encrypt error\n", p_kernel->name, (unsigned)num_blocks);
+        return false;
+    }
+
+    /* Decrypt in-place, with the encryption key schedule. */
+    p_kernel->decrypt_blocks(crypt_blocks, crypt_blocks, num_blocks, encrypt_key_schedule);
+    if (memcmp(crypt_blocks, plain_blocks, len) != 0)
+    {
+        printf("%s %u blocks decrypt error\n", p_kernel->name, (unsigned)num_blocks);
+        return false;
+    }
+
+    /* Decrypt in-place, with the decryption key schedule. */
+    memcpy(crypt_blocks, expected_blocks, len);
+    p_kernel->crypt_blocks(crypt_blocks, crypt_blocks, num_blocks, decrypt_key_schedule);
+    if (memcmp(crypt_blocks, plain_blocks, len) != 0)
+    {
+        printf("%s %u blocks decrypt key schedule error\n", p_kernel->name, (unsigned)num_blocks);
+        return false;
+    }
+
+    return true;
+}
+
+static bool test_kernel_key_schedule(const kernel_test_t * p_kernel, size_t num_keys)
+{
+    size_t  i;
+    uint8_t keys[MAX_TEST_KEYS * KHAZAD_KEY_SIZE];
+    uint8_t expected_key_schedules[MAX_TEST_KEYS * KHAZAD_KEY_SCHEDULE_SIZE];
+    uint8_t key_schedules[MAX_TEST_KEYS * KHAZAD_KEY_SCHEDULE_SIZE + 1u];
+    size_t  len = num_keys * KHAZAD_KEY_SCHEDULE_SIZE;
+
+    for (i = 0; i < num_keys * KHAZAD_KEY_SIZE; ++i)
+    {
+        keys[i] = (uint8_t)(i * 0x3Bu ^ (i >> 4u));
+    }
+    for (i = 0; i < num_keys; ++i)
+    {
+        khazad_key_schedule(&expected_key_schedules[i * KHAZAD_KEY_SCHEDULE_SIZE], &keys[i * KHAZAD_KEY_SIZE]);
+    }
+
+    /* Check that nothing past the end is written. */
+    memset(key_schedules, 0xA5, sizeof(key_schedules));
+    p_kernel->key_schedule_multi(key_schedules, keys, num_keys);
+    if (memcmp(key_schedules, expected_key_schedules, len) != 0 || key_schedules[len] != 0xA5)
+    {
+        printf("%s %u keys key schedule error\n", p_kernel->name, (unsigned)num_keys);
+        return false;
+    }
+
+    return true;
+}
+
+static bool test_kernel_keyed(const kernel_test_t * p_kernel, size_t num_blocks)
+{
+    size_t                  i;
+    uint8_t                 keys[MAX_TEST_KEYS * KHAZAD_KEY_SIZE];
+    uint8_t                 encrypt_key_schedules[MAX_TEST_KEYS * KHAZAD_KEY_SCHEDULE_SIZE];
+    uint8_t                 decrypt_key_schedules[MAX_TEST_KEYS * KHAZAD_KEY_SCHEDULE_SIZE];
+    uint8_t                 plain_blocks[MAX_TEST_BLOCKS * KHAZAD_BLOCK_SIZE];
+    uint8_t                 expected_blocks[MAX_TEST_BLOCKS * KHAZAD_BLOCK_SIZE];
+    uint8_t                 crypt_blocks[MAX_TEST_BLOCKS * KHAZAD_BLOCK_SIZE + KHAZAD_BLOCK_SIZE];
+    khazad_keyed_block_t    keyed_blocks[MAX_TEST_BLOCKS];
+    size_t                  len = num_blocks * KHAZAD_BLOCK_SIZE;
+
+    for (i = 0; i < num_blocks * KHAZAD_KEY_SIZE; ++i)
+    {
+        keys[i] = (uint8_t)(i * 0x5Bu ^ (i >> 3u));
+    }
+    for (i = 0; i < len; ++i)
+    {
+        plain_blocks[i] = (uint8_t)(i * 0x9Du ^ (i >> 8u));
+    }
+    /* Every third block shares the previous block's key. */
+    for (i = 0; i < num_blocks; ++i)
+    {
+        khazad_key_schedule(&encrypt_key_schedules[i * KHAZAD_KEY_SCHEDULE_SIZE], &keys[(i - (i % 3u == 2u)) * KHAZAD_KEY_SIZE]);
+        khazad_decrypt_key_schedule_from_encrypt(&decrypt_key_schedules[i * KHAZAD_KEY_SCHEDULE_SIZE], &encrypt_key_schedules[i * KHAZAD_KEY_SCHEDULE_SIZE]);
+        memcpy(&expected_blocks[i * KHAZAD_BLOCK_SIZE], &plain_blocks[i * KHAZAD_BLOCK_SIZE], KHAZAD_BLOCK_SIZE);
+        khazad_crypt(&expected_blocks[i * KHAZAD_BLOCK_SIZE], &encrypt_key_schedules[i * KHAZAD_KEY_SCHEDULE_SIZE]);
+    }
+
+    /* Blocks in reverse order, so they aren't contiguous in order. Check that
+     * nothing else is written. */
+    memset(crypt_blocks, 0xA5, sizeof(crypt_blocks));
+    memcpy(crypt_blocks, plain_blocks, len);
+    for (i = 0; i < num_blocks; ++i)
+    {
+        keyed_blocks[i].p_block = &crypt_blocks[(num_blocks - 1u - i) * KHAZAD_BLOCK_SIZE];
+        keyed_blocks[i].p_key_schedule = &encrypt_key_schedules[(num_blocks - 1u - i) * KHAZAD_KEY_SCHEDULE_SIZE];
+    }
+    p_kernel->crypt_keyed_blocks(keyed_blocks, num_blocks);
+    if (memcmp(crypt_blocks, expected_blocks, len) != 0 || crypt_blocks[len] != 0xA5)
+    {
+        printf("%s %u keyed blocks encrypt error\n", p_kernel->name, (unsigned)num_blocks);
+        return false;
+    }
+
+    /* Decrypt, with the encryption key schedules. */
+    p_kernel->decrypt_keyed_blocks(keyed_blocks, num_blocks);
+    if (memcmp(crypt_blocks, plain_blocks, len) != 0)
+    {
+        printf("%s %u keyed blocks decrypt error\n", p_kernel->name, (unsigned)num_blocks);
+        return false;
+    }
+
+    /* Decrypt, with the decryption key schedules. */
+    memcpy(crypt_blocks, expected_blocks, len);
+    for (i = 0; i < num_blocks; ++i)
+    {
+        keyed_blocks[i].p_key_schedule = &decrypt_key_schedules[(num_blocks - 1u - i) * KHAZAD_KEY_SCHEDULE_SIZE];
+    }
+    p_kernel->crypt_keyed_blocks(keyed_blocks, num_blocks);
+    if (memcmp(crypt_blocks, plain_blocks, len) != 0)
+    {
+        printf("%s %u keyed blocks decrypt key schedule error\n", p_kernel->name, (unsigned)num_blocks);
+        return false;
+    }
+
+    return true;
+}
+
+/*****************************************************************************
+ * Functions
+ ****************************************************************************/
+
+int main(int argc, char **argv)
+{
+    static const size_t block_counts[] = { 0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, MAX_TEST_BLOCKS };
+    const kernel_test_t   * p_kernel;
+    size_t                  i;
+
+    (void)argc;
+    (void)argv;
+
+    printf("selected kernel: %s\n", khazad_kernel_name());
+    for (p_kernel = kernel_tests; p_kernel->name != NULL; ++p_kernel)
+    {
+        if (!p_kernel->is_supported())
+        {
+            printf("%s skipped\n", p_kernel->name);
+            continue;
+        }
+        for (i = 0; i < dimof(block_counts); ++i)
+        {
+            if (!test_kernel(p_kernel, block_counts[i]) ||
+                !test_kernel_key_schedule(p_kernel, block_counts[i]) ||
+                !test_kernel_keyed(p_kernel, block_counts[i]))
+            {
+                return 1;
+            }
+        }
+        printf("%s succeeded\n", p_kernel->name);
+    }
+    return 0;
+}
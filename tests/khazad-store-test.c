@@ -0,0 +1,178 @@
+/*****************************************************************************
+ * khazad-store-test.c
+ *
+ * Test memory-mapped key schedule store files: write a store, then check its
+ * records by index and by id, and check that invalid files are rejected.
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Includes
+ ****************************************************************************/
+
+#include "khazad-min.h"
+#include "khazad-min-store.h"
+#include "khazad-test-fixtures.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+/*****************************************************************************
+ * Defines
+ ****************************************************************************/
+
+#define NUM_TEST_RECORDS    1000u
+#define TEST_STORE_PATH     "khazad-store-test.tmp"
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+
+static uint64_t ids[NUM_TEST_RECORDS];
+static uint8_t keys[NUM_TEST_RECORDS * KHAZAD_KEY_SIZE];
+
+/*****************************************************************************
+ * Functions
+ ****************************************************************************/
+
+static int test_store(unsigned flags)
+{
+    khazad_ks_store_t     * p_store;
+    uint8_t                 key_schedule[KHAZAD_KEY_SCHEDULE_SIZE];
+    uint8_t                 decrypt_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE];
+    const uint8_t         * p_decrypt_key_schedule;
+    size_t                  index;
+    size_t                  i;
+
+    if (khazad_ks_store_write(TEST_STORE_PATH, ids, keys, NUM_TEST_RECORDS, flags) != 0)
+    {
+        printf("store write error, flags %u\n", flags);
+        return 1;
+    }
+    p_store = khazad_ks_store_open(TEST_STORE_PATH);
+    if (p_store == NULL)
+    {
+        printf("store open error, flags %u\n", flags);
+        return 1;
+    }
+    if (khazad_ks_store_num_records(p_store) != NUM_TEST_RECORDS || khazad_ks_store_flags(p_store) != flags)
+    {
+        printf("store header error, flags %u\n", flags);
+        return 1;
+    }
+
+    for (i = 0; i < NUM_TEST_RECORDS; ++i)
+    {
+        index = khazad_ks_store_find(p_store, ids[i]);
+        if (index == KHAZAD_KS_STORE_NOT_FOUND || khazad_ks_store_id(p_store, index) != ids[i])
+        {
+            printf("store find error, id %llu\n", (unsigned long long)ids[i]);
+            return 1;
+        }
+        if (((uintptr_t)khazad_ks_store_key_schedule(p_store, index) % 16u) != 0)
+        {
+            printf("store alignment error\n");
+            return 1;
+        }
+        khazad_key_schedule(key_schedule, &keys[i * KHAZAD_KEY_SIZE]);
+        if (memcmp(khazad_ks_store_key_schedule(p_store, index), key_schedule, KHAZAD_KEY_SCHEDULE_SIZE) != 0)
+        {
+            printf("store key schedule error, id %llu\n", (unsigned long long)ids[i]);
+            return 1;
+        }
+        p_decrypt_key_schedule = khazad_ks_store_decrypt_key_schedule(p_store, index);
+        if (flags & KHAZAD_KS_STORE_DECRYPT_KEYS)
+        {
+            khazad_decrypt_key_schedule(decrypt_key_schedule, &keys[i * KHAZAD_KEY_SIZE]);
+            if (p_decrypt_key_schedule == NULL
+                || memcmp(p_decrypt_key_schedule, decrypt_key_schedule, KHAZAD_KEY_SCHEDULE_SIZE) != 0)
+            {
+                printf("store decrypt key schedule error, id %llu\n", (unsigned long long)ids[i]);
+                return 1;
+            }
+        }
+        else if (p_decrypt_key_schedule != NULL)
+        {
+            printf("store decrypt key schedule error, no decrypt keys\n");
+            return 1;
+        }
+    }
+    /* Ids are sorted in the store. */
+    for (i = 1u; i < NUM_TEST_RECORDS; ++i)
+    {
+        if (khazad_ks_store_id(p_store, i - 1u) >= khazad_ks_store_id(p_store, i))
+        {
+            printf("store id order error\n");
+            return 1;
+        }
+    }
+    if (khazad_ks_store_find(p_store, 1u) != KHAZAD_KS_STORE_NOT_FOUND
+        || khazad_ks_store_find(p_store, UINT64_MAX) != KHAZAD_KS_STORE_NOT_FOUND)
+    {
+        printf("store find missing id error\n");
+        return 1;
+    }
+    khazad_ks_store_close(p_store);
+    return 0;
+}
+
+/* Write a store, change one byte of it, and check that it is rejected. */
+static int test_store_invalid(long offset, uint8_t value)
+{
+    FILE  * p_file;
+
+    if (khazad_ks_store_write(TEST_STORE_PATH, ids, keys, NUM_TEST_RECORDS, 0) != 0)
+    {
+        printf("store write error\n");
+        return 1;
+    }
+    p_file = fopen(TEST_STORE_PATH, "r+b");
+    if (p_file == NULL || fseek(p_file, offset, SEEK_SET) != 0 || fputc(value, p_file) == EOF || fclose(p_file) != 0)
+    {
+        printf("store file error\n");
+        return 1;
+    }
+    errno = 0;
+    if (khazad_ks_store_open(TEST_STORE_PATH) != NULL || errno != EINVAL)
+    {
+        printf("store invalid file error, offset %ld\n", offset);
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t    duplicate_ids[2] = { 5u, 5u };
+    size_t      i;
+
+    (void)argc;
+    (void)argv;
+
+    for (i = 0; i < NUM_TEST_RECORDS; ++i)
+    {
+        /* Distinct ids, not in order, and never 1. */
+        ids[i] = (uint64_t)(i + 2u) * 0x9E3779B97F4A7C15u;
+    }
+    fill_test_keys(keys, NUM_TEST_RECORDS);
+
+    if (test_store(0))
+        return 1;
+    if (test_store(KHAZAD_KS_STORE_DECRYPT_KEYS))
+        return 1;
+
+    errno = 0;
+    if (khazad_ks_store_write(TEST_STORE_PATH, duplicate_ids, keys, 2u, 0) == 0 || errno != EINVAL)
+    {
+        printf("store duplicate ids error\n");
+        return 1;
+    }
+    /* Bad magic, version, record size, and a record count too large for the
+     * file. */
+    if (test_store_invalid(0, 'X') || test_store_invalid(8, 2u)
+        || test_store_invalid(24, 8u) || test_store_invalid(19, 1u))
+        return 1;
+
+    remove(TEST_STORE_PATH);
+    return 0;
+}
@@ -0,0 +1,46 @@
+/*****************************************************************************
+ * khazad-test-fixtures.h
+ *
+ * Generated keys and blocks shared by the tests of the key management
+ * modules.
+ ****************************************************************************/
+
+#ifndef KHAZAD_TEST_FIXTURES_H
+#define KHAZAD_TEST_FIXTURES_H
+
+/*****************************************************************************
+ * Includes
+ ****************************************************************************/
+
+#include "khazad-min.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*****************************************************************************
+ * Inline functions
+ ****************************************************************************/
+
+/* Fill p_keys with num_keys distinct keys. */
+static inline void fill_test_keys(uint8_t * p_keys, size_t num_keys)
+{
+    size_t  i;
+
+    for (i = 0; i < num_keys * KHAZAD_KEY_SIZE; ++i)
+    {
+        p_keys[i] = (uint8_t)(i * 0x3Bu ^ (i >> 4u) ^ (i >> 12u));
+    }
+}
+
+/* Fill p_blocks with num_blocks blocks, which differ for each seed. */
+static inline void fill_test_blocks(uint8_t * p_blocks, size_t num_blocks, uint8_t seed)
+{
+    size_t  i;
+
+    for (i = 0; i < num_blocks * KHAZAD_BLOCK_SIZE; ++i)
+    {
+        p_blocks[i] = (uint8_t)(i * 0x9Du + seed);
+    }
+}
+
+#endif /* !defined(KHAZAD_TEST_FIXTURES_H) */
@@ -19,7 +19,6 @@ int main(int argc, char **argv)
     uint8_t decrypt_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE];
     uint8_t otfks_encrypt_key_start[KHAZAD_KEY_SIZE];
     uint8_t otfks_decrypt_key_start[KHAZAD_KEY_SIZE];
-    uint8_t otfks_key_work[KHAZAD_KEY_SIZE];
     uint8_t crypt_block[KHAZAD_BLOCK_SIZE];
 
     (void)argc;
@@ -64,8 +63,7 @@ int main(int argc, char **argv)
 #if ENCRYPT_OTFKS == 0
     khazad_crypt(crypt_block, encrypt_key_schedule);
 #else
-    memcpy(otfks_key_work, otfks_encrypt_key_start, KHAZAD_KEY_SIZE);
-    khazad_otfks_encrypt(crypt_block, otfks_key_work);
+    khazad_otfks_encrypt_const(crypt_block, otfks_encrypt_key_start);
 #endif
 
     printf("crypt: ");
@@ -77,8 +75,7 @@ int main(int argc, char **argv)
 #if ENCRYPT_OTFKS == 0
         khazad_crypt(crypt_block, encrypt_key_schedule);
 #else
-        memcpy(otfks_key_work, otfks_encrypt_key_start, KHAZAD_KEY_SIZE);
-        khazad_otfks_encrypt(crypt_block, otfks_key_work);
+        khazad_otfks_encrypt_const(crypt_block, otfks_encrypt_key_start);
 #endif
     }
     printf("100 iter: ");
@@ -92,8 +89,7 @@ int main(int argc, char **argv)
 #if ENCRYPT_OTFKS == 0
             khazad_crypt(crypt_block, encrypt_key_schedule);
 #else
-            memcpy(otfks_key_work, otfks_encrypt_key_start, KHAZAD_KEY_SIZE);
-            khazad_otfks_encrypt(crypt_block, otfks_key_work);
+            khazad_otfks_encrypt_const(crypt_block, otfks_encrypt_key_start);
 #endif
         }
         printf("%lu iter: ", (unsigned long)TOTAL_ROUNDS);
@@ -103,8 +99,7 @@ int main(int argc, char **argv)
         for (i = 100; i < TOTAL_ROUNDS; ++i)
         {
 #if DECRYPT_OTFKS == 1
-        memcpy(otfks_key_work, otfks_decrypt_key_start, KHAZAD_KEY_SIZE);
-        khazad_otfks_decrypt(crypt_block, otfks_key_work);
+        khazad_otfks_decrypt_const(crypt_block, otfks_decrypt_key_start);
 #elif DECRYPT_METHOD == 0
             khazad_crypt(crypt_block, decrypt_key_schedule);
 #else
@@ -119,8 +114,7 @@ int main(int argc, char **argv)
     for (i = 1; i < 100; ++i)
     {
 #if DECRYPT_OTFKS == 1
-    memcpy(otfks_key_work, otfks_decrypt_key_start, KHAZAD_KEY_SIZE);
-    khazad_otfks_decrypt(crypt_block, otfks_key_work);
+    khazad_otfks_decrypt_const(crypt_block, otfks_decrypt_key_start);
 #elif DECRYPT_METHOD == 0
         khazad_crypt(crypt_block, decrypt_key_schedule);
 #else
@@ -132,8 +126,7 @@ int main(int argc, char **argv)
 
     /* Decrypt from 1 back to original */
 #if DECRYPT_OTFKS == 1
-    memcpy(otfks_key_work, otfks_decrypt_key_start, KHAZAD_KEY_SIZE);
-    khazad_otfks_decrypt(crypt_block, otfks_key_work);
+    khazad_otfks_decrypt_const(crypt_block, otfks_decrypt_key_start);
 #elif DECRYPT_METHOD == 0
     khazad_crypt(crypt_block, decrypt_key_schedule);
 #else
@@ -0,0 +1,196 @@
+/*****************************************************************************
+ * khazad-tiered-test.c
+ *
+ * Test the tiered key store against the functions that take a key schedule,
+ * with keys going through promotion, demotion, rekeying and removal.
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Includes
+ ****************************************************************************/
+
+#include "khazad-min.h"
+#include "khazad-min-tiered.h"
+#include "khazad-test-fixtures.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/*****************************************************************************
+ * Defines
+ ****************************************************************************/
+
+#define NUM_TEST_KEYS       300u
+#define NUM_HOT_KEYS        20u
+#define NUM_TEST_BLOCKS     5u
+#define PROMOTE_THRESHOLD   8u
+
+/*****************************************************************************
+ * Local variables
+ ****************************************************************************/
+
+static uint8_t keys[(NUM_TEST_KEYS + 1u) * KHAZAD_KEY_SIZE];
+
+/*****************************************************************************
+ * Functions
+ ****************************************************************************/
+
+static uint64_t test_id(size_t i)
+{
+    return (uint64_t)i * 0x100000001u;
+}
+
+/* Encrypt and decrypt blocks for id with the tiered store, and check them
+ * against the key schedule for key_index. */
+static int test_blocks(khazad_tiered_t * p_tiered, size_t i, size_t key_index)
+{
+    uint8_t     key_schedule[KHAZAD_KEY_SCHEDULE_SIZE];
+    uint8_t     plain_blocks[NUM_TEST_BLOCKS * KHAZAD_BLOCK_SIZE];
+    uint8_t     expected_blocks[NUM_TEST_BLOCKS * KHAZAD_BLOCK_SIZE];
+    uint8_t     crypt_blocks[NUM_TEST_BLOCKS * KHAZAD_BLOCK_SIZE];
+
+    fill_test_blocks(plain_blocks, NUM_TEST_BLOCKS, (uint8_t)i);
+    khazad_key_schedule(key_schedule, &keys[key_index * KHAZAD_KEY_SIZE]);
+    khazad_crypt_blocks(expected_blocks, plain_blocks, NUM_TEST_BLOCKS, key_schedule);
+
+    if (khazad_tiered_crypt_blocks(p_tiered, test_id(i), crypt_blocks, plain_blocks, NUM_TEST_BLOCKS) != 0
+        || memcmp(crypt_blocks, expected_blocks, sizeof(crypt_blocks)) != 0)
+    {
+        printf("tiered encrypt error, key %zu\n", i);
+        return 1;
+    }
+    if (khazad_tiered_decrypt_blocks(p_tiered, test_id(i), crypt_blocks, crypt_blocks, NUM_TEST_BLOCKS) != 0
+        || memcmp(crypt_blocks, plain_blocks, sizeof(crypt_blocks)) != 0)
+    {
+        printf("tiered decrypt error, key %zu\n", i);
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    khazad_tiered_t       * p_tiered;
+    khazad_tiered_stats_t   stats;
+    uint8_t                 block[KHAZAD_BLOCK_SIZE];
+    size_t                  round;
+    size_t                  i;
+
+    (void)argc;
+    (void)argv;
+
+    fill_test_keys(keys, NUM_TEST_KEYS);
+
+    p_tiered = khazad_tiered_create(NUM_TEST_KEYS, NUM_HOT_KEYS * 80u, PROMOTE_THRESHOLD);
+    if (p_tiered == NULL)
+    {
+        printf("tiered create error\n");
+        return 1;
+    }
+    for (i = 0; i < NUM_TEST_KEYS; ++i)
+    {
+        if (khazad_tiered_add(p_tiered, test_id(i), &keys[i * KHAZAD_KEY_SIZE]) != 0)
+        {
+            printf("tiered add error, key %zu\n", i);
+            return 1;
+        }
+    }
+    if (khazad_tiered_add(p_tiered, test_id(NUM_TEST_KEYS), &keys[NUM_TEST_KEYS * KHAZAD_KEY_SIZE]) == 0)
+    {
+        printf("tiered add to full store error\n");
+        return 1;
+    }
+    if (khazad_tiered_crypt_blocks(p_tiered, test_id(NUM_TEST_KEYS), block, block, 1u) == 0)
+    {
+        printf("tiered missing key error\n");
+        return 1;
+    }
+
+    /* Each call processes 2 * NUM_TEST_BLOCKS blocks, so a key is promoted on
+     * its first decryption. */
+    for (i = 0; i < NUM_TEST_KEYS; ++i)
+    {
+        if (test_blocks(p_tiered, i, i))
+            return 1;
+    }
+    khazad_tiered_get_stats(p_tiered, &stats);
+    printf("tiered: %zu hot of %zu, %llu promotions, %llu demotions\n", stats.num_hot, stats.max_hot,
+           (unsigned long long)stats.promotions, (unsigned long long)stats.demotions);
+    if (stats.max_hot != NUM_HOT_KEYS || stats.num_hot != NUM_HOT_KEYS || stats.num_keys != NUM_TEST_KEYS
+        || stats.promotions != NUM_TEST_KEYS || stats.demotions != NUM_TEST_KEYS - NUM_HOT_KEYS
+        || stats.cold_accesses != NUM_TEST_KEYS)
+    {
+        printf("tiered stats error\n");
+        return 1;
+    }
+
+    /* A small working set stays hot. */
+    for (round = 0; round < 3u; ++round)
+    {
+        for (i = 0; i < NUM_HOT_KEYS / 2u; ++i)
+        {
+            if (test_blocks(p_tiered, i, i))
+                return 1;
+        }
+    }
+    khazad_tiered_get_stats(p_tiered, &stats);
+    if (stats.promotions != NUM_TEST_KEYS + NUM_HOT_KEYS / 2u)
+    {
+        printf("tiered working set error\n");
+        return 1;
+    }
+
+    /* Rekey a hot key and a cold key, remove every third key, and check the
+     * rest. */
+    if (khazad_tiered_add(p_tiered, test_id(0), &keys[NUM_TEST_KEYS * KHAZAD_KEY_SIZE]) != 0
+        || khazad_tiered_add(p_tiered, test_id(100u), &keys[NUM_TEST_KEYS * KHAZAD_KEY_SIZE]) != 0
+        || test_blocks(p_tiered, 0, NUM_TEST_KEYS) || test_blocks(p_tiered, 100u, NUM_TEST_KEYS))
+    {
+        printf("tiered rekey error\n");
+        return 1;
+    }
+    for (i = 0; i < NUM_TEST_KEYS; i += 3u)
+    {
+        khazad_tiered_remove(p_tiered, test_id(i));
+    }
+    for (i = 1u; i < NUM_TEST_KEYS; ++i)
+    {
+        if ((i % 3u) == 0)
+        {
+            if (khazad_tiered_crypt_blocks(p_tiered, test_id(i), block, block, 1u) == 0)
+            {
+                printf("tiered remove error, key %zu\n", i);
+                return 1;
+            }
+        }
+        else if (test_blocks(p_tiered, i, (i == 100u) ? NUM_TEST_KEYS : i))
+        {
+            return 1;
+        }
+    }
+    khazad_tiered_get_stats(p_tiered, &stats);
+    if (stats.num_keys != NUM_TEST_KEYS - NUM_TEST_KEYS / 3u || stats.num_hot > NUM_HOT_KEYS)
+    {
+        printf("tiered remove stats error\n");
+        return 1;
+    }
+    khazad_tiered_destroy(p_tiered);
+
+    /* With no hot set, keys stay cold. */
+    p_tiered = khazad_tiered_create(10u, 0, 0);
+    if (p_tiered == NULL || khazad_tiered_add(p_tiered, test_id(3u), &keys[3u * KHAZAD_KEY_SIZE]) != 0
+        || test_blocks(p_tiered, 3u, 3u))
+    {
+        printf("tiered cold only error\n");
+        return 1;
+    }
+    khazad_tiered_get_stats(p_tiered, &stats);
+    if (stats.num_hot != 0 || stats.hot_accesses != 0)
+    {
+        printf("tiered cold only stats error\n");
+        return 1;
+    }
+    khazad_tiered_destroy(p_tiered);
+
+    return 0;
+}
@@ -28,6 +28,9 @@
 #define ENABLE_LONG_TEST        0
 #endif
 
+/* More than one group of blocks for the multi-block on-the-fly functions. */
+#define NUM_OTFKS_BLOCKS        70u
+
 /*****************************************************************************
  * Types
  ****************************************************************************/
@@ -55,11 +58,148 @@ typedef struct
  * Functions
  ****************************************************************************/
 
+/* Check the multi-block on-the-fly functions against khazad_crypt_blocks(),
+ * out-of-place for encryption and in-place for decryption. */
+static bool test_khazad_otfks_blocks(const vector_data_t * p_vector_data,
+                                     const uint8_t p_encrypt_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE],
+                                     const uint8_t p_encrypt_key_start[KHAZAD_KEY_SIZE],
+                                     const uint8_t p_decrypt_key_start[KHAZAD_KEY_SIZE])
+{
+    size_t  i;
+    uint8_t plain_blocks[NUM_OTFKS_BLOCKS * KHAZAD_BLOCK_SIZE];
+    uint8_t expected_blocks[NUM_OTFKS_BLOCKS * KHAZAD_BLOCK_SIZE];
+    uint8_t crypt_blocks[NUM_OTFKS_BLOCKS * KHAZAD_BLOCK_SIZE];
+
+    for (i = 0; i < sizeof(plain_blocks); ++i)
+    {
+        plain_blocks[i] = (uint8_t)(p_vector_data->plain[i % KHAZAD_BLOCK_SIZE] + i / KHAZAD_BLOCK_SIZE);
+    }
+    khazad_crypt_blocks(expected_blocks, plain_blocks, NUM_OTFKS_BLOCKS, p_encrypt_key_schedule);
+
+    khazad_otfks_encrypt_blocks(crypt_blocks, plain_blocks, NUM_OTFKS_BLOCKS, p_encrypt_key_start);
+    if (memcmp(crypt_blocks, expected_blocks, sizeof(crypt_blocks)) != 0)
+    {
+        printf("set %u vector %u OTFKS encrypt blocks error\n",
+                p_vector_data->set_num, p_vector_data->vector_num);
+        return false;
+    }
+    khazad_otfks_decrypt_blocks(crypt_blocks, crypt_blocks, NUM_OTFKS_BLOCKS, p_decrypt_key_start);
+    if (memcmp(crypt_blocks, plain_blocks, sizeof(crypt_blocks)) != 0)
+    {
+        printf("set %u vector %u OTFKS decrypt blocks error\n",
+                p_vector_data->set_num, p_vector_data->vector_num);
+        return false;
+    }
+    return true;
+}
+
+/* Check an on-the-fly key schedule session through a run of encryptions and
+ * decryptions that changes direction, and sometimes doesn't, against
+ * khazad_crypt() and khazad_decrypt(). */
+static bool test_khazad_otfks_session(const vector_data_t * p_vector_data,
+                                      const uint8_t p_encrypt_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE],
+                                      const uint8_t p_encrypt_key_start[KHAZAD_KEY_SIZE],
+                                      const uint8_t p_decrypt_key_start[KHAZAD_KEY_SIZE])
+{
+    static const char directions[] = "EDEEDDDEDEEED";
+    size_t  i;
+    khazad_otfks_session_t session;
+    uint8_t key_start[KHAZAD_KEY_SIZE];
+    uint8_t session_block[KHAZAD_BLOCK_SIZE];
+    uint8_t expected_block[KHAZAD_BLOCK_SIZE];
+
+    memcpy(key_start, p_decrypt_key_start, KHAZAD_KEY_SIZE);
+    khazad_otfks_encrypt_from_decrypt_start_key(key_start);
+    if (memcmp(key_start, p_encrypt_key_start, KHAZAD_KEY_SIZE) != 0)
+    {
+        printf("set %u vector %u encrypt start key from decrypt error\n",
+                p_vector_data->set_num, p_vector_data->vector_num);
+        return false;
+    }
+
+    khazad_otfks_session_init(&session, p_vector_data->key);
+    memcpy(session_block, p_vector_data->plain, KHAZAD_BLOCK_SIZE);
+    memcpy(expected_block, p_vector_data->plain, KHAZAD_BLOCK_SIZE);
+    for (i = 0; directions[i]; ++i)
+    {
+        if (directions[i] == 'E')
+        {
+            khazad_otfks_session_encrypt(&session, session_block);
+            khazad_crypt(expected_block, p_encrypt_key_schedule);
+        }
+        else
+        {
+            khazad_otfks_session_decrypt(&session, session_block);
+            khazad_decrypt(expected_block, p_encrypt_key_schedule);
+        }
+        if (memcmp(session_block, expected_block, KHAZAD_BLOCK_SIZE) != 0)
+        {
+            printf("set %u vector %u OTFKS session error, operation %zu\n",
+                    p_vector_data->set_num, p_vector_data->vector_num, i);
+            return false;
+        }
+        /* The members are stable: key_state is the start key state that
+         * flags says it is. */
+        if (memcmp(session.key_state,
+                   (session.flags & KHAZAD_OTFKS_SESSION_DECRYPT_START) ? p_decrypt_key_start : p_encrypt_key_start,
+                   KHAZAD_KEY_SIZE) != 0)
+        {
+            printf("set %u vector %u OTFKS session key state error, operation %zu\n",
+                    p_vector_data->set_num, p_vector_data->vector_num, i);
+            return false;
+        }
+    }
+    khazad_otfks_session_wipe(&session);
+    return true;
+}
+
+/* Check iterated encryption and decryption against the iterated test
+ * vectors. */
+static bool test_khazad_iterate(const vector_data_t * p_vector_data,
+                                const uint8_t p_encrypt_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE])
+{
+    uint8_t crypt_block[KHAZAD_BLOCK_SIZE];
+
+    memcpy(crypt_block, p_vector_data->plain, KHAZAD_BLOCK_SIZE);
+    khazad_crypt_iterate(crypt_block, p_encrypt_key_schedule, 0);
+    if (memcmp(crypt_block, p_vector_data->plain, KHAZAD_BLOCK_SIZE) != 0)
+    {
+        printf("set %u vector %u encrypt 0 iterate error\n",
+                p_vector_data->set_num, p_vector_data->vector_num);
+        return false;
+    }
+    khazad_crypt_iterate(crypt_block, p_encrypt_key_schedule, 100u);
+    if (p_vector_data->iter100 &&
+        memcmp(crypt_block, p_vector_data->iter100, KHAZAD_BLOCK_SIZE) != 0)
+    {
+        printf("set %u vector %u encrypt 100 iterate error\n",
+                p_vector_data->set_num, p_vector_data->vector_num);
+        return false;
+    }
+    khazad_crypt_iterate(crypt_block, p_encrypt_key_schedule, 900u);
+    if (p_vector_data->iter1000 &&
+        memcmp(crypt_block, p_vector_data->iter1000, KHAZAD_BLOCK_SIZE) != 0)
+    {
+        printf("set %u vector %u encrypt 1000 iterate error\n",
+                p_vector_data->set_num, p_vector_data->vector_num);
+        return false;
+    }
+    khazad_decrypt_iterate(crypt_block, p_encrypt_key_schedule, 1000u);
+    if (memcmp(crypt_block, p_vector_data->plain, KHAZAD_BLOCK_SIZE) != 0)
+    {
+        printf("set %u vector %u decrypt 1000 iterate error\n",
+                p_vector_data->set_num, p_vector_data->vector_num);
+        return false;
+    }
+    return true;
+}
+
 static bool test_khazad_main(const vector_data_t * p_vector_data, bool do_otfks)
 {
     size_t  i;
     uint8_t encrypt_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE] = {};
     uint8_t decrypt_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE] = {};
+    uint8_t derived_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE] = {};
     uint8_t otfks_encrypt_key_start[KHAZAD_KEY_SIZE] = {};
     uint8_t otfks_decrypt_key_start[KHAZAD_KEY_SIZE] = {};
     uint8_t otfks_key_work[KHAZAD_KEY_SIZE] = {};
@@ -71,6 +211,15 @@ static bool test_khazad_main(const vector_data_t * p_vector_data, bool do_otfks)
         /* Start key for encrypt */
         memcpy(otfks_encrypt_key_start, p_vector_data->key, KHAZAD_KEY_SIZE);
         khazad_otfks_encrypt_start_key(otfks_encrypt_key_start);
+        /* Full key schedule from the start key */
+        khazad_key_schedule(encrypt_key_schedule, p_vector_data->key);
+        khazad_key_schedule_from_otfks_start_key(derived_key_schedule, otfks_encrypt_key_start);
+        if (memcmp(derived_key_schedule, encrypt_key_schedule, KHAZAD_KEY_SCHEDULE_SIZE) != 0)
+        {
+            printf("set %u vector %u key schedule from start key error\n",
+                    p_vector_data->set_num, p_vector_data->vector_num);
+            return false;
+        }
         /* Start key for decrypt */
 #if 1
         memcpy(otfks_decrypt_key_start, p_vector_data->key, KHAZAD_KEY_SIZE);
@@ -79,6 +228,13 @@ static bool test_khazad_main(const vector_data_t * p_vector_data, bool do_otfks)
         memcpy(otfks_decrypt_key_start, otfks_encrypt_key_start, KHAZAD_KEY_SIZE);
         khazad_otfks_decrypt_from_encrypt_start_key(otfks_decrypt_key_start);
 #endif
+        if (!test_khazad_otfks_blocks(p_vector_data, encrypt_key_schedule,
+                                      otfks_encrypt_key_start, otfks_decrypt_key_start)
+            || !test_khazad_otfks_session(p_vector_data, encrypt_key_schedule,
+                                          otfks_encrypt_key_start, otfks_decrypt_key_start))
+        {
+            return false;
+        }
     }
     else
     {
@@ -86,14 +242,53 @@ static bool test_khazad_main(const vector_data_t * p_vector_data, bool do_otfks)
         khazad_key_schedule(encrypt_key_schedule, p_vector_data->key);
         /* Decrypt key schedule (for the alternative method of decryption) */
         khazad_decrypt_key_schedule(decrypt_key_schedule, p_vector_data->key);
+
+        /* Decrypt key schedule derived from the encrypt key schedule, to a
+         * separate buffer and in-place */
+        khazad_decrypt_key_schedule_from_encrypt(derived_key_schedule, encrypt_key_schedule);
+        if (memcmp(derived_key_schedule, decrypt_key_schedule, KHAZAD_KEY_SCHEDULE_SIZE) != 0)
+        {
+            printf("set %u vector %u decrypt key schedule from encrypt error\n",
+                    p_vector_data->set_num, p_vector_data->vector_num);
+            return false;
+        }
+        memcpy(derived_key_schedule, encrypt_key_schedule, KHAZAD_KEY_SCHEDULE_SIZE);
+        khazad_decrypt_key_schedule_in_place(derived_key_schedule);
+        if (memcmp(derived_key_schedule, decrypt_key_schedule, KHAZAD_KEY_SCHEDULE_SIZE) != 0)
+        {
+            printf("set %u vector %u decrypt key schedule in-place error\n",
+                    p_vector_data->set_num, p_vector_data->vector_num);
+            return false;
+        }
+
+        /* Encrypt the first block while calculating the key schedule */
+        memcpy(crypt_block, p_vector_data->plain, KHAZAD_BLOCK_SIZE);
+        khazad_crypt_and_expand(crypt_block, derived_key_schedule, p_vector_data->key);
+        if (memcmp(derived_key_schedule, encrypt_key_schedule, KHAZAD_KEY_SCHEDULE_SIZE) != 0 ||
+            (p_vector_data->cipher &&
+             memcmp(crypt_block, p_vector_data->cipher, KHAZAD_BLOCK_SIZE) != 0))
+        {
+            printf("set %u vector %u crypt and expand error\n",
+                    p_vector_data->set_num, p_vector_data->vector_num);
+            return false;
+        }
+        if (!test_khazad_iterate(p_vector_data, encrypt_key_schedule))
+        {
+            return false;
+        }
     }
 
     memcpy(crypt_block, p_vector_data->plain, KHAZAD_BLOCK_SIZE);
 
     for (i = 0; ; )
     {
-        /* Encrypt 1 */
-        if (do_otfks)
+        /* Encrypt 1. With on-the-fly key schedule, alternate the functions
+         * that keep and consume the start key state. */
+        if (do_otfks && (i & 1u))
+        {
+            khazad_otfks_encrypt_const(crypt_block, otfks_encrypt_key_start);
+        }
+        else if (do_otfks)
         {
             memcpy(otfks_key_work, otfks_encrypt_key_start, KHAZAD_KEY_SIZE);
             khazad_otfks_encrypt(crypt_block, otfks_key_work);
@@ -172,7 +367,11 @@ static bool test_khazad_main(const vector_data_t * p_vector_data, bool do_otfks)
     for (;;)
     {
         /* Decrypt back to plain */
-        if (do_otfks)
+        if (do_otfks && (i & 1u))
+        {
+            khazad_otfks_decrypt_const(crypt_block, otfks_decrypt_key_start);
+        }
+        else if (do_otfks)
         {
             memcpy(otfks_key_work, otfks_decrypt_key_start, KHAZAD_KEY_SIZE);
             khazad_otfks_decrypt(crypt_block, otfks_key_work);
@@ -230,6 +429,9 @@ static bool test_khazad_100000000(const vector_data_t * p_vector_data, bool do_o
     uint8_t otfks_encrypt_key_start[KHAZAD_KEY_SIZE] = {};
     uint8_t otfks_key_work[KHAZAD_KEY_SIZE] = {};
     uint8_t crypt_block[KHAZAD_BLOCK_SIZE] = {};
+    uint8_t expand_key_schedule[KHAZAD_KEY_SCHEDULE_SIZE] = {};
+    uint8_t expand_key[KHAZAD_KEY_SIZE] = {};
+    uint8_t expand_block[KHAZAD_BLOCK_SIZE] = {};
 
     /* Set up initial key schedule */
     if (do_otfks)
@@ -245,6 +447,10 @@ static bool test_khazad_100000000(const vector_data_t * p_vector_data, bool do_o
     }
 
     memcpy(crypt_block, p_vector_data->plain, KHAZAD_BLOCK_SIZE);
+    /* Alongside, the same chain with the key schedule calculated by
+     * khazad_crypt_and_expand(). */
+    memcpy(expand_key, p_vector_data->key, KHAZAD_KEY_SIZE);
+    memcpy(expand_block, p_vector_data->plain, KHAZAD_BLOCK_SIZE);
 
     for (i = 0; ; )
     {
@@ -257,6 +463,7 @@ static bool test_khazad_100000000(const vector_data_t * p_vector_data, bool do_o
         else
         {
             khazad_crypt(crypt_block, encrypt_key_schedule);
+            khazad_crypt_and_expand(expand_block, expand_key_schedule, expand_key);
         }
 
         /* Set up next key schedule for next encryption key.
@@ -272,6 +479,7 @@ static bool test_khazad_100000000(const vector_data_t * p_vector_data, bool do_o
             /* Encrypt key schedule */
             memset(encrypt_key, crypt_block[KHAZAD_BLOCK_SIZE-1], KHAZAD_KEY_SIZE);
             khazad_key_schedule(encrypt_key_schedule, encrypt_key);
+            memset(expand_key, expand_block[KHAZAD_BLOCK_SIZE-1], KHAZAD_KEY_SIZE);
         }
 
         i++;
@@ -286,6 +494,12 @@ static bool test_khazad_100000000(const vector_data_t * p_vector_data, bool do_o
                         p_vector_data->set_num, p_vector_data->vector_num);
                 return false;
             }
+            if (!do_otfks && memcmp(expand_block, crypt_block, KHAZAD_BLOCK_SIZE) != 0)
+            {
+                printf("set %u vector %u crypt and expand 10^8 error\n",
+                        p_vector_data->set_num, p_vector_data->vector_num);
+                return false;
+            }
             break;
         }
     }